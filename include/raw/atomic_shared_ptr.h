@@ -0,0 +1,290 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_ATOMIC_SHARED_PTR_H
+#define SMARTPOINTERS_ATOMIC_SHARED_PTR_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "fwd.h"
+#include "hub.h"
+#include "shared_ptr.h"
+#include "weak_ptr.h"
+
+namespace raw {
+// Which of the hub's counters an atomic pointer owns
+struct strong_hub_ref {
+	static inline void acquire(hub* hub_ptr, size_t count) noexcept {
+		for (size_t i = 0; i < count; ++i) {
+			hub_ptr->increment_use_count();
+		}
+	}
+	static inline void release(hub* hub_ptr) noexcept {
+		hub_ptr->decrement_use_count();
+	}
+};
+
+struct weak_hub_ref {
+	static inline void acquire(hub* hub_ptr, size_t count) noexcept {
+		for (size_t i = 0; i < count; ++i) {
+			hub_ptr->increment_weak_count();
+		}
+	}
+	static inline void release(hub* hub_ptr) noexcept {
+		hub_ptr->decrement_weak_count();
+	}
+};
+
+/**
+ * @brief Lock-free hub slot using split reference counts.
+ *
+ * The slot packs the hub pointer (low 48 bits) and a local count (high 16 bits) into one word.
+ * A reader pins the hub by bumping the local count, takes a real reference on the hub and then
+ * unpins. A writer that swaps the hub out converts the pins it finds into real references, and
+ * a reader whose pin was converted gives that reference back. So the hub can never be released
+ * while someone still reads it, and no reader ever takes a lock.
+ *
+ * Assumes user-space pointers fit in 48 bits (x86-64, AArch64) and fewer than 65536 readers
+ * are inside load() at the same instant.
+ */
+template<typename T, typename RefOps>
+class split_count_hub_slot {
+protected:
+	static_assert(sizeof(T) > 0 && hub::thread_policy::is_thread_safe,
+				  "raw atomic pointers need atomic hub counters, define RAW_MULTI_THREADED");
+	static_assert(sizeof(uintptr_t) == 8, "split reference counts need 64-bit pointers");
+
+	static constexpr unsigned  local_count_shift = 48;
+	static constexpr uintptr_t local_count_one	 = uintptr_t(1) << local_count_shift;
+	static constexpr uintptr_t hub_mask			 = local_count_one - 1;
+
+	mutable std::atomic<uintptr_t> word;
+
+	static inline hub* hub_of(uintptr_t value) noexcept {
+		return reinterpret_cast<hub*>(value & hub_mask);
+	}
+
+	static inline size_t local_count_of(uintptr_t value) noexcept {
+		return static_cast<size_t>(value >> local_count_shift);
+	}
+
+	explicit split_count_hub_slot(hub* owned) noexcept : word(reinterpret_cast<uintptr_t>(owned)) {}
+
+	~split_count_hub_slot() noexcept {
+		if (hub* owned = hub_of(word.load(std::memory_order_acquire))) {
+			RefOps::release(owned);
+		}
+	}
+
+	// Returns the current hub with one reference owned by the caller
+	hub* acquire() const noexcept {
+		uintptr_t pinned  = word.fetch_add(local_count_one, std::memory_order_acquire);
+		hub*	  current = hub_of(pinned);
+		if (current) {
+			RefOps::acquire(current, 1);
+		}
+		unpin(current);
+		return current;
+	}
+
+	void unpin(hub* pinned) const noexcept {
+		uintptr_t expected = word.load(std::memory_order_relaxed);
+		while (hub_of(expected) == pinned && local_count_of(expected) > 0) {
+			if (word.compare_exchange_weak(expected, expected - local_count_one,
+										   std::memory_order_release,
+										   std::memory_order_relaxed)) {
+				return;
+			}
+		}
+		// A writer already turned our pin into a reference, hand it back
+		if (pinned) {
+			RefOps::release(pinned);
+		}
+	}
+
+	// Installs desired (whose reference the slot takes over), returns the old hub and its reference
+	hub* exchange_hub(hub* desired) noexcept {
+		uintptr_t old	  = word.exchange(reinterpret_cast<uintptr_t>(desired),
+										  std::memory_order_acq_rel);
+		hub*	  old_hub = hub_of(old);
+		if (old_hub && local_count_of(old) > 0) {
+			RefOps::acquire(old_hub, local_count_of(old));
+		}
+		return old_hub;
+	}
+
+	// Installs desired only if expected is still stored, releasing the slot's old reference
+	bool compare_exchange_hub(hub* expected, hub* desired) noexcept {
+		uintptr_t current = word.load(std::memory_order_relaxed);
+		while (hub_of(current) == expected) {
+			if (word.compare_exchange_weak(current, reinterpret_cast<uintptr_t>(desired),
+										   std::memory_order_acq_rel,
+										   std::memory_order_relaxed)) {
+				if (expected) {
+					RefOps::acquire(expected, local_count_of(current));
+					RefOps::release(expected);
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+public:
+	split_count_hub_slot(const split_count_hub_slot&)			 = delete;
+	split_count_hub_slot& operator=(const split_count_hub_slot&) = delete;
+
+	static constexpr bool is_always_lock_free = std::atomic<uintptr_t>::is_always_lock_free;
+
+	[[nodiscard]] bool is_lock_free() const noexcept {
+		return word.is_lock_free();
+	}
+};
+
+/**
+ * @brief A raw::shared_ptr that can be loaded and replaced concurrently without locks.
+ */
+template<typename T>
+class atomic_shared_ptr : public split_count_hub_slot<T, strong_hub_ref> {
+	static_assert(!std::is_array_v<T>, "raw::atomic_shared_ptr supports single objects only");
+
+	using base = split_count_hub_slot<T, strong_hub_ref>;
+
+	static inline hub* take_hub(shared_ptr<T>& owner) noexcept {
+		hub* owned	  = owner.hub_ptr;
+		owner.ptr	  = nullptr;
+		owner.hub_ptr = nullptr;
+		return owned;
+	}
+
+	static inline shared_ptr<T> adopt_hub(hub* owned) noexcept {
+		if (!owned) {
+			return shared_ptr<T>();
+		}
+		return shared_ptr<T>(static_cast<T*>(owned->managed_object_ptr), owned);
+	}
+
+public:
+	atomic_shared_ptr() noexcept : base(nullptr) {}
+
+	atomic_shared_ptr(shared_ptr<T> desired) noexcept : base(take_hub(desired)) {}
+
+	shared_ptr<T> load() const noexcept {
+		return adopt_hub(this->acquire());
+	}
+
+	operator shared_ptr<T>() const noexcept {
+		return load();
+	}
+
+	void store(shared_ptr<T> desired) noexcept {
+		if (hub* old_hub = this->exchange_hub(take_hub(desired))) {
+			strong_hub_ref::release(old_hub);
+		}
+	}
+
+	atomic_shared_ptr& operator=(shared_ptr<T> desired) noexcept {
+		store(std::move(desired));
+		return *this;
+	}
+
+	shared_ptr<T> exchange(shared_ptr<T> desired) noexcept {
+		return adopt_hub(this->exchange_hub(take_hub(desired)));
+	}
+
+	/**
+	 * @brief Replaces the stored pointer with desired if it still owns the same object as
+	 * expected, otherwise loads the current pointer into expected.
+	 */
+	bool compare_exchange_strong(shared_ptr<T>& expected, shared_ptr<T> desired) noexcept {
+		if (this->compare_exchange_hub(expected.hub_ptr, desired.hub_ptr)) {
+			take_hub(desired);
+			return true;
+		}
+		expected = load();
+		return false;
+	}
+
+	bool compare_exchange_weak(shared_ptr<T>& expected, shared_ptr<T> desired) noexcept {
+		return compare_exchange_strong(expected, std::move(desired));
+	}
+};
+
+/**
+ * @brief A raw::weak_ptr that can be loaded and replaced concurrently without locks.
+ */
+template<typename T>
+class atomic_weak_ptr : public split_count_hub_slot<T, weak_hub_ref> {
+	static_assert(!std::is_array_v<T>, "raw::atomic_weak_ptr supports single objects only");
+
+	using base = split_count_hub_slot<T, weak_hub_ref>;
+
+	static inline hub* take_hub(weak_ptr<T>& observer) noexcept {
+		hub* owned		 = observer.hub_ptr;
+		observer.ptr	 = nullptr;
+		observer.hub_ptr = nullptr;
+		return owned;
+	}
+
+	static inline weak_ptr<T> adopt_hub(hub* owned) noexcept {
+		weak_ptr<T> observer;
+		if (owned) {
+			// The object pointer is only stable while somebody owns it, an expired
+			// observer never hands it out again so it can stay null
+			if (owned->try_increment_use_count_if_not_zero()) {
+				observer.ptr = static_cast<T*>(owned->managed_object_ptr);
+				owned->decrement_use_count();
+			}
+			observer.hub_ptr = owned;
+		}
+		return observer;
+	}
+
+public:
+	atomic_weak_ptr() noexcept : base(nullptr) {}
+
+	atomic_weak_ptr(weak_ptr<T> desired) noexcept : base(take_hub(desired)) {}
+
+	weak_ptr<T> load() const noexcept {
+		return adopt_hub(this->acquire());
+	}
+
+	operator weak_ptr<T>() const noexcept {
+		return load();
+	}
+
+	void store(weak_ptr<T> desired) noexcept {
+		if (hub* old_hub = this->exchange_hub(take_hub(desired))) {
+			weak_hub_ref::release(old_hub);
+		}
+	}
+
+	atomic_weak_ptr& operator=(weak_ptr<T> desired) noexcept {
+		store(std::move(desired));
+		return *this;
+	}
+
+	weak_ptr<T> exchange(weak_ptr<T> desired) noexcept {
+		return adopt_hub(this->exchange_hub(take_hub(desired)));
+	}
+
+	bool compare_exchange_strong(weak_ptr<T>& expected, weak_ptr<T> desired) noexcept {
+		if (this->compare_exchange_hub(expected.hub_ptr, desired.hub_ptr)) {
+			take_hub(desired);
+			return true;
+		}
+		expected = load();
+		return false;
+	}
+
+	bool compare_exchange_weak(weak_ptr<T>& expected, weak_ptr<T> desired) noexcept {
+		return compare_exchange_strong(expected, std::move(desired));
+	}
+};
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_ATOMIC_SHARED_PTR_H
@@ -0,0 +1,563 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_CYCLE_COLLECTOR_H
+#define SMARTPOINTERS_CYCLE_COLLECTOR_H
+
+#ifdef RAW_CYCLE_COLLECTOR
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fwd.h"
+#include "hub.h"
+
+#define RAW_TRACE_EDGES(hub, type) ::raw::cycle_tracer::stamp<type>(hub)
+#else
+#define RAW_TRACE_EDGES(hub, type) ((void)0)
+#endif
+
+namespace raw {
+#ifdef RAW_CYCLE_COLLECTOR
+
+/**
+ * @brief Hands the cycle collector the raw::shared_ptr edges of one object.
+ *
+ * A type takes part in cycle collection by having a member
+ * `void trace(raw::cycle_tracer& tracer) noexcept` that calls tracer(edge) exactly once for
+ * every raw::shared_ptr the object owns, including those inside members it owns by value. An
+ * edge left out only counts as a reference from outside, so it keeps garbage alive but never
+ * gets a live object freed; an edge reported twice can.
+ */
+class cycle_tracer {
+public:
+	template<typename U>
+	void operator()(shared_ptr<U>& edge) noexcept {
+		if (edge.hub_ptr) {
+			on_edge(edge.hub_ptr, &edge, &reset_edge<U>);
+		}
+	}
+
+	// Gives the hub a trace function if T has a trace() member
+	template<typename T, typename Hub>
+	static void stamp(Hub* owner) noexcept {
+		using object_type = std::remove_cv_t<T>;
+		if constexpr (requires(object_type& object, cycle_tracer& tracer) {
+						  object.trace(tracer);
+					  }) {
+			owner->trace_edges = &trace_object<object_type>;
+		}
+	}
+
+private:
+	friend class cycle_collector;
+
+	using reset_func = void (*)(void* edge) noexcept;
+	using edge_func	 = void (*)(hub* target, void* edge, reset_func reset) noexcept;
+
+	edge_func on_edge;
+
+	explicit cycle_tracer(edge_func handler) noexcept : on_edge(handler) {}
+
+	template<typename U>
+	static void reset_edge(void* edge) noexcept {
+		static_cast<shared_ptr<U>*>(edge)->reset();
+	}
+
+	template<typename T>
+	static void trace_object(void* object, cycle_tracer& tracer) noexcept {
+		static_cast<T*>(object)->trace(tracer);
+	}
+};
+
+// Bounds one cycle_collector pass
+struct cycle_limits {
+	// Candidate roots a pass examines, the others wait for the next pass
+	size_t max_roots = std::numeric_limits<size_t>::max();
+	// Objects a pass may trace before it gives up and buffers its roots again. A garbage cycle
+	// larger than this is never collected by passes with the same limit, a pass with a larger
+	// one has to free it.
+	size_t max_objects = std::numeric_limits<size_t>::max();
+};
+
+struct cycle_report {
+	// Candidate roots examined and objects traced from them
+	size_t roots  = 0;
+	size_t traced = 0;
+	// Garbage objects freed
+	size_t collected = 0;
+	// Candidate roots left for a later pass
+	size_t pending = 0;
+	// Set when max_objects was reached (or memory ran out) and nothing was collected
+	bool aborted = false;
+	// Marking and breaking the cycles, while the traced graph must not change
+	uint64_t pause_ns = 0;
+	// Destroying the garbage afterwards
+	uint64_t release_ns = 0;
+};
+
+struct cycle_totals {
+	size_t	 passes			= 0;
+	size_t	 aborted_passes = 0;
+	size_t	 collected		= 0;
+	uint64_t max_pause_ns	= 0;
+	uint64_t total_pause_ns = 0;
+};
+
+/**
+ * @brief Frees garbage cycles of raw::shared_ptr, by trial deletion (Bacon and Rajan).
+ *
+ * Only objects whose type has a trace() member (see cycle_tracer) take part. When a decrement
+ * leaves such an object alive, its hub is buffered as a candidate root with one lock-free push.
+ * A pass then subtracts the references the traced objects hold on each other from copies of
+ * their use counts. Whatever is left with no reference from outside, and is not reachable
+ * from an object that has one, is garbage: its edges into the garbage are reset and the
+ * objects are released as usual, so their destructors see those pointers empty.
+ *
+ * The traced objects must not change while a pass marks them. collect() runs on the calling
+ * thread, which is responsible for that; the thread started by start() holds the given mutex,
+ * which every thread must then hold while it reads or writes raw::shared_ptr members of traced
+ * objects. Destructors of the garbage run after the mutex is released. With thread-safe
+ * counters a garbage object that weak_ptrs (including those from weak_from_this()) still
+ * observe is kept, as a concurrent lock() could resurrect it, and its roots are buffered again;
+ * single-threaded builds collect those too.
+ *
+ * Compiled in with RAW_CYCLE_COLLECTOR only. RAW_CYCLE_REPORT in the environment prints the
+ * totals at exit.
+ */
+class cycle_collector {
+public:
+	using interval_type = std::chrono::microseconds;
+
+	static constexpr interval_type default_interval = std::chrono::milliseconds(10);
+
+private:
+	enum color : uint8_t { black = 0, gray, white };
+
+	// Guarded by pass_mutex. pending holds a weak reference on every hub in it, roots and
+	// garbage a use count reference (a pin) until the pass hands them to release().
+	static std::mutex		 pass_mutex;
+	static std::deque<hub*>	 pending;
+	static std::vector<hub*> roots;
+	static std::vector<hub*> traced;
+	static std::vector<hub*> work;
+	static std::vector<hub*> garbage;
+	static bool				 out_of_memory;
+	static cycle_totals		 totals_;
+	// Set while this thread runs a pass or its destructors, collect() then returns right away
+	static thread_local bool collecting;
+
+	// Guarded by session_mutex
+	static std::mutex			   session_mutex;
+	static std::condition_variable wakeup;
+	static std::thread			   collector;
+	static bool					   stop_requested;
+	static interval_type		   interval;
+	static cycle_limits			   background_limits;
+	static std::mutex*			   graph_lock;
+
+	static uint64_t now_ns() noexcept {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				   std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+	}
+
+	// Drops the collector's reference without buffering the hub again
+	static void unpin(hub* node) noexcept {
+		if (hub::thread_policy::decrement(node->use_count)) {
+			node->release_last_owner();
+		}
+	}
+
+	static void trace(hub* node, cycle_tracer::edge_func handler) noexcept {
+		cycle_tracer tracer(handler);
+		node->trace_edges(node->managed_object_ptr, tracer);
+	}
+
+	// Colors node gray with a copy of its use count, less the collector's own pins
+	static bool visit(hub* node, size_t pins) noexcept {
+		try {
+			traced.push_back(node);
+			work.push_back(node);
+		} catch (...) {
+			out_of_memory = true;
+			return false;
+		}
+		node->cycle_color = gray;
+		node->cycle_count = node->get_use_count() - pins;
+		return true;
+	}
+
+	// Trial deletion: takes the reference a traced object holds off its target's count
+	static void mark_edge(hub* target, void*, cycle_tracer::reset_func) noexcept {
+		if (!target->trace_edges) {
+			return;
+		}
+		if (target->cycle_color == black && !visit(target, 0)) {
+			return;
+		}
+		--target->cycle_count;
+	}
+
+	// Gives the reference back, target is reachable from outside after all
+	static void restore_edge(hub* target, void*, cycle_tracer::reset_func) noexcept {
+		if (!target->trace_edges) {
+			return;
+		}
+		++target->cycle_count;
+		if (target->cycle_color != black) {
+			target->cycle_color = black;
+			// Reserved for every traced object, cannot throw
+			work.push_back(target);
+		}
+	}
+
+	static void clear_edge(hub* target, void* edge, cycle_tracer::reset_func reset) noexcept {
+		if (target->cycle_color == white) {
+			reset(edge);
+		}
+	}
+
+	// A lock() on another thread could still resurrect the object. Besides the owners' shared
+	// reference, a hub still buffered (in cycle_candidates or pending) has the buffer's own weak
+	// reference, which is no observer. The flag is read first: once it is seen set, that
+	// reference is already counted, and one added after it was seen clear only errs towards
+	// keeping the object.
+	static bool observed(hub* node) noexcept {
+		if constexpr (!hub::thread_policy::is_thread_safe) {
+			return false;
+		}
+		size_t own_references = node->cycle_buffered.load(std::memory_order_acquire) ? 2 : 1;
+		return hub::thread_policy::load(node->weak_count) > own_references;
+	}
+
+	// Moves the buffered candidates to pending, oldest first. Those that do not fit stay buffered.
+	static void take_candidates() noexcept {
+		hub* node = hub::cycle_candidates.take_all();
+		try {
+			for (; node; node = node->next_candidate) {
+				pending.push_back(node);
+			}
+		} catch (...) {
+			while (node) {
+				hub* next = node->next_candidate;
+				hub::cycle_candidates.push(node);
+				node = next;
+			}
+		}
+	}
+
+	// Pins up to max_roots candidates; the dead ones only lose the buffer's weak reference
+	static void take_roots(size_t max_roots) {
+		size_t count = std::min(max_roots, pending.size());
+		roots.assign(pending.begin(), pending.begin() + count);
+		pending.erase(pending.begin(), pending.begin() + count);
+		for (hub*& root : roots) {
+			// A decrement from here on buffers the hub again
+			root->cycle_buffered.store(false, std::memory_order_release);
+			bool alive = root->try_increment_use_count_if_not_zero();
+			root->decrement_weak_count();
+			if (!alive) {
+				root = nullptr;
+			}
+		}
+		std::erase(roots, nullptr);
+	}
+
+	// For the next pass to look at them again, release() still unpins them
+	static void buffer_roots_again() noexcept {
+		for (hub* root : roots) {
+			if (!root->cycle_buffered.exchange(true, std::memory_order_acq_rel)) {
+				root->increment_weak_count();
+				hub::cycle_candidates.push(root);
+			}
+		}
+	}
+
+	// Leaves every object as it was
+	static void abort_pass(cycle_report& report) noexcept {
+		for (hub* node : traced) {
+			node->cycle_color = black;
+		}
+		buffer_roots_again();
+		garbage.clear();
+		report.aborted = true;
+	}
+
+	/**
+	 * @brief Marks the graph reachable from the roots and breaks the garbage cycles in it.
+	 *
+	 * Leaves the roots and the garbage pinned for release(), so no destructor runs here.
+	 */
+	static void mark_and_break(const cycle_limits& limits, cycle_report& report) noexcept {
+		roots.clear();
+		traced.clear();
+		work.clear();
+		garbage.clear();
+		out_of_memory = false;
+		try {
+			take_roots(limits.max_roots);
+		} catch (...) {
+			// Nothing was pinned yet, the candidates are all still pending
+			roots.clear();
+			abort_pass(report);
+			return;
+		}
+		report.roots = roots.size();
+
+		// Every root before any edge, so each pin is subtracted exactly once
+		for (hub* root : roots) {
+			visit(root, 1);
+		}
+		while (!work.empty() && !out_of_memory && traced.size() <= limits.max_objects) {
+			hub* node = work.back();
+			work.pop_back();
+			trace(node, &mark_edge);
+		}
+		report.traced = traced.size();
+		if (out_of_memory || traced.size() > limits.max_objects) {
+			abort_pass(report);
+			return;
+		}
+
+		try {
+			work.reserve(traced.size());
+			garbage.reserve(traced.size());
+		} catch (...) {
+			abort_pass(report);
+			return;
+		}
+		// Whatever an object with outside references reaches stays alive
+		bool kept_observed = false;
+		for (hub* node : traced) {
+			if (node->cycle_color == gray && node->cycle_count == 0 && observed(node)) {
+				kept_observed = true;
+			}
+			if (node->cycle_color == gray && (node->cycle_count > 0 || observed(node))) {
+				node->cycle_color = black;
+				work.push_back(node);
+				while (!work.empty()) {
+					hub* reached = work.back();
+					work.pop_back();
+					trace(reached, &restore_edge);
+				}
+			}
+		}
+		// Possibly garbage once the weak_ptrs are gone
+		if (kept_observed) {
+			buffer_roots_again();
+		}
+		for (hub* node : traced) {
+			if (node->cycle_color == gray) {
+				node->cycle_color = white;
+				garbage.push_back(node);
+			}
+		}
+
+		// Pinned, resetting the edges between them cannot free anything yet. Marked as buffered
+		// so those decrements do not make them candidates again.
+		for (hub* node : garbage) {
+			node->increment_use_count();
+			node->cycle_buffered.store(true, std::memory_order_relaxed);
+		}
+		for (hub* node : garbage) {
+			trace(node, &clear_edge);
+		}
+		for (hub* node : traced) {
+			node->cycle_color = black;
+		}
+		report.collected = garbage.size();
+	}
+
+	// Drops the pins of a pass, destroying the garbage
+	static void release(const std::vector<hub*>& pinned_roots,
+						const std::vector<hub*>& pinned_garbage) noexcept {
+		for (hub* root : pinned_roots) {
+			unpin(root);
+		}
+		for (hub* node : pinned_garbage) {
+			unpin(node);
+		}
+	}
+
+	static void finish(cycle_report& report, uint64_t start, uint64_t marked, uint64_t end) {
+		report.pause_ns	  = marked - start;
+		report.release_ns = end - marked;
+		++totals_.passes;
+		totals_.aborted_passes += report.aborted;
+		totals_.collected += report.collected;
+		totals_.max_pause_ns = std::max(totals_.max_pause_ns, report.pause_ns);
+		totals_.total_pause_ns += report.pause_ns;
+	}
+
+	static cycle_report run_pass(std::mutex* graph, const cycle_limits& limits) {
+		cycle_report report;
+		if (collecting) {
+			return report;
+		}
+		std::unique_lock<std::mutex> graph_guard;
+		std::unique_lock			 lock(pass_mutex);
+		collecting = true;
+		// Draining the buffer touches every candidate but none of the objects, so it happens
+		// before the pause. The graph lock comes first whenever both are held.
+		take_candidates();
+		if (graph) {
+			lock.unlock();
+			graph_guard = std::unique_lock(*graph);
+			lock.lock();
+		}
+		uint64_t start	= now_ns();
+		mark_and_break(limits, report);
+		uint64_t marked = now_ns();
+		report.pending	= pending.size();
+
+		// Destructors of the garbage may take either lock
+		std::vector<hub*> pinned_roots	 = std::move(roots);
+		std::vector<hub*> pinned_garbage = std::move(garbage);
+		lock.unlock();
+		if (graph) {
+			graph_guard.unlock();
+		}
+		release(pinned_roots, pinned_garbage);
+		uint64_t end = now_ns();
+		lock.lock();
+		finish(report, start, marked, end);
+		collecting = false;
+		return report;
+	}
+
+	static void collect_loop() {
+		std::unique_lock lock(session_mutex);
+		size_t			 left_over = 0;
+		while (!stop_requested) {
+			wakeup.wait_for(lock, interval);
+			if (stop_requested || (left_over == 0 && hub::cycle_candidates.empty())) {
+				continue;
+			}
+			std::mutex*	 graph	= graph_lock;
+			cycle_limits limits = background_limits;
+			lock.unlock();
+			left_over = run_pass(graph, limits).pending;
+			lock.lock();
+		}
+	}
+
+public:
+	cycle_collector() = delete;
+
+	/**
+	 * @brief Runs one pass on the calling thread and destroys the garbage it found.
+	 *
+	 * The caller must keep the traced objects from changing until it returns, for instance by
+	 * holding the mutex given to start(). Called from a destructor the pass runs, it does
+	 * nothing.
+	 */
+	static cycle_report collect(const cycle_limits& limits = {}) {
+		return run_pass(nullptr, limits);
+	}
+
+	/**
+	 * @brief Starts a thread that runs a pass every poll_interval while holding graph.
+	 * @return false if it already runs, or if the hubs' counters are not thread-safe.
+	 */
+	static bool start(std::mutex& graph, interval_type poll_interval = default_interval,
+					  const cycle_limits& limits = {}) {
+		if (!hub::thread_policy::is_thread_safe) {
+			return false;
+		}
+		std::lock_guard lock(session_mutex);
+		if (collector.joinable()) {
+			return false;
+		}
+		interval		  = poll_interval.count() > 0 ? poll_interval : default_interval;
+		background_limits = limits;
+		graph_lock		  = &graph;
+		stop_requested	  = false;
+		collector		  = std::thread(&cycle_collector::collect_loop);
+		return true;
+	}
+
+	static void stop() {
+		{
+			std::lock_guard lock(session_mutex);
+			if (!collector.joinable()) {
+				return;
+			}
+			stop_requested = true;
+		}
+		wakeup.notify_one();
+		collector.join();
+	}
+
+	[[nodiscard]] static bool running() {
+		std::lock_guard lock(session_mutex);
+		return collector.joinable();
+	}
+
+	// Sums over every pass so far, including the background ones
+	[[nodiscard]] static cycle_totals totals() {
+		std::lock_guard lock(pass_mutex);
+		return totals_;
+	}
+};
+
+inline std::mutex					  cycle_collector::pass_mutex;
+inline std::deque<hub*>				  cycle_collector::pending;
+inline std::vector<hub*>			  cycle_collector::roots;
+inline std::vector<hub*>			  cycle_collector::traced;
+inline std::vector<hub*>			  cycle_collector::work;
+inline std::vector<hub*>			  cycle_collector::garbage;
+inline bool							  cycle_collector::out_of_memory  = false;
+inline cycle_totals					  cycle_collector::totals_;
+inline thread_local bool			  cycle_collector::collecting	  = false;
+inline std::mutex					  cycle_collector::session_mutex;
+inline std::condition_variable		  cycle_collector::wakeup;
+inline std::thread					  cycle_collector::collector;
+inline bool							  cycle_collector::stop_requested = false;
+inline cycle_collector::interval_type cycle_collector::interval		  = default_interval;
+inline cycle_limits					  cycle_collector::background_limits;
+inline std::mutex*					  cycle_collector::graph_lock	  = nullptr;
+
+// Runs one cycle_collector pass on the calling thread, see cycle_collector::collect()
+inline cycle_report collect_cycles(const cycle_limits& limits = {}) {
+	return cycle_collector::collect(limits);
+}
+
+inline void dump_cycle_totals(std::FILE* out = stderr) {
+	cycle_totals totals = cycle_collector::totals();
+	std::fprintf(out, "cycle collector: %zu passes (%zu aborted), %zu objects collected\n",
+				 totals.passes, totals.aborted_passes, totals.collected);
+	std::fprintf(out, "pause: max %.1f us, total %.1f us\n", totals.max_pause_ns / 1000.0,
+				 totals.total_pause_ns / 1000.0);
+}
+
+// Stops the background collector at exit, and prints the totals if RAW_CYCLE_REPORT is set
+struct cycle_collector_session {
+	~cycle_collector_session() {
+		cycle_collector::stop();
+		if (std::getenv("RAW_CYCLE_REPORT")) {
+			dump_cycle_totals();
+		}
+	}
+};
+
+// Defined after the collector's own statics, so it is constructed after and destroyed before them
+inline cycle_collector_session cycle_collector_default;
+
+#endif
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_CYCLE_COLLECTOR_H
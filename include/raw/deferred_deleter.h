@@ -0,0 +1,249 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_DEFERRED_DELETER_H
+#define SMARTPOINTERS_DEFERRED_DELETER_H
+
+#ifdef RAW_DEFERRED_RECLAIM
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include "hub.h"
+#endif
+
+namespace raw {
+#ifdef RAW_DEFERRED_RECLAIM
+
+/**
+ * @brief Releases the hubs of pointers that opted in with defer_reclamation(), off the hot path.
+ *
+ * The last owner of such a hub only pushes it onto a lock-free queue (one compare-exchange).
+ * The object's destructor and the frees run later, on the reclaimer thread between start() and
+ * stop(), or on whichever thread calls drain(). Until then the object stays alive but expired:
+ * its weak_ptrs fail to lock.
+ *
+ * The elements of a make_shared array are destroyed in slices: step() destroys at most a given
+ * number of elements and returns, resuming the array where it left off on the next call. The
+ * array's block is freed with its last slice.
+ *
+ * Compiled in with RAW_DEFERRED_RECLAIM only. The reclaimer thread needs RAW_MULTI_THREADED,
+ * since weak_ptrs of the released hubs may still be used on other threads; drain() works with
+ * either policy. RAW_RECLAIMER_INTERVAL_US=n in the environment starts the reclaimer for the
+ * whole run, polling every n microseconds.
+ */
+class deferred_deleter {
+public:
+	using interval_type = std::chrono::microseconds;
+
+	static constexpr interval_type default_interval = std::chrono::microseconds(1000);
+	// Elements the reclaimer destroys before it lets step() callers on other threads in
+	static constexpr size_t default_slice = 1024;
+
+private:
+	struct progress {
+		size_t elements = 0;
+		size_t hubs		= 0;
+		// Set once the queue was found empty
+		bool emptied = false;
+	};
+
+	// Guarded by session_mutex
+	static std::mutex			   session_mutex;
+	static std::condition_variable wakeup;
+	static std::thread			   reclaimer;
+	static bool					   stop_requested;
+	static interval_type		   interval;
+
+	// Guarded by backlog_mutex: hubs taken off the queue, oldest first. The first one may be an
+	// array that is partly destroyed already.
+	static std::mutex backlog_mutex;
+	static hub*		  backlog;
+	// Set while this thread reclaims, a destructor calling back in then returns right away
+	static thread_local bool reclaiming;
+
+	// Destroys up to budget elements of an array, or releases any other hub. True once released.
+	static bool reclaim_one(hub* queued, size_t budget, progress& done) noexcept {
+		if (queued->element_size && queued->destroy_obj_func) {
+			size_t	   count = std::min(budget, queued->obj_size - queued->reclaimed_elements);
+			std::byte* first = static_cast<std::byte*>(queued->managed_object_ptr) +
+							   queued->reclaimed_elements * queued->element_size;
+			queued->destroy_obj_func(first, count);
+			queued->reclaimed_elements += count;
+			done.elements += count;
+			if (queued->reclaimed_elements < queued->obj_size) {
+				return false;
+			}
+			// Every element is gone, releasing the hub only frees the block
+			queued->destroy_obj_func = nullptr;
+		} else {
+			++done.elements;
+		}
+		hub::release_deferred(queued);
+		++done.hubs;
+		return true;
+	}
+
+	static progress reclaim(size_t budget) noexcept {
+		progress done;
+		if (reclaiming) {
+			return done;
+		}
+		std::lock_guard lock(backlog_mutex);
+		reclaiming = true;
+		while (done.elements < budget) {
+			if (!backlog && !(backlog = hub::deferred_queue.take_all())) {
+				done.emptied = true;
+				break;
+			}
+			hub* next = backlog->next_deferred;
+			if (!reclaim_one(backlog, budget - done.elements, done)) {
+				break;
+			}
+			backlog = next;
+		}
+		reclaiming = false;
+		return done;
+	}
+
+	static void reclaim_loop() {
+		std::unique_lock lock(session_mutex);
+		while (!stop_requested) {
+			lock.unlock();
+			while (!reclaim(default_slice).emptied) {
+			}
+			lock.lock();
+			wakeup.wait_for(lock, interval);
+		}
+	}
+
+public:
+	deferred_deleter() = delete;
+
+	/**
+	 * @brief Starts the reclaimer thread, which drains the queue every poll_interval.
+	 * @return false if it already runs, or if the hubs' counters are not thread-safe.
+	 */
+	static bool start(interval_type poll_interval = default_interval) {
+		if (!hub::thread_policy::is_thread_safe) {
+			return false;
+		}
+		std::lock_guard lock(session_mutex);
+		if (reclaimer.joinable()) {
+			return false;
+		}
+		interval	   = poll_interval.count() > 0 ? poll_interval : default_interval;
+		stop_requested = false;
+		reclaimer	   = std::thread(&deferred_deleter::reclaim_loop);
+		return true;
+	}
+
+	// Stops the reclaimer thread after it released everything queued so far
+	static void stop() {
+		{
+			std::lock_guard lock(session_mutex);
+			if (!reclaimer.joinable()) {
+				return;
+			}
+			stop_requested = true;
+		}
+		wakeup.notify_one();
+		reclaimer.join();
+		drain();
+	}
+
+	[[nodiscard]] static bool running() {
+		std::lock_guard lock(session_mutex);
+		return reclaimer.joinable();
+	}
+
+	/**
+	 * @brief Releases every queued hub on the calling thread.
+	 * @return how many hubs were released, including those queued while it ran.
+	 */
+	static size_t drain() noexcept {
+		return reclaim(std::numeric_limits<size_t>::max()).hubs;
+	}
+
+	/**
+	 * @brief Destroys up to budget queued elements on the calling thread.
+	 *
+	 * An array counts its elements, any other hub counts as one together with everything its
+	 * object owns. Called from the destructor of an object being reclaimed, it does nothing.
+	 * @return how many were destroyed, 0 once the queue is empty.
+	 */
+	static size_t step(size_t budget) noexcept {
+		return reclaim(budget).elements;
+	}
+
+	[[nodiscard]] static bool idle() {
+		std::lock_guard lock(backlog_mutex);
+		return !backlog && hub::deferred_queue.empty();
+	}
+};
+
+inline std::mutex					   deferred_deleter::session_mutex;
+inline std::condition_variable		   deferred_deleter::wakeup;
+inline std::thread					   deferred_deleter::reclaimer;
+inline bool							   deferred_deleter::stop_requested	= false;
+inline deferred_deleter::interval_type deferred_deleter::interval		= default_interval;
+inline std::mutex					   deferred_deleter::backlog_mutex;
+inline hub*							   deferred_deleter::backlog		= nullptr;
+inline thread_local bool			   deferred_deleter::reclaiming		= false;
+
+// Releases every deferred hub on the calling thread, see deferred_deleter
+inline size_t drain_reclamation() noexcept {
+	return deferred_deleter::drain();
+}
+
+// Destroys up to budget deferred elements on the calling thread, see deferred_deleter::step()
+inline size_t reclaim_step(size_t budget) noexcept {
+	return deferred_deleter::step(budget);
+}
+
+/**
+ * @brief Reclaims slices of slice elements until the queue is empty or budget has passed.
+ * @return how many elements were destroyed.
+ */
+inline size_t reclaim_step(std::chrono::nanoseconds budget,
+						   size_t slice = deferred_deleter::default_slice) noexcept {
+	auto   deadline	 = std::chrono::steady_clock::now() + budget;
+	size_t destroyed = 0;
+	do {
+		size_t slice_destroyed = deferred_deleter::step(slice);
+		if (!slice_destroyed) {
+			break;
+		}
+		destroyed += slice_destroyed;
+	} while (std::chrono::steady_clock::now() < deadline);
+	return destroyed;
+}
+
+// Starts the reclaimer when RAW_RECLAIMER_INTERVAL_US is set, releases what is left at exit
+struct deferred_deleter_session {
+	deferred_deleter_session() {
+		if (const char* interval = std::getenv("RAW_RECLAIMER_INTERVAL_US")) {
+			deferred_deleter::start(std::chrono::microseconds(std::strtoul(interval, nullptr, 10)));
+		}
+	}
+	~deferred_deleter_session() {
+		// stop() drains as well, but only if the reclaimer ran
+		deferred_deleter::stop();
+		drain_reclamation();
+	}
+};
+
+// Defined after the deleter's own statics, so it is constructed after and destroyed before them
+inline deferred_deleter_session deferred_deleter_default;
+
+#endif
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_DEFERRED_DELETER_H
@@ -0,0 +1,440 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_DIAGNOSTICS_H
+#define SMARTPOINTERS_DIAGNOSTICS_H
+
+#include <cstddef>
+#include <source_location>
+
+// The contention profiler counts the refcount traffic of the hubs the live registry samples
+#if defined(RAW_PROFILE_CONTENTION) && !defined(RAW_LEAK_TRACKER)
+#define RAW_LEAK_TRACKER
+#endif
+
+#ifdef RAW_LEAK_TRACKER
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "type_name.h"
+#endif
+
+namespace raw::diagnostics {
+#ifdef RAW_LEAK_TRACKER
+
+#ifdef RAW_PROFILE_CONTENTION
+// Refcount traffic on one sampled hub, every thread that touches the hub updates it
+struct contention_counters {
+	std::atomic<uint64_t> operations {0};
+	// Operations by another thread than the one before, each one likely moved the cache line
+	std::atomic<uint64_t> handoffs {0};
+	std::atomic<uint64_t> cas_retries {0};
+	// One bit per profiler thread id, modulo 64
+	std::atomic<uint64_t> thread_mask {0};
+	std::atomic<uint32_t> last_thread {0};
+};
+
+// Refcount traffic of the sampled hubs created at one site for one type, dead ones included
+struct site_contention {
+	std::source_location site;
+	std::string			 type_name;
+	size_t				 hubs		 = 0;
+	uint64_t			 operations	 = 0;
+	uint64_t			 handoffs	 = 0;
+	uint64_t			 cas_retries = 0;
+	// Most distinct threads seen on one hub, counted up to 64
+	uint32_t max_threads = 0;
+};
+#endif
+
+// One sampled hub, linked into a shard of the live registry until its object is destroyed
+struct live_entry {
+	live_entry*			 prev = nullptr;
+	live_entry*			 next = nullptr;
+	const char*			 type_signature;
+	std::source_location site;
+	size_t				 bytes;
+	// Hubs this sample stands for, the sampling interval it was taken at
+	uint32_t weight;
+	uint32_t shard;
+#ifdef RAW_PROFILE_CONTENTION
+	contention_counters contention;
+#endif
+};
+
+// File, line, column and type signature, what the reports group samples by
+using site_key = std::tuple<std::string_view, uint_least32_t, uint_least32_t, std::string_view>;
+
+inline site_key key_of(const live_entry& entry) noexcept {
+	return {entry.site.file_name(), entry.site.line(), entry.site.column(), entry.type_signature};
+}
+
+#ifdef RAW_PROFILE_CONTENTION
+// 1-based, so 0 can mean no thread yet
+inline uint32_t profiler_thread_id() noexcept {
+	static std::atomic<uint32_t> next_id {0};
+	thread_local uint32_t		 id = next_id.fetch_add(1, std::memory_order_relaxed) + 1;
+	return id;
+}
+
+// Called by a sampled hub before a refcount operation, with the CAS retries a lock() needed
+inline void record_refcount(live_entry* entry, size_t retries) noexcept {
+	if (!entry) {
+		return;
+	}
+	contention_counters& counters = entry->contention;
+	uint32_t			 self	  = profiler_thread_id();
+	counters.operations.fetch_add(1, std::memory_order_relaxed);
+	if (retries) {
+		counters.cas_retries.fetch_add(retries, std::memory_order_relaxed);
+	}
+	uint64_t bit = uint64_t(1) << (self % 64);
+	if (!(counters.thread_mask.load(std::memory_order_relaxed) & bit)) {
+		counters.thread_mask.fetch_or(bit, std::memory_order_relaxed);
+	}
+	if (counters.last_thread.load(std::memory_order_relaxed) != self) {
+		counters.last_thread.store(self, std::memory_order_relaxed);
+		counters.handoffs.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+inline void add_contention(site_contention& totals, const live_entry& entry) noexcept {
+	const contention_counters& counters = entry.contention;
+
+	uint32_t threads = std::popcount(counters.thread_mask.load(std::memory_order_relaxed));
+
+	totals.site = entry.site;
+	totals.hubs += 1;
+	totals.operations += counters.operations.load(std::memory_order_relaxed);
+	totals.handoffs += counters.handoffs.load(std::memory_order_relaxed);
+	totals.cas_retries += counters.cas_retries.load(std::memory_order_relaxed);
+	totals.max_threads = std::max(totals.max_threads, threads);
+}
+
+inline void merge_contention(site_contention& totals, const site_contention& other) noexcept {
+	totals.site = other.site;
+	totals.hubs += other.hubs;
+	totals.operations += other.operations;
+	totals.handoffs += other.handoffs;
+	totals.cas_retries += other.cas_retries;
+	totals.max_threads = std::max(totals.max_threads, other.max_threads);
+}
+#endif
+
+// Live hubs created at one site for one type, the estimates scale every sample by its weight
+struct site_report {
+	std::source_location site;
+	std::string			 type_name;
+	size_t				 sampled		 = 0;
+	size_t				 estimated_count = 0;
+	size_t				 estimated_bytes = 0;
+};
+
+struct live_report {
+	size_t sampled		   = 0;
+	size_t estimated_count = 0;
+	size_t estimated_bytes = 0;
+	// Heaviest first by estimated bytes
+	std::vector<site_report> top_sites;
+};
+
+/**
+ * @brief Registry of sampled live hubs, the leak tracker behind dump_live().
+ *
+ * Every sample_every-th hub a thread creates through make_shared or shared_ptr(T*) is recorded
+ * with its type, its bytes and the call site, and stays listed until its object is destroyed.
+ * Hubs kept alive by a reference cycle therefore pile up at the site that created them.
+ *
+ * The registry is split into shards with a mutex each and a thread always records into the same
+ * shard, so only sampled hubs take a lock and threads rarely share one. With sampling off
+ * (sample_every 0, the default) creating a hub costs one relaxed load. Compiled in with
+ * RAW_LEAK_TRACKER only, RAW_LEAK_SAMPLE in the environment sets the interval at startup.
+ */
+class live_registry {
+public:
+	static constexpr uint32_t shard_count = 16;
+
+private:
+	struct alignas(64) shard {
+		std::mutex	mutex;
+		live_entry* head = nullptr;
+#ifdef RAW_PROFILE_CONTENTION
+		// What the hubs this shard listed saw before they died
+		std::map<site_key, site_contention> retired;
+#endif
+	};
+
+	static shard				 shards[shard_count];
+	static std::atomic<uint32_t> sample_every;
+	static std::atomic<uint32_t> next_shard;
+
+	// Hubs this thread still skips before it samples the next one
+	static thread_local uint32_t sample_countdown;
+	static thread_local uint32_t local_shard;
+
+public:
+	live_registry() = delete;
+
+	// 0 turns sampling off, hubs sampled before stay listed until they die
+	static void set_sample_every(uint32_t every) noexcept {
+		sample_every.store(every, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] static uint32_t sample_interval() noexcept {
+		return sample_every.load(std::memory_order_relaxed);
+	}
+
+	// Whether the hub being created now is one to record
+	[[nodiscard]] static bool sample() noexcept {
+		uint32_t every = sample_every.load(std::memory_order_relaxed);
+		if (!every) {
+			return false;
+		}
+		// Cut short what is left of a longer interval set before
+		if (sample_countdown >= every) {
+			sample_countdown = every - 1;
+		}
+		if (sample_countdown) {
+			--sample_countdown;
+			return false;
+		}
+		sample_countdown = every - 1;
+		return true;
+	}
+
+	// nullptr if the entry could not be allocated, the hub just goes untracked then
+	static live_entry* track(const char* type_signature, size_t bytes,
+							 const std::source_location& site) noexcept {
+		if (local_shard == shard_count) {
+			local_shard = next_shard.fetch_add(1, std::memory_order_relaxed) % shard_count;
+		}
+		auto* entry = new (std::nothrow) live_entry;
+		if (!entry) {
+			return nullptr;
+		}
+		entry->type_signature = type_signature;
+		entry->site			  = site;
+		entry->bytes		  = bytes;
+		entry->weight		  = std::max<uint32_t>(sample_interval(), 1);
+		entry->shard		  = local_shard;
+#ifdef RAW_PROFILE_CONTENTION
+		// The creating thread holds the line first, only a later thread's operation is a handoff
+		entry->contention.last_thread.store(profiler_thread_id(), std::memory_order_relaxed);
+#endif
+
+		shard&			owner = shards[entry->shard];
+		std::lock_guard lock(owner.mutex);
+		entry->next = owner.head;
+		if (owner.head) {
+			owner.head->prev = entry;
+		}
+		owner.head = entry;
+		return entry;
+	}
+
+	static void untrack(live_entry* entry) noexcept {
+		{
+			shard&			owner = shards[entry->shard];
+			std::lock_guard lock(owner.mutex);
+			if (entry->prev) {
+				entry->prev->next = entry->next;
+			} else {
+				owner.head = entry->next;
+			}
+			if (entry->next) {
+				entry->next->prev = entry->prev;
+			}
+#ifdef RAW_PROFILE_CONTENTION
+			// A failed allocation only loses this hub's numbers
+			try {
+				add_contention(owner.retired[key_of(*entry)], *entry);
+			} catch (const std::bad_alloc&) {
+			}
+#endif
+		}
+		delete entry;
+	}
+
+	// Groups the live samples by site and type, keeping the top heaviest sites
+	static live_report collect(size_t top) {
+		std::map<site_key, std::pair<site_report, const char*>> sites;
+
+		live_report report;
+		for (shard& owner : shards) {
+			std::lock_guard lock(owner.mutex);
+			for (live_entry* entry = owner.head; entry; entry = entry->next) {
+				auto& [site, signature] = sites[key_of(*entry)];
+				site.site				= entry->site;
+				signature				= entry->type_signature;
+
+				site.sampled += 1;
+				site.estimated_count += entry->weight;
+				site.estimated_bytes += size_t(entry->weight) * entry->bytes;
+			}
+		}
+
+		for (auto& [key, value] : sites) {
+			site_report& site = value.first;
+			site.type_name	  = type_name(value.second);
+
+			report.sampled += site.sampled;
+			report.estimated_count += site.estimated_count;
+			report.estimated_bytes += site.estimated_bytes;
+			report.top_sites.push_back(std::move(site));
+		}
+		std::sort(report.top_sites.begin(), report.top_sites.end(),
+				  [](const site_report& a, const site_report& b) {
+					  return a.estimated_bytes > b.estimated_bytes;
+				  });
+		if (report.top_sites.size() > top) {
+			report.top_sites.resize(top);
+		}
+		return report;
+	}
+
+#ifdef RAW_PROFILE_CONTENTION
+	// Groups the refcount traffic of live and dead samples by site and type, most handoffs first
+	static std::vector<site_contention> collect_contention(size_t top) {
+		std::map<site_key, site_contention> sites;
+		for (shard& owner : shards) {
+			std::lock_guard lock(owner.mutex);
+			for (live_entry* entry = owner.head; entry; entry = entry->next) {
+				add_contention(sites[key_of(*entry)], *entry);
+			}
+			for (const auto& [key, retired] : owner.retired) {
+				merge_contention(sites[key], retired);
+			}
+		}
+
+		std::vector<site_contention> report;
+		for (auto& [key, site] : sites) {
+			site.type_name = type_name(std::get<3>(key).data());
+			report.push_back(std::move(site));
+		}
+		std::sort(report.begin(), report.end(),
+				  [](const site_contention& a, const site_contention& b) {
+					  return a.handoffs > b.handoffs;
+				  });
+		if (report.size() > top) {
+			report.resize(top);
+		}
+		return report;
+	}
+#endif
+};
+
+inline live_registry::shard	 live_registry::shards[shard_count];
+inline std::atomic<uint32_t> live_registry::sample_every {0};
+inline std::atomic<uint32_t> live_registry::next_shard {0};
+inline thread_local uint32_t live_registry::sample_countdown = 0;
+inline thread_local uint32_t live_registry::local_shard		 = shard_count;
+
+[[nodiscard]] inline live_report collect_live(size_t top = 10) {
+	return live_registry::collect(top);
+}
+
+// Prints the live totals and the top allocation sites, heaviest first
+inline void dump_live(std::FILE* out = stderr, size_t top = 10) {
+	live_report report = collect_live(top);
+	std::fprintf(out,
+				 "raw::diagnostics: %zu live hubs sampled, ~%zu live in total, ~%zu bytes "
+				 "(sample interval %u, 0 is off)\n",
+				 report.sampled, report.estimated_count, report.estimated_bytes,
+				 live_registry::sample_interval());
+	std::fprintf(out, "%12s %12s %8s  %s\n", "~bytes", "~count", "sampled", "site");
+	for (const site_report& site : report.top_sites) {
+		std::fprintf(out, "%12zu %12zu %8zu  ", site.estimated_bytes, site.estimated_count,
+					 site.sampled);
+		if (site.site.line()) {
+			std::fprintf(out, "%s:%u %s <%s>\n", site.site.file_name(),
+						 static_cast<unsigned>(site.site.line()), site.site.function_name(),
+						 site.type_name.c_str());
+		} else {
+			std::fprintf(out, "make_shared <%s>\n", site.type_name.c_str());
+		}
+	}
+}
+
+#ifdef RAW_PROFILE_CONTENTION
+// Prints the refcount traffic of the sampled hubs by site and type, most handoffs first
+inline void dump_contention(std::FILE* out = stderr, size_t top = 10) {
+	std::vector<site_contention> report = live_registry::collect_contention(top);
+	std::fprintf(out,
+				 "raw::diagnostics: refcount contention of sampled hubs, live and dead (sample "
+				 "interval %u, 0 is off)\n",
+				 live_registry::sample_interval());
+	std::fprintf(out, "%12s %12s %12s %8s %8s  %s\n", "handoffs", "operations", "cas retries",
+				 "threads", "hubs", "site");
+	for (const site_contention& site : report) {
+		std::fprintf(out, "%12llu %12llu %12llu %8u %8zu  ",
+					 static_cast<unsigned long long>(site.handoffs),
+					 static_cast<unsigned long long>(site.operations),
+					 static_cast<unsigned long long>(site.cas_retries), site.max_threads,
+					 site.hubs);
+		if (site.site.line()) {
+			std::fprintf(out, "%s:%u %s <%s>\n", site.site.file_name(),
+						 static_cast<unsigned>(site.site.line()), site.site.function_name(),
+						 site.type_name.c_str());
+		} else {
+			std::fprintf(out, "make_shared <%s>\n", site.type_name.c_str());
+		}
+	}
+}
+#endif
+
+// Reads the sampling interval from RAW_LEAK_SAMPLE, sampling stays off without it
+struct live_registry_env_session {
+	live_registry_env_session() {
+		if (const char* every = std::getenv("RAW_LEAK_SAMPLE")) {
+			live_registry::set_sample_every(
+				static_cast<uint32_t>(std::strtoul(every, nullptr, 10)));
+		}
+	}
+};
+
+inline live_registry_env_session live_registry_env;
+
+/**
+ * @brief Records the hub in the live registry if it is sampled.
+ * @param bytes what the hub keeps alive: the object (or make_shared block) and the hub itself.
+ */
+template<typename T>
+inline void track_live(live_entry*& slot, size_t bytes, const std::source_location& site) noexcept {
+	if (live_registry::sample()) {
+		slot = live_registry::track(type_signature<T>(), bytes, site);
+	}
+}
+
+#endif
+
+} // namespace raw::diagnostics
+
+// Hook used by the pointers, compiles to nothing unless RAW_LEAK_TRACKER is defined
+#ifdef RAW_LEAK_TRACKER
+#define RAW_TRACK_LIVE(hub, type, bytes, site) \
+	::raw::diagnostics::track_live<type>((hub)->sampled_entry, bytes, site)
+#else
+#define RAW_TRACK_LIVE(hub, type, bytes, site) ((void)(site))
+#endif
+
+// Hook used by raw::hub on use counts, compiles to nothing unless RAW_PROFILE_CONTENTION is defined
+#ifdef RAW_PROFILE_CONTENTION
+#define RAW_PROFILE_REFCOUNT(hub, retries) \
+	::raw::diagnostics::record_refcount((hub)->sampled_entry, retries)
+#else
+#define RAW_PROFILE_REFCOUNT(hub, retries) ((void)0)
+#endif
+
+#endif // SMARTPOINTERS_DIAGNOSTICS_H
@@ -0,0 +1,83 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_ENABLE_SHARED_FROM_THIS_H
+#define SMARTPOINTERS_ENABLE_SHARED_FROM_THIS_H
+
+#include <memory>
+#include <type_traits>
+
+#include "fwd.h"
+#include "hub.h"
+#include "op_recorder.h"
+
+namespace raw {
+/**
+ * @brief Base class that lets an object owned by raw::shared_ptr mint new owners of itself.
+ *
+ * Instead of a full weak_ptr member the base only remembers the hub that owns the object.
+ * The hub is guaranteed to outlive the object, so the pointer needs no weak count of its own.
+ */
+template<typename T>
+class enable_shared_from_this {
+private:
+	mutable hub* owner_hub = nullptr;
+
+	template<typename U>
+	friend void hook_shared_from_this(const enable_shared_from_this<U>* base, hub* owner) noexcept;
+
+protected:
+	constexpr enable_shared_from_this() noexcept = default;
+
+	// Copies are owned by someone else (or by nobody yet), so the owner is never copied
+	enable_shared_from_this(const enable_shared_from_this&) noexcept {}
+
+	enable_shared_from_this& operator=(const enable_shared_from_this&) noexcept {
+		return *this;
+	}
+
+	~enable_shared_from_this() = default;
+
+public:
+	/**
+	 * @brief Returns a new owner of this object.
+	 * @throws std::bad_weak_ptr if the object is not (or no longer) owned by a shared_ptr.
+	 */
+	shared_ptr<T> shared_from_this() {
+		if (owner_hub && owner_hub->try_increment_use_count_if_not_zero()) {
+			RAW_RECORD_OP(shared_copy, owner_hub);
+			return shared_ptr<T>(static_cast<T*>(this), owner_hub);
+		}
+		throw std::bad_weak_ptr();
+	}
+
+	/**
+	 * @brief Returns a weak observer of this object, empty if the object has no owner.
+	 */
+	weak_ptr<T> weak_from_this() const noexcept {
+		weak_ptr<T> weak;
+		if (owner_hub) {
+			weak.ptr	 = static_cast<T*>(const_cast<enable_shared_from_this*>(this));
+			weak.hub_ptr = owner_hub;
+			owner_hub->increment_weak_count();
+			RAW_RECORD_OP(weak_copy, owner_hub);
+		}
+		return weak;
+	}
+};
+
+// Binds the object to the hub that just took ownership of it, first owner wins
+template<typename U>
+inline void hook_shared_from_this(const enable_shared_from_this<U>* base, hub* owner) noexcept {
+	if (base && !base->owner_hub) {
+		base->owner_hub = owner;
+	}
+}
+
+// Chosen for every type that does not derive from enable_shared_from_this
+inline void hook_shared_from_this(...) noexcept {}
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_ENABLE_SHARED_FROM_THIS_H
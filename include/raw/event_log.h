@@ -0,0 +1,213 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_EVENT_LOG_H
+#define SMARTPOINTERS_EVENT_LOG_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "thread_registry.h"
+
+namespace raw {
+/**
+ * @brief Per-thread single-producer rings, drained by one background thread.
+ *
+ * push() never blocks: a thread whose ring is full drops the event and counts it in
+ * dropped_events(). While a session runs, the flusher hands what the rings hold to the consumer
+ * every flush_interval, or early once a ring is half full. Events reach the consumer in order per
+ * thread, not globally.
+ *
+ * Event has to be trivially copyable with `uint64_t timestamp_ns` and `uint32_t thread_id`
+ * members, push() fills both in. Every Event type gets its own rings and flusher.
+ */
+template<typename Event, size_t RingCapacity>
+class event_log {
+public:
+	using consumer_type = void (*)(const Event* events, size_t count);
+
+	static constexpr size_t					   ring_capacity  = RingCapacity;
+	static constexpr std::chrono::milliseconds flush_interval = std::chrono::milliseconds(10);
+
+	struct alignas(64) thread_record {
+		std::atomic<bool> in_use {false};
+		thread_record*	  next = nullptr;
+		// Written only by the thread that owns the record
+		std::atomic<uint64_t> head {0};
+		// Written only by the flusher
+		alignas(64) std::atomic<uint64_t> tail {0};
+		Event							  events[RingCapacity];
+	};
+
+private:
+	struct thread_state {
+		thread_record* record	 = nullptr;
+		uint32_t	   thread_id = 0;
+
+		~thread_state() {
+			if (record) {
+				registry.release(record);
+			}
+		}
+	};
+
+	// Defined below the class, the nested types have to be complete first
+	static thread_registry<thread_record> registry;
+	static std::atomic<bool>			  running;
+	static std::atomic<uint32_t>		  next_thread_id;
+	static std::atomic<uint64_t>		  dropped;
+
+	// Session state, guarded by session_mutex
+	static std::mutex	 session_mutex;
+	static consumer_type consumer;
+	static bool			 stop_requested;
+
+	static thread_local thread_state local_state;
+
+	struct flusher_state {
+		std::condition_variable wakeup;
+		std::thread				thread;
+	};
+
+	// Built on first use, static members of a template are initialized in no set order, so one
+	// could otherwise still be unconstructed when a session starts during static initialization
+	static flusher_state& flusher() {
+		static flusher_state state;
+		return state;
+	}
+
+	static void drain() {
+		registry.for_each([](thread_record& record) {
+			uint64_t tail = record.tail.load(std::memory_order_relaxed);
+			uint64_t head = record.head.load(std::memory_order_acquire);
+			while (tail != head) {
+				size_t first = tail % RingCapacity;
+				size_t count = std::min<uint64_t>(head - tail, RingCapacity - first);
+				consumer(&record.events[first], count);
+				tail += count;
+			}
+			record.tail.store(tail, std::memory_order_release);
+		});
+	}
+
+	static void flush_loop() {
+		std::unique_lock lock(session_mutex);
+		while (!stop_requested) {
+			flusher().wakeup.wait_for(lock, flush_interval);
+			drain();
+		}
+	}
+
+public:
+	event_log() = delete;
+
+	// Starts delivering to consumer, false if a session is already running
+	static bool start(consumer_type session_consumer) {
+		std::lock_guard lock(session_mutex);
+		if (consumer) {
+			return false;
+		}
+		// Whatever a previous session left behind does not belong to this one
+		registry.for_each([](thread_record& record) {
+			record.tail.store(record.head.load(std::memory_order_acquire),
+							  std::memory_order_release);
+		});
+		dropped.store(0, std::memory_order_relaxed);
+		consumer		 = session_consumer;
+		stop_requested	 = false;
+		flusher().thread = std::thread(&event_log::flush_loop);
+		running.store(true, std::memory_order_release);
+		return true;
+	}
+
+	// Stops accepting events and hands the consumer what the rings still hold
+	static void stop() {
+		{
+			std::lock_guard lock(session_mutex);
+			if (!consumer) {
+				return;
+			}
+			running.store(false, std::memory_order_relaxed);
+			stop_requested = true;
+		}
+		flusher().wakeup.notify_one();
+		flusher().thread.join();
+
+		std::lock_guard lock(session_mutex);
+		drain();
+		consumer = nullptr;
+	}
+
+	[[nodiscard]] static bool active() noexcept {
+		return running.load(std::memory_order_relaxed);
+	}
+
+	// Events lost to full rings in the current (or last) session
+	[[nodiscard]] static uint64_t dropped_events() noexcept {
+		return dropped.load(std::memory_order_relaxed);
+	}
+
+	static void push(Event event) noexcept {
+		if (!running.load(std::memory_order_relaxed)) {
+			return;
+		}
+		thread_state& state = local_state;
+		if (!state.record) {
+			try {
+				state.record = registry.acquire();
+			} catch (const std::bad_alloc&) {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			state.thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		thread_record& record = *state.record;
+		uint64_t	   head	  = record.head.load(std::memory_order_relaxed);
+		uint64_t	   used	  = head - record.tail.load(std::memory_order_acquire);
+		if (used == RingCapacity) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		if (used == RingCapacity / 2) {
+			flusher().wakeup.notify_one();
+		}
+		auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch());
+		event.timestamp_ns				   = static_cast<uint64_t>(now.count());
+		event.thread_id					   = state.thread_id;
+		record.events[head % RingCapacity] = event;
+		record.head.store(head + 1, std::memory_order_release);
+	}
+};
+
+template<typename Event, size_t RingCapacity>
+inline thread_registry<typename event_log<Event, RingCapacity>::thread_record>
+	event_log<Event, RingCapacity>::registry;
+template<typename Event, size_t RingCapacity>
+inline std::atomic<bool> event_log<Event, RingCapacity>::running {false};
+template<typename Event, size_t RingCapacity>
+inline std::atomic<uint32_t> event_log<Event, RingCapacity>::next_thread_id {0};
+template<typename Event, size_t RingCapacity>
+inline std::atomic<uint64_t> event_log<Event, RingCapacity>::dropped {0};
+template<typename Event, size_t RingCapacity>
+inline std::mutex event_log<Event, RingCapacity>::session_mutex;
+template<typename Event, size_t RingCapacity>
+inline typename event_log<Event, RingCapacity>::consumer_type
+	event_log<Event, RingCapacity>::consumer = nullptr;
+template<typename Event, size_t RingCapacity>
+inline bool event_log<Event, RingCapacity>::stop_requested = false;
+template<typename Event, size_t RingCapacity>
+inline thread_local typename event_log<Event, RingCapacity>::thread_state
+	event_log<Event, RingCapacity>::local_state;
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_EVENT_LOG_H
@@ -9,6 +9,8 @@ namespace raw {
 
 class hub;
 
+class cycle_tracer;
+
 template<typename T>
 class smart_ptr_base;
 
@@ -21,6 +23,24 @@ class shared_ptr;
 template<typename T>
 class weak_ptr;
 
+template<typename T>
+class enable_shared_from_this;
+
+template<typename T>
+class intrusive_ptr;
+
+template<typename T>
+class atomic_shared_ptr;
+
+template<typename T>
+class atomic_weak_ptr;
+
+template<typename T>
+class hazard_guard;
+
+template<typename T>
+class rcu_ptr;
+
 } // namespace raw
 
 #endif // SMARTPOINTERS_FWD_H
@@ -0,0 +1,189 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_HAZARD_DOMAIN_H
+#define SMARTPOINTERS_HAZARD_DOMAIN_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include "thread_registry.h"
+
+namespace raw {
+/**
+ * @brief Process-wide hazard pointer slots and the list of hubs retired while protected.
+ *
+ * A reader publishes the hub it is about to use in one of its thread's slots. The last owner
+ * of a hub checks the slots before freeing anything and, if the hub is published, retires it
+ * instead. Retired hubs are freed by whoever clears the last slot pointing at them.
+ *
+ * Ordering: the reader stores its slot, issues a seq_cst fence and then reads use_count; the
+ * last owner drops use_count with a seq_cst RMW and then reads the slots with seq_cst loads.
+ * Either the reader sees zero and backs off, or the owner sees the slot and retires.
+ */
+class hazard_domain {
+public:
+	static constexpr size_t slots_per_thread = 8;
+
+	struct alignas(64) thread_record {
+		std::atomic<bool>		 in_use {false};
+		thread_record*			 next = nullptr;
+		std::atomic<const void*> slots[slots_per_thread] {};
+	};
+
+	using slot_type = std::atomic<const void*>;
+
+private:
+	struct retired_node {
+		void* ptr;
+		void (*reclaim)(void*);
+		retired_node* next;
+	};
+
+	struct thread_state {
+		thread_record* record	 = nullptr;
+		unsigned	   used_mask = 0;
+
+		~thread_state() {
+			if (record) {
+				registry.release(record);
+			}
+		}
+	};
+
+	static constexpr unsigned all_slots_used = (1u << slots_per_thread) - 1;
+
+	// Defined below the class, the nested types have to be complete first
+	static thread_registry<thread_record> registry;
+	static std::mutex					  retired_mutex;
+	static retired_node*				  retired_head;
+	static std::atomic<size_t>			  retired_count;
+
+	static thread_local thread_state local_state;
+
+public:
+	hazard_domain() = delete;
+
+	/**
+	 * @brief Takes a free slot of the calling thread.
+	 * @return nullptr when every slot is busy or the thread record could not be allocated.
+	 */
+	static slot_type* acquire_slot() noexcept {
+		thread_state& state = local_state;
+		if (!state.record) {
+			try {
+				state.record = registry.acquire();
+			} catch (const std::bad_alloc&) {
+				return nullptr;
+			}
+		}
+		if (state.used_mask == all_slots_used) {
+			return nullptr;
+		}
+		unsigned index = std::countr_one(state.used_mask);
+		state.used_mask |= 1u << index;
+		return &state.record->slots[index];
+	}
+
+	/**
+	 * @brief Clears a slot taken by acquire_slot() on this thread and frees what it held back.
+	 *
+	 * The clear is a plain release store, so an owner retiring concurrently may still see the
+	 * old value. Such a hub stays on the list until the next release_slot() or reclaim().
+	 */
+	static void release_slot(slot_type* slot) noexcept {
+		slot->store(nullptr, std::memory_order_release);
+		thread_state& state = local_state;
+		state.used_mask &= ~(1u << (slot - state.record->slots));
+		if (retired_count.load(std::memory_order_relaxed) != 0) {
+			reclaim();
+		}
+	}
+
+	[[nodiscard]] static bool is_protected(const void* ptr) noexcept {
+		if (registry.size() == 0) {
+			return false;
+		}
+		bool found = false;
+		registry.for_each([&](const thread_record& record) {
+			for (const slot_type& slot : record.slots) {
+				found |= slot.load(std::memory_order_seq_cst) == ptr;
+			}
+		});
+		return found;
+	}
+
+	/**
+	 * @brief Defers reclaim(ptr) until no slot holds ptr anymore.
+	 *
+	 * Falls back to reclaiming right away if the list node cannot be allocated, which is only
+	 * unsafe while a reader is actually inside the protected section.
+	 */
+	static void retire(void* ptr, void (*reclaim_func)(void*)) noexcept {
+		auto* node = new (std::nothrow) retired_node {ptr, reclaim_func, nullptr};
+		if (!node) {
+			reclaim_func(ptr);
+			return;
+		}
+		{
+			std::lock_guard lock(retired_mutex);
+			node->next	 = retired_head;
+			retired_head = node;
+		}
+		retired_count.fetch_add(1, std::memory_order_seq_cst);
+		reclaim();
+	}
+
+	/**
+	 * @brief Frees every retired pointer that is no longer published in any slot.
+	 * @return How many pointers were freed.
+	 */
+	static size_t reclaim() noexcept {
+		retired_node* ready = nullptr;
+		{
+			// Scans are serialized, so a scan that starts after a slot was cleared sees it clear
+			std::lock_guard lock(retired_mutex);
+			retired_node** link = &retired_head;
+			while (*link) {
+				retired_node* node = *link;
+				if (is_protected(node->ptr)) {
+					link = &node->next;
+					continue;
+				}
+				*link	   = node->next;
+				node->next = ready;
+				ready	   = node;
+			}
+		}
+
+		// Reclaiming may release other hubs and retire them, so it runs outside the lock
+		size_t freed = 0;
+		while (ready) {
+			retired_node* next = ready->next;
+			ready->reclaim(ready->ptr);
+			delete ready;
+			ready = next;
+			++freed;
+		}
+		retired_count.fetch_sub(freed, std::memory_order_relaxed);
+		return freed;
+	}
+
+	[[nodiscard]] static size_t retired_size() noexcept {
+		return retired_count.load(std::memory_order_relaxed);
+	}
+};
+
+inline thread_registry<hazard_domain::thread_record> hazard_domain::registry;
+inline std::mutex									 hazard_domain::retired_mutex;
+inline hazard_domain::retired_node*					 hazard_domain::retired_head = nullptr;
+inline std::atomic<size_t>							 hazard_domain::retired_count {0};
+inline thread_local hazard_domain::thread_state		 hazard_domain::local_state;
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_HAZARD_DOMAIN_H
@@ -0,0 +1,130 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_HAZARD_POINTER_H
+#define SMARTPOINTERS_HAZARD_POINTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "fwd.h"
+#include "hazard_domain.h"
+#include "hub.h"
+
+namespace raw {
+/**
+ * @brief Keeps the object a weak_ptr observes alive without touching its reference counts.
+ *
+ * Created by weak_ptr::protect(). Publishing costs one store and one fence, and releasing one
+ * store, against two RMWs on a shared cache line for lock(). If the last owner goes away while
+ * the guard is alive, destruction is deferred until the guard is released (or, if the release
+ * raced with the owner, until the next guard release or hazard_domain::reclaim()).
+ *
+ * A guard belongs to the thread that created it and must be released on that thread. Each
+ * thread has hazard_domain::slots_per_thread slots; once they are all taken, further guards
+ * fall back to holding an ordinary strong reference.
+ */
+template<typename T>
+class hazard_guard {
+public:
+	using element_type = std::remove_extent_t<T>;
+
+private:
+	element_type*				ptr	 = nullptr;
+	hazard_domain::slot_type*	slot = nullptr;
+	// Strong reference taken instead of a slot when none was free
+	hub* owned_hub = nullptr;
+
+public:
+	constexpr hazard_guard() noexcept = default;
+
+	hazard_guard(element_type* p, hub* hub_ptr) noexcept {
+		if (!hub_ptr) {
+			return;
+		}
+		slot = hazard_domain::acquire_slot();
+		if (!slot) {
+			if (hub_ptr->try_increment_use_count_if_not_zero()) {
+				ptr		  = p;
+				owned_hub = hub_ptr;
+			}
+			return;
+		}
+		// Once per hub, so hubs that never had a guard skip the slot scan on their last release
+		if (!hub_ptr->hazard_protected.load(std::memory_order_relaxed)) {
+			hub_ptr->hazard_protected.store(true, std::memory_order_relaxed);
+		}
+		slot->store(hub_ptr, std::memory_order_relaxed);
+		// With plain counters everything stays on one thread and program order is enough
+		if constexpr (hub::thread_policy::is_thread_safe) {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+		if (hub_ptr->get_use_count() == 0) {
+			hazard_domain::release_slot(slot);
+			slot = nullptr;
+			return;
+		}
+		ptr = p;
+	}
+
+	hazard_guard(const hazard_guard&)			 = delete;
+	hazard_guard& operator=(const hazard_guard&) = delete;
+
+	hazard_guard(hazard_guard&& other) noexcept
+		: ptr(std::exchange(other.ptr, nullptr)),
+		  slot(std::exchange(other.slot, nullptr)),
+		  owned_hub(std::exchange(other.owned_hub, nullptr)) {}
+
+	hazard_guard& operator=(hazard_guard&& other) noexcept {
+		if (this != &other) {
+			reset();
+			ptr		  = std::exchange(other.ptr, nullptr);
+			slot	  = std::exchange(other.slot, nullptr);
+			owned_hub = std::exchange(other.owned_hub, nullptr);
+		}
+		return *this;
+	}
+
+	~hazard_guard() noexcept {
+		reset();
+	}
+
+	inline void reset() noexcept {
+		if (slot) {
+			hazard_domain::release_slot(slot);
+			slot = nullptr;
+		}
+		if (owned_hub) {
+			owned_hub->decrement_use_count();
+			owned_hub = nullptr;
+		}
+		ptr = nullptr;
+	}
+
+	inline element_type* get() const noexcept {
+		return ptr;
+	}
+
+	inline explicit operator bool() const noexcept {
+		return ptr != nullptr;
+	}
+
+	inline element_type& operator*() const noexcept {
+		return *ptr;
+	}
+
+	inline element_type* operator->() const noexcept {
+		return ptr;
+	}
+
+	inline element_type& operator[](size_t index) const noexcept {
+		return ptr[index];
+	}
+};
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_HAZARD_POINTER_H
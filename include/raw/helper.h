@@ -6,12 +6,19 @@
 #define SMARTPOINTERS_HELPER_H
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <exception>
+#include <source_location>
+#include <type_traits>
 #include <utility>
 
+#include "cycle_collector.h"
+#include "enable_shared_from_this.h"
 #include "fwd.h"
 #include "hub.h"
+#include "op_recorder.h"
+#include "parallel.h"
 
 // Struct to emulate shared_ptr's internal structure
 template<typename T>
@@ -49,6 +56,34 @@ static void destroy_make_shared_array(void* obj_ptr, size_t size) {
 	}
 }
 
+// Largest thread-count hint a make_shared array keeps for its destruction, larger ones are
+// clamped to it
+inline constexpr size_t max_destroy_threads = 64;
+
+// Same as destroy_make_shared_array, split across Threads threads (0 for every hardware thread)
+template<typename T, size_t Threads>
+static void destroy_make_shared_array_parallel(void* obj_ptr, size_t size) {
+	using element_type = std::remove_extent_t<T>;
+	parallel(Threads).destroy(static_cast<element_type*>(obj_ptr), size);
+}
+
+// The hub has no room for the hint, so it is kept in the choice of destroyer
+template<typename T, size_t... Threads>
+constexpr auto parallel_array_destroyers(std::index_sequence<Threads...>) noexcept {
+	return std::array<void (*)(void*, size_t), sizeof...(Threads)> {
+		&destroy_make_shared_array_parallel<T, Threads>...};
+}
+
+template<typename T>
+static auto array_destroyer(const parallel& policy) noexcept -> void (*)(void*, size_t) {
+	static constexpr auto destroyers =
+		parallel_array_destroyers<T>(std::make_index_sequence<max_destroy_threads + 1>());
+	if (policy.threads == 1) {
+		return &destroy_make_shared_array<T>;
+	}
+	return destroyers[std::min(policy.threads, max_destroy_threads)];
+}
+
 static void deallocate_hub_for_new_single(void* hub_ptr, void*) {
 	delete static_cast<hub*>(hub_ptr);
 }
@@ -71,6 +106,29 @@ std::enable_if_t<std::is_array_v<T>, raw::unique_ptr<T>> make_unique(size_t size
 	return raw::unique_ptr<T>(new element_type[size]());
 }
 
+/**
+ * @brief Creates a unique_ptr that manages a static array, zeroed across threads.
+ *
+ * delete[] destroys the elements one by one and only works on storage from new[], so only
+ * trivial element types are value-initialized in parallel; others are built as by
+ * make_unique<T[]>(size). Use make_shared<T[]>(policy, size) to parallelize those.
+ * @param policy how many threads to use, see raw::parallel.
+ * @param size size of the array.
+ */
+template<typename T>
+std::enable_if_t<std::is_array_v<T>, raw::unique_ptr<T>> make_unique(const parallel& policy,
+																	 size_t			 size) {
+	using element_type = std::remove_extent_t<T>;
+	if constexpr (std::is_trivial_v<element_type>) {
+		// Default-initializing trivial elements does nothing, the zeroing is what takes time
+		raw::unique_ptr<T> array(new element_type[size]);
+		policy.value_construct(array.get(), size);
+		return array;
+	} else {
+		return make_unique<T>(size);
+	}
+}
+
 template<typename T, typename... Args>
 /**
  * @brief Creates a unique_ptr that manages a single object.
@@ -82,13 +140,25 @@ std::enable_if_t<!std::is_array_v<T>, raw::unique_ptr<T>> make_unique(Args&&...
 
 template<typename T, typename... Args>
 /**
- * @brief Creates a shared_ptr that manages a single object.
+ * @brief Creates a shared_ptr that manages a single object, recording where it was made.
+ *
+ * Same as make_shared<T>(args...), which cannot take a defaulted call site after its parameter
+ * pack. Call it as make_shared_at<T>(std::source_location::current(), args...) where the leak
+ * tracker should tell the allocation sites apart.
+ * @param site call site, recorded if the leak tracker samples the new hub.
  * @param args Constructor arguments for the new object.
  */
-std::enable_if_t<!std::is_array_v<T>, raw::shared_ptr<T>> make_shared(Args&&... args) {
+std::enable_if_t<!std::is_array_v<T>, raw::shared_ptr<T>> make_shared_at(std::source_location site,
+																		 Args&&... args) {
+	// Same layout as combined<T>, but offsetof is only conditionally supported on types that
+	// are not standard-layout, such as those deriving from enable_shared_from_this
+	constexpr size_t object_offset = (sizeof(hub) + alignof(T) - 1) / alignof(T) * alignof(T);
+	constexpr size_t block_align   = std::max(alignof(hub), alignof(T));
+	constexpr size_t block_size =
+		(object_offset + sizeof(T) + block_align - 1) / block_align * block_align;
+
 	// Allocate a block of memory that can hold both the object and the hub
-	std::byte* raw_block =
-		static_cast<std::byte*>(std::aligned_alloc(alignof(combined<T>), sizeof(combined<T>)));
+	std::byte* raw_block = static_cast<std::byte*>(std::aligned_alloc(block_align, block_size));
 	if (!raw_block) {
 		throw std::bad_alloc();
 	}
@@ -96,12 +166,12 @@ std::enable_if_t<!std::is_array_v<T>, raw::shared_ptr<T>> make_shared(Args&&...
 	hub* constructed_hub = nullptr;
 	try {
 		// Try constructing the object and the hub in the allocated memory with proper alignment
-		constructed_hub = new (raw_block + offsetof(combined<T>, hub_ptr))
-			hub(constructed_ptr, raw_block, &destroy_make_shared_object<T>,
-				deallocate_make_shared_block);
-		constructed_ptr =
-			new (raw_block + offsetof(combined<T>, ptr)) T(std::forward<Args>(args)...);
+		constructed_hub = new (raw_block) hub(constructed_ptr, raw_block,
+											  &destroy_make_shared_object<T>,
+											  deallocate_make_shared_block);
+		constructed_ptr = new (raw_block + object_offset) T(std::forward<Args>(args)...);
 		constructed_hub->set_managed_object_ptr(constructed_ptr);
+		hook_shared_from_this(constructed_ptr, constructed_hub);
 	} catch (const std::exception& e) {
 		// If construction fails, clean up constructed object and then free the memory
 		if (constructed_ptr != nullptr) {
@@ -111,15 +181,40 @@ std::enable_if_t<!std::is_array_v<T>, raw::shared_ptr<T>> make_shared(Args&&...
 		throw;
 	}
 
+	RAW_RECORD_OP(shared_make, constructed_hub);
+	RAW_TRACK_LIVE(constructed_hub, T, block_size, site);
+	RAW_COUNT_TYPE(T, shared_created);
+	RAW_STAMP_HUB(constructed_hub, T);
+	RAW_TRACE_EDGES(constructed_hub, T);
 	return shared_ptr<T>(constructed_ptr, constructed_hub);
 }
 
+template<typename T, typename... Args>
 /**
- * @brief Creates a shared_ptr that manages a static array.
+ * @brief Creates a shared_ptr that manages a single object.
+ *
+ * The leak tracker reports these hubs by type only, see make_shared_at.
+ * @param args Constructor arguments for the new object.
+ */
+std::enable_if_t<!std::is_array_v<T>, raw::shared_ptr<T>> make_shared(Args&&... args) {
+	return make_shared_at<T>(std::source_location(), std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Creates a shared_ptr that manages a static array, built and destroyed across threads.
+ *
+ * If an element constructor throws, the elements built so far are destroyed and the memory
+ * freed before the exception propagates. The elements are destroyed with the same hint, on
+ * whichever thread releases the last owner; hints above max_destroy_threads destroy across
+ * max_destroy_threads threads.
+ * @param policy how many threads to use, see raw::parallel.
  * @param size size of the array.
+ * @param site call site, recorded if the leak tracker samples the new hub.
  */
 template<typename T>
-std::enable_if_t<std::is_array_v<T>, raw::shared_ptr<T>> make_shared(size_t size) {
+std::enable_if_t<std::is_array_v<T>, raw::shared_ptr<T>> make_shared(
+	const parallel& policy, size_t size,
+	std::source_location site = std::source_location::current()) {
 	using element_type = std::remove_extent_t<T>;
 
 	size_t hub_align		 = alignof(raw::hub);
@@ -139,23 +234,26 @@ std::enable_if_t<std::is_array_v<T>, raw::shared_ptr<T>> make_shared(size_t size
 		throw std::bad_alloc();
 	}
 
+	void (*destroyer)(void*, size_t) = array_destroyer<element_type>(policy);
+
 	element_type* constructed_ptr = nullptr;
 	raw::hub*	  constructed_hub = nullptr;
 
 	try {
-		constructed_hub =
-			new (raw_block) raw::hub(nullptr, raw_block, &destroy_make_shared_array<element_type>,
-									 &deallocate_make_shared_block, size);
+		constructed_hub = new (raw_block)
+			raw::hub(nullptr, raw_block, destroyer, &deallocate_make_shared_block, size);
 
-		constructed_ptr = new (raw_block + data_offset) element_type[size]();
+		// Destroys the elements it built again if one of the constructors throws
+		constructed_ptr = reinterpret_cast<element_type*>(raw_block + data_offset);
+		policy.value_construct(constructed_ptr, size);
 		constructed_hub->set_managed_object_ptr(constructed_ptr);
+#ifdef RAW_DEFERRED_RECLAIM
+		if constexpr (!std::is_trivially_destructible_v<element_type>) {
+			constructed_hub->element_size = sizeof(element_type);
+		}
+#endif
 
 	} catch (...) {
-		if (constructed_ptr != nullptr) {
-			for (size_t i = 0; i < size; ++i) {
-				constructed_ptr[i].~element_type();
-			}
-		}
 		if (constructed_hub != nullptr) {
 			constructed_hub->~hub();
 		}
@@ -163,9 +261,24 @@ std::enable_if_t<std::is_array_v<T>, raw::shared_ptr<T>> make_shared(size_t size
 		throw;
 	}
 
+	RAW_RECORD_OP(shared_make, constructed_hub);
+	RAW_TRACK_LIVE(constructed_hub, element_type, aligned_total_block_size, site);
+	RAW_COUNT_TYPE(T, shared_created);
+	RAW_STAMP_HUB(constructed_hub, T);
 	return raw::shared_ptr<T>(constructed_ptr, constructed_hub);
 }
 
+/**
+ * @brief Creates a shared_ptr that manages a static array.
+ * @param size size of the array.
+ * @param site call site, recorded if the leak tracker samples the new hub.
+ */
+template<typename T>
+std::enable_if_t<std::is_array_v<T>, raw::shared_ptr<T>> make_shared(
+	size_t size, std::source_location site = std::source_location::current()) {
+	return make_shared<T>(parallel(1), size, site);
+}
+
 } // namespace raw
 
 #endif // SMARTPOINTERS_HELPER_H
\ No newline at end of file
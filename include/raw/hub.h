@@ -7,22 +7,27 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <memory>
 #include <stdexcept>
 
+#include "diagnostics.h"
 #include "fwd.h"
+#include "hazard_domain.h"
+#include "reclaim_queue.h"
+#include "teardown.h"
+#include "thread_policy.h"
+#include "type_stats.h"
 
 namespace raw {
 class hub {
 public:
-#ifdef RAW_MULTI_THREADED
-	std::atomic<size_t> use_count;
-	std::atomic<size_t> weak_count;
-#else
-	size_t use_count;
-	size_t weak_count;
-#endif
+	using thread_policy = default_thread_policy;
+
+	thread_policy::counter_type use_count;
+	// Weak observers plus one reference shared by all owners, so only one side ever frees
+	thread_policy::counter_type weak_count;
 
 	void*	   managed_object_ptr;
 	std::byte* allocated_base_block;
@@ -32,11 +37,51 @@ public:
 
 	size_t obj_size;
 
+	// Set by the first hazard_guard on this hub, only such hubs make their last owner scan the
+	// hazard slots
+	std::atomic<bool> hazard_protected {false};
+
+#ifdef RAW_LEAK_TRACKER
+	// Set while the live registry lists this hub
+	diagnostics::live_entry* sampled_entry = nullptr;
+#endif
+#ifdef RAW_TYPE_STATS
+	// Set by RAW_STAMP_HUB, counts the object's lifetime for its type once it is destroyed
+	void (*count_destroy)(uint64_t lifetime_ns) = nullptr;
+	// steady_clock time the object was created at
+	uint64_t created_ns = 0;
+#endif
+#ifdef RAW_DEFERRED_RECLAIM
+	// Set by defer_reclamation(), the last owner then queues the hub instead of releasing it
+	std::atomic<bool> reclaim_deferred {false};
+	hub*			  next_deferred = nullptr;
+	// Non-zero for make_shared arrays, which deferred_deleter then destroys a slice at a time
+	size_t element_size		  = 0;
+	size_t reclaimed_elements = 0;
+
+	// Hubs whose last owner is gone, released by deferred_deleter
+	static reclaim_queue<hub, &hub::next_deferred> deferred_queue;
+#endif
+#ifdef RAW_CYCLE_COLLECTOR
+	// Set by RAW_TRACE_EDGES for objects with a trace() member, which lists their edges
+	void (*trace_edges)(void* object, cycle_tracer& tracer) noexcept = nullptr;
+	// Links the hub into cycle_candidates
+	hub* next_candidate = nullptr;
+	// Scratch of the cycle_collector pass in progress
+	size_t	cycle_count = 0;
+	uint8_t cycle_color = 0;
+	// Set while the hub is a candidate root, the buffer then holds a weak reference on it
+	std::atomic<bool> cycle_buffered {false};
+
+	// Possible roots of garbage cycles, examined by cycle_collector
+	static reclaim_queue<hub, &hub::next_candidate> cycle_candidates;
+#endif
+
 	// Конструктор hub'а
 	hub(void* obj_ptr, std::byte*				  base_block, void (*destroyer)(void*, size_t),
 		void (*deallocator)(void*, void*), size_t size = 0) noexcept
 		: use_count(1),
-		  weak_count(0),
+		  weak_count(1),
 		  managed_object_ptr(obj_ptr),
 		  allocated_base_block(base_block),
 		  destroy_obj_func(destroyer),
@@ -45,67 +90,114 @@ public:
 	~hub() = default;
 
 	inline void increment_use_count() noexcept {
-#ifdef RAW_MULTI_THREADED
-		use_count.fetch_add(1, std::memory_order_relaxed);
-#else
-		use_count++;
-#endif
+		RAW_PROFILE_REFCOUNT(this, 0);
+		thread_policy::increment(use_count);
 	}
 	inline void decrement_use_count() noexcept {
-#ifdef RAW_MULTI_THREADED
-		if (use_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-#else
-		if (--use_count == 0) {
+		// Before the decrement, the last one frees the profiler's entry
+		RAW_PROFILE_REFCOUNT(this, 0);
+#ifdef RAW_CYCLE_COLLECTOR
+		if (trace_edges && !cycle_buffered.load(std::memory_order_relaxed)) {
+			decrement_possible_root();
+			return;
+		}
 #endif
-			if (destroy_obj_func) {
-				destroy_obj_func(managed_object_ptr, obj_size);
-				managed_object_ptr = nullptr;
-			}
-#ifdef RAW_MULTI_THREADED
-			if (weak_count.load(std::memory_order_acquire) == 0) {
-#else
-			if (weak_count == 0) {
+		if (thread_policy::decrement(use_count)) {
+			release_last_owner();
+		}
+	}
+
+#ifdef RAW_CYCLE_COLLECTOR
+	// A decrement that leaves the object alive may have cut a cycle loose, so the hub becomes a
+	// candidate root. The weak reference taken first keeps it valid if another owner releases
+	// it meanwhile, and passes to the buffer.
+	inline void decrement_possible_root() noexcept {
+		increment_weak_count();
+		if (thread_policy::decrement(use_count)) {
+			release_last_owner();
+		} else if (!cycle_buffered.exchange(true, std::memory_order_acq_rel)) {
+			cycle_candidates.push(this);
+			return;
+		}
+		decrement_weak_count();
+	}
 #endif
-				if (deallocate_mem_func) {
-					deallocate_mem_func(this, allocated_base_block);
-				}
-			}
+
+	inline void release_last_owner() noexcept {
+		// A hazard_guard still reads the object, the guard that lets go of it finishes up. Its
+		// flag store comes before its fence, so it is seen here whenever the guard saw the
+		// object alive (same argument as for the slot itself).
+		if (hazard_protected.load(std::memory_order_seq_cst) && hazard_domain::is_protected(this)) {
+			hazard_domain::retire(this, &hub::release_retired);
+			return;
 		}
+		release_object();
 	}
 
-	inline bool try_increment_use_count_if_not_zero() {
-#ifdef RAW_MULTI_THREADED
-		size_t current_count = use_count.load(std::memory_order_relaxed);
-		while (current_count > 0) {
-			if (use_count.compare_exchange_weak(current_count, current_count + 1,
-												std::memory_order_acquire,
-												std::memory_order_relaxed)) {
-				return true;
-			}
+	// Destroys the object and drops the reference the owners held on the hub, queued behind the
+	// release in progress on this thread with RAW_ITERATIVE_TEARDOWN
+	inline void release_object() noexcept {
+#ifdef RAW_DEFERRED_RECLAIM
+		// The use count ordered this after every defer_reclamation() of a former owner
+		if (reclaim_deferred.load(std::memory_order_relaxed)) {
+			deferred_queue.push(this);
+			return;
 		}
-#else
-		if (use_count > 0) {
-			use_count++;
-			return true;
+#endif
+		teardown::run<&hub::release_queued>(this);
+	}
+
+	// Releases a hub the deferred queue held
+	static inline void release_deferred(hub* deferred) noexcept {
+		teardown::run<&hub::release_queued>(deferred);
+	}
+
+	static inline void release_queued(void* queued) noexcept {
+		static_cast<hub*>(queued)->release_now();
+	}
+
+	inline void release_now() noexcept {
+#ifdef RAW_LEAK_TRACKER
+		if (sampled_entry) {
+			diagnostics::live_registry::untrack(sampled_entry);
+			sampled_entry = nullptr;
+		}
+#endif
+#ifdef RAW_TYPE_STATS
+		if (count_destroy) {
+			count_destroy(stats_clock_ns() - created_ns);
 		}
 #endif
-		return false;
+		if (destroy_obj_func) {
+			destroy_obj_func(managed_object_ptr, obj_size);
+			managed_object_ptr = nullptr;
+		}
+		decrement_weak_count();
 	}
 
-	inline void increment_weak_count() noexcept {
-#ifdef RAW_MULTI_THREADED
-		weak_count.fetch_add(1, std::memory_order_relaxed);
+	static inline void release_retired(void* retired) noexcept {
+		static_cast<hub*>(retired)->release_object();
+	}
+
+	inline bool try_increment_use_count_if_not_zero() {
+#ifdef RAW_PROFILE_CONTENTION
+		size_t retries = 0;
+		bool   locked  = thread_policy::try_increment_if_not_zero(use_count, retries);
+		// A failed lock may race with the last release freeing the entry, only count successes
+		if (locked) {
+			RAW_PROFILE_REFCOUNT(this, retries);
+		}
+		return locked;
 #else
-		weak_count++;
+		return thread_policy::try_increment_if_not_zero(use_count);
 #endif
 	}
+
+	inline void increment_weak_count() noexcept {
+		thread_policy::increment(weak_count);
+	}
 	inline void decrement_weak_count() noexcept {
-#ifdef RAW_MULTI_THREADED
-		if (weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
-			use_count.load(std::memory_order_acquire) == 0) {
-#else
-		if (--weak_count == 0 && use_count == 0) {
-#endif
+		if (thread_policy::decrement(weak_count)) {
 			if (deallocate_mem_func) {
 				deallocate_mem_func(this, allocated_base_block);
 			}
@@ -117,14 +209,17 @@ public:
 	}
 
 	inline size_t get_use_count() const noexcept {
-#ifdef RAW_MULTI_THREADED
-		return use_count.load(std::memory_order_acquire);
-#else
-		return use_count;
-#endif
+		return thread_policy::load(use_count);
 	}
 };
 
+#ifdef RAW_DEFERRED_RECLAIM
+inline reclaim_queue<hub, &hub::next_deferred> hub::deferred_queue;
+#endif
+#ifdef RAW_CYCLE_COLLECTOR
+inline reclaim_queue<hub, &hub::next_candidate> hub::cycle_candidates;
+#endif
+
 } // namespace raw
 
 #endif // SMARTPOINTERS_HUB_H
@@ -0,0 +1,156 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_INTRUSIVE_PTR_H
+#define SMARTPOINTERS_INTRUSIVE_PTR_H
+
+#include <utility>
+
+#include "fwd.h"
+#include "smart_ptr_base.h"
+#include "teardown.h"
+#include "thread_policy.h"
+
+namespace raw {
+/**
+ * @brief Base class that embeds the reference count in the object itself.
+ *
+ * intrusive_ptr finds the counter through the intrusive_ptr_add_ref / intrusive_ptr_release
+ * friends below (via ADL), so any type providing those two functions can be used as well.
+ */
+template<typename T, typename ThreadPolicy = default_thread_policy>
+class intrusive_ref_counter {
+private:
+	mutable typename ThreadPolicy::counter_type ref_count;
+
+	static void delete_counted(void* object) noexcept {
+		delete static_cast<T*>(object);
+	}
+
+protected:
+	intrusive_ref_counter() noexcept : ref_count(0) {}
+
+	// A copy is a new object, it starts without owners
+	intrusive_ref_counter(const intrusive_ref_counter&) noexcept : ref_count(0) {}
+
+	intrusive_ref_counter& operator=(const intrusive_ref_counter&) noexcept {
+		return *this;
+	}
+
+	~intrusive_ref_counter() = default;
+
+public:
+	[[nodiscard]] inline size_t use_count() const noexcept {
+		return ThreadPolicy::load(ref_count);
+	}
+
+	friend inline void intrusive_ptr_add_ref(const intrusive_ref_counter* counter) noexcept {
+		ThreadPolicy::increment(counter->ref_count);
+	}
+
+	// False positive in GCC 12+ once teardown::run is inlined: with two owners destroyed in a
+	// row, it follows the path where the first decrement deleted the object into the second
+	// owner's decrement, although the first owner's decrement cannot be the last one
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuse-after-free"
+#endif
+	friend inline void intrusive_ptr_release(const intrusive_ref_counter* counter) noexcept {
+		if (ThreadPolicy::decrement(counter->ref_count)) {
+			teardown::run<&intrusive_ref_counter::delete_counted>(
+				const_cast<T*>(static_cast<const T*>(counter)));
+		}
+	}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#pragma GCC diagnostic pop
+#endif
+};
+
+/**
+ * @brief Shared ownership through a count stored inside the pointee, one pointer wide.
+ */
+template<typename T>
+class intrusive_ptr : public smart_ptr_base<T> {
+public:
+	constexpr intrusive_ptr() noexcept = default;
+
+	intrusive_ptr(std::nullptr_t) noexcept : smart_ptr_base<T>(nullptr) {}
+
+	/**
+	 * @brief Takes a reference to p.
+	 * @param add_ref pass false to adopt a reference the caller already owns (see detach()).
+	 */
+	explicit intrusive_ptr(T* p, bool add_ref = true) noexcept : smart_ptr_base<T>(p) {
+		if (this->ptr && add_ref) {
+			intrusive_ptr_add_ref(this->ptr);
+		}
+	}
+
+	intrusive_ptr(const intrusive_ptr& other) noexcept : smart_ptr_base<T>(other.ptr) {
+		if (this->ptr) {
+			intrusive_ptr_add_ref(this->ptr);
+		}
+	}
+
+	intrusive_ptr(intrusive_ptr&& other) noexcept : smart_ptr_base<T>(other.ptr) {
+		other.ptr = nullptr;
+	}
+
+	intrusive_ptr& operator=(const intrusive_ptr& other) noexcept {
+		// Add before release so self-assignment never drops the last reference
+		intrusive_ptr temp(other);
+		swap(temp);
+		return *this;
+	}
+
+	intrusive_ptr& operator=(intrusive_ptr&& other) noexcept {
+		intrusive_ptr temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	intrusive_ptr& operator=(std::nullptr_t) noexcept {
+		reset();
+		return *this;
+	}
+
+	~intrusive_ptr() noexcept {
+		if (this->ptr) {
+			intrusive_ptr_release(this->ptr);
+		}
+	}
+
+	inline void reset(T* p = nullptr) noexcept {
+		intrusive_ptr temp(p);
+		swap(temp);
+	}
+
+	// Gives up ownership without releasing the reference
+	inline T* detach() noexcept {
+		T* temp	  = this->ptr;
+		this->ptr = nullptr;
+		return temp;
+	}
+
+	inline void swap(intrusive_ptr& other) noexcept {
+		std::swap(this->ptr, other.ptr);
+	}
+
+	[[nodiscard]] inline size_t use_count() const noexcept {
+		return this->ptr ? this->ptr->use_count() : 0;
+	}
+};
+
+/**
+ * @brief Creates an intrusive_ptr that manages a single object.
+ * @param args Constructor arguments for the new object.
+ */
+template<typename T, typename... Args>
+intrusive_ptr<T> make_intrusive(Args&&... args) {
+	return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_INTRUSIVE_PTR_H
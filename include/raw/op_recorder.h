@@ -0,0 +1,178 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_OP_RECORDER_H
+#define SMARTPOINTERS_OP_RECORDER_H
+
+#include <cstdint>
+
+#ifdef RAW_RECORD_OPS
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <mutex>
+
+#include "event_log.h"
+#endif
+
+namespace raw {
+/**
+ * @brief What a recorded event did to the pointer that logged it.
+ *
+ * _destroy means one handle let go of its reference (destructor, reset, assignment over it),
+ * not that the object died. Locks that fail are logged too, they cost about as much.
+ */
+enum class recorded_op : uint8_t {
+	shared_make,
+	shared_copy,
+	shared_move,
+	shared_destroy,
+	weak_copy,
+	weak_move,
+	weak_destroy,
+	weak_lock,
+	weak_lock_failed,
+	unique_make,
+	unique_move,
+	unique_destroy,
+	// unique_ptr::release(), the object leaves unique ownership without being deleted
+	unique_release,
+	count
+};
+
+// One event as written to the recording, in host byte order
+struct recorded_event {
+	// steady_clock nanoseconds
+	uint64_t timestamp_ns;
+	// Address of the hub for shared_/weak_ events, of the owned object for unique_ ones
+	uint64_t	id;
+	uint32_t	thread_id;
+	recorded_op op;
+	uint8_t		reserved[3];
+};
+
+static_assert(sizeof(recorded_event) == 24, "recorded_event is written to recordings as is");
+
+// A recording is this header followed by recorded_events, ordered per thread but not globally
+struct recording_header {
+	char	 magic[8];
+	uint32_t version;
+	uint32_t event_size;
+};
+
+inline constexpr char	  recording_magic[8] = {'R', 'A', 'W', 'O', 'P', 'R', 'E', 'C'};
+inline constexpr uint32_t recording_version	 = 1;
+
+#ifdef RAW_RECORD_OPS
+
+/**
+ * @brief Logs every raw::shared_ptr, weak_ptr and unique_ptr operation while a session runs.
+ *
+ * Events go through an event_log: each thread appends to its own ring and a background thread
+ * writes them to the file. Nothing is ever blocked on the file, a thread whose ring is full drops
+ * the event and counts it in dropped_events().
+ *
+ * Compiled in with RAW_RECORD_OPS only. Without a session (start() or RAW_RECORD_OPS_FILE in
+ * the environment) every hook costs one relaxed load.
+ */
+class op_recorder {
+public:
+	using log = event_log<recorded_event, size_t(1) << 16>;
+
+private:
+	// Guarded by session_mutex, the log's flusher writes to output while a session runs
+	static std::mutex session_mutex;
+	static std::FILE* output;
+
+	static void write_events(const recorded_event* events, size_t count) {
+		std::fwrite(events, sizeof(recorded_event), count, output);
+	}
+
+public:
+	op_recorder() = delete;
+
+	/**
+	 * @brief Opens path and starts recording.
+	 * @return false if a session is already running or the file could not be opened.
+	 */
+	static bool start(const char* path) {
+		std::lock_guard lock(session_mutex);
+		if (output) {
+			return false;
+		}
+		output = std::fopen(path, "wb");
+		if (!output) {
+			return false;
+		}
+		recording_header header {};
+		std::copy(std::begin(recording_magic), std::end(recording_magic), header.magic);
+		header.version	  = recording_version;
+		header.event_size = sizeof(recorded_event);
+		std::fwrite(&header, sizeof(header), 1, output);
+		if (!log::start(&write_events)) {
+			std::fclose(output);
+			output = nullptr;
+			return false;
+		}
+		return true;
+	}
+
+	// Stops recording, writes out what the rings still hold and closes the file
+	static void stop() {
+		std::lock_guard lock(session_mutex);
+		if (!output) {
+			return;
+		}
+		log::stop();
+		std::fclose(output);
+		output = nullptr;
+	}
+
+	[[nodiscard]] static bool active() noexcept {
+		return log::active();
+	}
+
+	// Events lost to full rings in the current (or last) session
+	[[nodiscard]] static uint64_t dropped_events() noexcept {
+		return log::dropped_events();
+	}
+
+	static void record(recorded_op op, const void* id) noexcept {
+		if (id && log::active()) {
+			log::push(recorded_event {0, reinterpret_cast<uintptr_t>(id), 0, op, {}});
+		}
+	}
+};
+
+inline std::mutex op_recorder::session_mutex;
+inline std::FILE* op_recorder::output = nullptr;
+
+// Records the whole run into $RAW_RECORD_OPS_FILE when that is set, no code changes needed
+struct op_recorder_env_session {
+	op_recorder_env_session() {
+		if (const char* path = std::getenv("RAW_RECORD_OPS_FILE")) {
+			op_recorder::start(path);
+		}
+	}
+	~op_recorder_env_session() {
+		op_recorder::stop();
+	}
+};
+
+// Defined after the recorder's own statics, so it is constructed after and destroyed before them
+inline op_recorder_env_session op_recorder_env;
+
+#endif
+
+} // namespace raw
+
+// Hook used by the pointers, compiles to nothing unless RAW_RECORD_OPS is defined
+#ifdef RAW_RECORD_OPS
+#define RAW_RECORD_OP(op, id) ::raw::op_recorder::record(::raw::recorded_op::op, id)
+#else
+#define RAW_RECORD_OP(op, id) ((void)0)
+#endif
+
+#endif // SMARTPOINTERS_OP_RECORDER_H
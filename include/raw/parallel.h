@@ -0,0 +1,128 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_PARALLEL_H
+#define SMARTPOINTERS_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace raw {
+/**
+ * @brief Thread-count hint for the array factories, as in make_shared<T[]>(raw::parallel(8), n).
+ *
+ * The elements are split into one contiguous chunk per thread and the calling thread works on
+ * the first chunk itself. Arrays too small to give every thread min_chunk elements use fewer
+ * threads, down to the caller alone. Element constructors and destructors then run on several
+ * threads at once and in no particular order, so they must not share state that is not
+ * thread-safe, which includes the hubs of single-threaded builds.
+ */
+class parallel {
+public:
+	// Fewer elements than this per thread are not worth starting a thread for
+	static constexpr size_t min_chunk = size_t(1) << 16;
+
+	// 0 uses every hardware thread
+	size_t threads = 0;
+
+	constexpr parallel() noexcept = default;
+	explicit constexpr parallel(size_t thread_count) noexcept : threads(thread_count) {}
+
+	// Threads worth using for size elements, at least one
+	[[nodiscard]] size_t threads_for(size_t size) const noexcept {
+		size_t wanted = threads ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+		return std::clamp<size_t>(size / min_chunk, 1, wanted);
+	}
+
+	/**
+	 * @brief Value-initializes size elements at first across the threads.
+	 *
+	 * If a constructor throws, every element constructed so far is destroyed again before the
+	 * first exception is rethrown on the calling thread.
+	 */
+	template<typename T>
+	void value_construct(T* first, size_t size) const {
+		size_t chunks = threads_for(size);
+		if (chunks == 1) {
+			std::uninitialized_value_construct_n(first, size);
+			return;
+		}
+		std::vector<std::exception_ptr> errors(chunks);
+		run(chunks, size, [first, &errors](size_t chunk, size_t begin, size_t end) noexcept {
+			// Rolls back the chunk's own elements if one of them throws
+			try {
+				std::uninitialized_value_construct(first + begin, first + end);
+			} catch (...) {
+				errors[chunk] = std::current_exception();
+			}
+		});
+
+		auto failed = std::find_if(errors.begin(), errors.end(),
+								   [](const auto& error) { return error != nullptr; });
+		if (failed == errors.end()) {
+			return;
+		}
+		for (size_t chunk = 0; chunk < chunks; ++chunk) {
+			if (!errors[chunk]) {
+				std::destroy(first + chunk_begin(chunk, chunks, size),
+							 first + chunk_begin(chunk + 1, chunks, size));
+			}
+		}
+		std::rethrow_exception(*failed);
+	}
+
+	// Destroys size elements at first across the threads
+	template<typename T>
+	void destroy(T* first, size_t size) const noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			run(threads_for(size), size, [first](size_t, size_t begin, size_t end) noexcept {
+				std::destroy(first + begin, first + end);
+			});
+		}
+	}
+
+private:
+	static size_t chunk_begin(size_t chunk, size_t chunks, size_t size) noexcept {
+		return size / chunks * chunk + std::min(chunk, size % chunks);
+	}
+
+	/**
+	 * @brief Calls body(chunk, begin, end) for every chunk of [0, size) and waits for all of them.
+	 *
+	 * Chunks whose thread cannot be started (out of threads or memory) run on the caller after
+	 * its own, so every chunk runs exactly once.
+	 */
+	template<typename Body>
+	static void run(size_t chunks, size_t size, const Body& body) noexcept {
+		auto run_chunk = [&body, chunks, size](size_t chunk) {
+			body(chunk, chunk_begin(chunk, chunks, size), chunk_begin(chunk + 1, chunks, size));
+		};
+		std::vector<std::thread> workers;
+		size_t					 started = 1;
+		try {
+			workers.reserve(chunks - 1);
+			for (; started < chunks; ++started) {
+				workers.emplace_back(run_chunk, started);
+			}
+		} catch (...) {
+			// Out of threads or memory, the chunks that did not start run below
+		}
+		run_chunk(0);
+		for (size_t chunk = started; chunk < chunks; ++chunk) {
+			run_chunk(chunk);
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+};
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_PARALLEL_H
@@ -0,0 +1,251 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_RCU_PTR_H
+#define SMARTPOINTERS_RCU_PTR_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "fwd.h"
+#include "thread_registry.h"
+#include "unique_ptr.h"
+
+namespace raw {
+/**
+ * @brief Process-wide read-side epochs shared by every rcu_ptr.
+ *
+ * A reader copies the global epoch into its thread record when it enters a read section and
+ * writes 0 when it leaves. A writer that retires a version bumps the global epoch; the version
+ * can be freed once every record is either 0 or already at the bumped epoch, because such
+ * readers started after the new version was published.
+ */
+class rcu_domain {
+public:
+	using epoch_type = uint64_t;
+
+	struct alignas(64) thread_record {
+		std::atomic<bool>		in_use {false};
+		thread_record*			next = nullptr;
+		// 0 while the thread is outside any read section
+		std::atomic<epoch_type> epoch {0};
+	};
+
+private:
+	struct thread_state {
+		thread_record* record  = nullptr;
+		unsigned	   nesting = 0;
+
+		~thread_state() {
+			if (record) {
+				registry.release(record);
+			}
+		}
+	};
+
+	// Defined below the class, the nested types have to be complete first
+	static thread_registry<thread_record> registry;
+	static std::atomic<epoch_type>		  global_epoch;
+
+	static thread_local thread_state local_state;
+
+public:
+	rcu_domain() = delete;
+
+	// Read sections nest, only the outermost one publishes an epoch
+	static void enter() {
+		thread_state& state = local_state;
+		if (state.nesting != 0) {
+			++state.nesting;
+			return;
+		}
+		// May throw, the section only counts once the thread has a record to publish in
+		if (!state.record) {
+			state.record = registry.acquire();
+		}
+		state.nesting = 1;
+		state.record->epoch.store(global_epoch.load(std::memory_order_seq_cst),
+								  std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+	static void exit() noexcept {
+		thread_state& state = local_state;
+		if (--state.nesting == 0) {
+			state.record->epoch.store(0, std::memory_order_release);
+		}
+	}
+
+	/**
+	 * @brief Starts a new epoch, call after unlinking the old version.
+	 * @return The epoch every reader of the old version has to leave behind.
+	 */
+	static epoch_type advance() noexcept {
+		return global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+	}
+
+	// True once no thread is still inside a read section that began before target
+	[[nodiscard]] static bool grace_period_elapsed(epoch_type target) noexcept {
+		bool elapsed = true;
+		registry.for_each([&](const thread_record& record) {
+			epoch_type epoch = record.epoch.load(std::memory_order_seq_cst);
+			elapsed &= epoch == 0 || epoch >= target;
+		});
+		return elapsed;
+	}
+
+	// Blocks until grace_period_elapsed(target), must not be called inside a read section
+	static void wait_for_readers(epoch_type target) noexcept {
+		while (!grace_period_elapsed(target)) {
+			std::this_thread::yield();
+		}
+	}
+};
+
+inline thread_registry<rcu_domain::thread_record> rcu_domain::registry;
+inline std::atomic<rcu_domain::epoch_type>		  rcu_domain::global_epoch {1};
+inline thread_local rcu_domain::thread_state	  rcu_domain::local_state;
+
+/**
+ * @brief Read section over an rcu_ptr, hands out a plain const pointer.
+ *
+ * The version it points to stays alive until the guard is destroyed. The guard is bound to the
+ * thread that created it, so it can be neither copied nor moved.
+ */
+template<typename T>
+class rcu_read_guard {
+private:
+	const T* ptr;
+
+public:
+	explicit rcu_read_guard(const std::atomic<T*>& current) {
+		rcu_domain::enter();
+		ptr = current.load(std::memory_order_acquire);
+	}
+
+	rcu_read_guard(const rcu_read_guard&)			 = delete;
+	rcu_read_guard& operator=(const rcu_read_guard&) = delete;
+
+	~rcu_read_guard() noexcept {
+		rcu_domain::exit();
+	}
+
+	inline const T* get() const noexcept {
+		return ptr;
+	}
+
+	inline explicit operator bool() const noexcept {
+		return ptr != nullptr;
+	}
+
+	inline const T& operator*() const noexcept {
+		return *ptr;
+	}
+
+	inline const T* operator->() const noexcept {
+		return ptr;
+	}
+};
+
+/**
+ * @brief Pointer to read-mostly data where readers pay no atomic RMW at all.
+ *
+ * Readers call read() and get a const view that stays valid for the guard's lifetime. Writers
+ * call publish() with a fresh version; the old one is deleted (through the same path as
+ * raw::unique_ptr) once every reader that could still see it has left its read section.
+ * Writers are serialized against each other, readers never wait.
+ */
+template<typename T>
+class rcu_ptr {
+	static_assert(!std::is_array_v<T>, "raw::rcu_ptr supports single objects only");
+
+private:
+	struct retired_version {
+		T*						 version;
+		rcu_domain::epoch_type safe_epoch;
+	};
+
+	std::atomic<T*>				 current;
+	std::mutex					 writer_mutex;
+	std::vector<retired_version> retired;
+
+	// Deletes every retired version no reader can see anymore, writer_mutex must be held
+	size_t reclaim_locked() {
+		size_t freed = 0;
+		for (size_t i = 0; i < retired.size();) {
+			if (rcu_domain::grace_period_elapsed(retired[i].safe_epoch)) {
+				unique_ptr<T> expired(retired[i].version);
+				retired[i] = retired.back();
+				retired.pop_back();
+				++freed;
+			} else {
+				++i;
+			}
+		}
+		return freed;
+	}
+
+public:
+	rcu_ptr() noexcept : current(nullptr) {}
+
+	explicit rcu_ptr(unique_ptr<T> initial) noexcept : current(initial.release()) {}
+
+	rcu_ptr(const rcu_ptr&)			   = delete;
+	rcu_ptr& operator=(const rcu_ptr&) = delete;
+
+	// No reader may be inside a read section of this pointer anymore
+	~rcu_ptr() noexcept {
+		unique_ptr<T> last(current.load(std::memory_order_relaxed));
+		for (retired_version& entry : retired) {
+			unique_ptr<T> expired(entry.version);
+		}
+	}
+
+	[[nodiscard]] rcu_read_guard<T> read() const {
+		return rcu_read_guard<T>(current);
+	}
+
+	/**
+	 * @brief Makes next the version new readers see and retires the previous one.
+	 *
+	 * Does not wait for readers: versions whose grace period already ended are freed here,
+	 * the rest on a later publish(), reclaim() or synchronize().
+	 */
+	void publish(unique_ptr<T> next) {
+		std::lock_guard lock(writer_mutex);
+		T* previous = current.exchange(next.release(), std::memory_order_seq_cst);
+		if (previous) {
+			retired.push_back({previous, rcu_domain::advance()});
+		}
+		reclaim_locked();
+	}
+
+	// Frees what can be freed without waiting, returns how many versions were deleted
+	size_t reclaim() {
+		std::lock_guard lock(writer_mutex);
+		return reclaim_locked();
+	}
+
+	// Waits for every reader of a retired version and frees them all
+	void synchronize() {
+		std::lock_guard lock(writer_mutex);
+		for (const retired_version& entry : retired) {
+			rcu_domain::wait_for_readers(entry.safe_epoch);
+		}
+		reclaim_locked();
+	}
+
+	[[nodiscard]] size_t retired_size() {
+		std::lock_guard lock(writer_mutex);
+		return retired.size();
+	}
+};
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_RCU_PTR_H
@@ -0,0 +1,57 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_RECLAIM_QUEUE_H
+#define SMARTPOINTERS_RECLAIM_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace raw {
+/**
+ * @brief Lock-free intrusive queue of nodes waiting to be reclaimed.
+ *
+ * Next names the member that links the nodes. Any thread pushes with one compare-exchange; a
+ * consumer takes the whole list with one exchange, so several consumers never see the same
+ * node and there is no ABA problem. Nodes come out in the order they were pushed.
+ */
+template<typename Node, Node* Node::*Next>
+class reclaim_queue {
+private:
+	std::atomic<Node*> head {nullptr};
+
+public:
+	constexpr reclaim_queue() noexcept = default;
+
+	reclaim_queue(const reclaim_queue&)			   = delete;
+	reclaim_queue& operator=(const reclaim_queue&) = delete;
+
+	void push(Node* node) noexcept {
+		node->*Next = head.load(std::memory_order_relaxed);
+		while (!head.compare_exchange_weak(node->*Next, node, std::memory_order_release,
+										   std::memory_order_relaxed)) {
+		}
+	}
+
+	// Detaches everything pushed so far, oldest first
+	[[nodiscard]] Node* take_all() noexcept {
+		Node* newest = head.exchange(nullptr, std::memory_order_acquire);
+		Node* oldest = nullptr;
+		while (newest) {
+			Node* next	  = newest->*Next;
+			newest->*Next = oldest;
+			oldest		  = newest;
+			newest		  = next;
+		}
+		return oldest;
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return head.load(std::memory_order_relaxed) == nullptr;
+	}
+};
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_RECLAIM_QUEUE_H
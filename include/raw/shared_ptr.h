@@ -5,6 +5,8 @@
 #ifndef SMARTPOINTERS_SHARED_PTR_H
 #define SMARTPOINTERS_SHARED_PTR_H
 
+#include <source_location>
+
 #include "helper.h"
 #include "smart_ptr_base.h"
 
@@ -14,6 +16,8 @@ class shared_ptr_base : public smart_ptr_base<T> {
 protected:
 	hub* hub_ptr = nullptr;
 	friend class weak_ptr<T>;
+	friend class atomic_shared_ptr<T>;
+	friend class cycle_tracer;
 
 public:
 	// Inherit constructors
@@ -27,11 +31,18 @@ public:
 	shared_ptr_base(const shared_ptr_base& other) noexcept {
 		this->ptr = other.ptr;
 		hub_ptr	  = other.hub_ptr;
-		if (hub_ptr)
+		RAW_RECORD_OP(shared_copy, hub_ptr);
+		if (hub_ptr) {
+			RAW_COUNT_TYPE(T, copied);
 			hub_ptr->increment_use_count();
+		}
 	}
 
 	shared_ptr_base(shared_ptr_base&& other) noexcept {
+		RAW_RECORD_OP(shared_move, other.hub_ptr);
+		if (other.hub_ptr) {
+			RAW_COUNT_TYPE(T, moved);
+		}
 		this->ptr	  = other.ptr;
 		hub_ptr		  = other.hub_ptr;
 		other.ptr	  = nullptr;
@@ -41,11 +52,15 @@ public:
 	shared_ptr_base& operator=(const shared_ptr_base& other) noexcept {
 		if (this != &other) {
 			if (hub_ptr) {
+				RAW_RECORD_OP(shared_destroy, hub_ptr);
+				RAW_TRACE(shared_release, this->ptr, hub_ptr->get_use_count());
 				hub_ptr->decrement_use_count();
 			}
 			this->ptr = other.ptr;
 			hub_ptr	  = other.hub_ptr;
 			if (hub_ptr) {
+				RAW_RECORD_OP(shared_copy, hub_ptr);
+				RAW_COUNT_TYPE(T, copied);
 				hub_ptr->increment_use_count();
 			}
 		}
@@ -55,8 +70,14 @@ public:
 	shared_ptr_base& operator=(shared_ptr_base&& other) noexcept {
 		if (this != &other) {
 			if (hub_ptr) {
+				RAW_RECORD_OP(shared_destroy, hub_ptr);
+				RAW_TRACE(shared_release, this->ptr, hub_ptr->get_use_count());
 				hub_ptr->decrement_use_count();
 			}
+			RAW_RECORD_OP(shared_move, other.hub_ptr);
+			if (other.hub_ptr) {
+				RAW_COUNT_TYPE(T, moved);
+			}
 			this->ptr	  = other.ptr;
 			hub_ptr		  = other.hub_ptr;
 			other.ptr	  = nullptr;
@@ -78,16 +99,27 @@ public:
 		return use_count() == 1;
 	}
 
+#ifdef RAW_DEFERRED_RECLAIM
+	/**
+	 * @brief Hands the object to deferred_deleter once its last owner is gone.
+	 *
+	 * The owner that drops the last reference only queues the hub; the object is destroyed and
+	 * its memory freed by the reclaimer thread or the next drain_reclamation(). The elements of a
+	 * make_shared array can also be destroyed in slices by raw::reclaim_step().
+	 */
+	inline void defer_reclamation() const noexcept {
+		if (hub_ptr) {
+			hub_ptr->reclaim_deferred.store(true, std::memory_order_relaxed);
+		}
+	}
+#endif
+
 	~shared_ptr_base() noexcept {
 		if (hub_ptr) {
+			RAW_RECORD_OP(shared_destroy, hub_ptr);
+			RAW_TRACE(shared_release, this->ptr, hub_ptr->get_use_count());
 			hub_ptr->decrement_use_count();
 		}
-#ifdef RAW_SMART_PTR_DEBUG
-		std::cout << "Decrementing counter" << std::endl;
-		std::cout << "shared_ptr destructor called" << std::endl;
-		std::cout << "Pointer address: " << this->ptr << std::endl;
-		std::cout << "Use count: " << use_count() << std::endl;
-#endif
 	}
 };
 
@@ -99,19 +131,28 @@ public:
 
 	explicit shared_ptr(weak_ptr<T>& weak) noexcept {
 		if (weak.hub_ptr && weak.hub_ptr->try_increment_use_count_if_not_zero()) {
+			RAW_RECORD_OP(weak_lock, weak.hub_ptr);
 			this->ptr	  = weak.ptr;
 			this->hub_ptr = weak.hub_ptr;
 		} else {
+			RAW_RECORD_OP(weak_lock_failed, weak.hub_ptr);
 			this->ptr	  = nullptr;
 			this->hub_ptr = nullptr;
 		}
 	}
 
-	explicit shared_ptr(T* p) noexcept {
+	explicit shared_ptr(T* p,
+						std::source_location site = std::source_location::current()) noexcept {
 		if (p) {
 			this->ptr	  = p;
 			this->hub_ptr = new hub(this->ptr, nullptr, &raw::delete_single_object<T>,
 									&raw::deallocate_hub_for_new_single);
+			hook_shared_from_this(this->ptr, this->hub_ptr);
+			RAW_RECORD_OP(shared_make, this->hub_ptr);
+			RAW_TRACK_LIVE(this->hub_ptr, T, sizeof(T) + sizeof(hub), site);
+			RAW_COUNT_TYPE(T, shared_created);
+			RAW_STAMP_HUB(this->hub_ptr, T);
+			RAW_TRACE_EDGES(this->hub_ptr, T);
 		} else {
 			this->ptr	  = nullptr;
 			this->hub_ptr = nullptr;
@@ -123,10 +164,21 @@ public:
 		this->hub_ptr = hub;
 	}
 
-	inline explicit shared_ptr(unique_ptr<T>&& unique) noexcept {
+	inline explicit shared_ptr(unique_ptr<T>&& unique,
+							   std::source_location site =
+								   std::source_location::current()) noexcept {
 		this->ptr	  = unique.release();
 		this->hub_ptr = new hub(this->ptr, nullptr, &raw::delete_single_object<T>,
 								&raw::deallocate_hub_for_new_single);
+		hook_shared_from_this(this->ptr, this->hub_ptr);
+		RAW_RECORD_OP(shared_make, this->hub_ptr);
+		RAW_TRACK_LIVE(this->hub_ptr, T, sizeof(T) + sizeof(hub), site);
+		RAW_COUNT_TYPE(T, shared_created);
+		RAW_STAMP_HUB(this->hub_ptr, T);
+		// An empty unique_ptr still gets a hub, but no object to trace
+		if (this->ptr) {
+			RAW_TRACE_EDGES(this->hub_ptr, T);
+		}
 	}
 
 	shared_ptr& operator=(unique_ptr<T>&& unique) noexcept {
@@ -137,6 +189,8 @@ public:
 
 	shared_ptr& operator=(std::nullptr_t) noexcept {
 		if (this->hub_ptr) {
+			RAW_RECORD_OP(shared_destroy, this->hub_ptr);
+			RAW_TRACE(shared_release, this->ptr, this->hub_ptr->get_use_count());
 			this->hub_ptr->decrement_use_count();
 			this->hub_ptr = nullptr;
 		}
@@ -150,8 +204,9 @@ public:
 		return *this;
 	}
 
-	inline void reset(T* p = nullptr) noexcept {
-		shared_ptr<T> temp(p);
+	inline void reset(T* p = nullptr,
+					  std::source_location site = std::source_location::current()) noexcept {
+		shared_ptr<T> temp(p, site);
 		this->swap(temp);
 	}
 };
@@ -162,11 +217,17 @@ public:
 	// Inherit constructors
 	using shared_ptr_base<T[]>::shared_ptr_base;
 
-	explicit shared_ptr(T* p) noexcept {
+	// The array length is not known here, the leak tracker counts one element
+	explicit shared_ptr(T* p,
+						std::source_location site = std::source_location::current()) noexcept {
 		if (p != nullptr) {
 			this->ptr	  = p;
 			this->hub_ptr = new hub(this->ptr, nullptr, &raw::delete_array_object<T>,
 									&raw::deallocate_hub_for_new_array);
+			RAW_RECORD_OP(shared_make, this->hub_ptr);
+			RAW_TRACK_LIVE(this->hub_ptr, T, sizeof(T) + sizeof(hub), site);
+			RAW_COUNT_TYPE(T[], shared_created);
+			RAW_STAMP_HUB(this->hub_ptr, T[]);
 		} else {
 			this->ptr	  = nullptr;
 			this->hub_ptr = nullptr;
@@ -177,10 +238,16 @@ public:
 		*this = weak.lock();
 	}
 
-	inline explicit shared_ptr(unique_ptr<T[]>&& unique) noexcept {
+	inline explicit shared_ptr(unique_ptr<T[]>&& unique,
+							   std::source_location site =
+								   std::source_location::current()) noexcept {
 		this->ptr	  = unique.release();
 		this->hub_ptr = new hub(this->ptr, nullptr, &raw::delete_array_object<T>,
 								&raw::deallocate_hub_for_new_array);
+		RAW_RECORD_OP(shared_make, this->hub_ptr);
+		RAW_TRACK_LIVE(this->hub_ptr, T, sizeof(T) + sizeof(hub), site);
+		RAW_COUNT_TYPE(T[], shared_created);
+		RAW_STAMP_HUB(this->hub_ptr, T[]);
 	}
 
 	inline explicit shared_ptr(T* p, hub* hub) noexcept {
@@ -196,6 +263,8 @@ public:
 
 	shared_ptr& operator=(std::nullptr_t) noexcept {
 		if (this->hub_ptr) {
+			RAW_RECORD_OP(shared_destroy, this->hub_ptr);
+			RAW_TRACE(shared_release, this->ptr, this->hub_ptr->get_use_count());
 			this->hub_ptr->decrement_use_count();
 			this->hub_ptr = nullptr;
 		}
@@ -209,8 +278,9 @@ public:
 		return *this;
 	}
 
-	inline void reset(T* p = nullptr) noexcept {
-		shared_ptr<T[]> temp(p);
+	inline void reset(T* p = nullptr,
+					  std::source_location site = std::source_location::current()) noexcept {
+		shared_ptr<T[]> temp(p, site);
 		this->swap(temp);
 	}
 };
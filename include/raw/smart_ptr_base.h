@@ -5,9 +5,15 @@
 #ifndef SMARTPOINTERS_SMART_PTR_BASE_H
 #define SMARTPOINTERS_SMART_PTR_BASE_H
 
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
 
 #include "fwd.h"
+#include "op_recorder.h"
+#include "trace.h"
+#include "type_stats.h"
 
 namespace raw {
 template<typename T>
@@ -65,9 +71,14 @@ public:
 		return ptr <= other.ptr;
 	}
 
-	std::ostream& operator<<(std::ostream& os) const {
-		os << (ptr ? "Address=" + std::to_string(reinterpret_cast<uintptr_t>(ptr)) : "Null pointer")
-		   << ": " << (!ptr ? "null" : *ptr);
+	// A template so only <iosfwd> is needed here, the caller's stream brings <ostream>
+	template<typename CharT, typename Traits>
+	std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os) const {
+		if (ptr) {
+			os << "Address=" << std::to_string(reinterpret_cast<uintptr_t>(ptr)) << ": " << *ptr;
+		} else {
+			os << "Null pointer: null";
+		}
 		return os;
 	}
 };
@@ -0,0 +1,125 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_TEARDOWN_H
+#define SMARTPOINTERS_TEARDOWN_H
+
+#ifdef RAW_ITERATIVE_TEARDOWN
+#include <cstddef>
+#include <cstdlib>
+#endif
+
+namespace raw {
+/**
+ * @brief Runs the destruction of pointees, iteratively with RAW_ITERATIVE_TEARDOWN.
+ *
+ * Without the option run() just calls Destroy. With it, a destruction that starts while this
+ * thread is already inside one (a member pointer dropping the last reference from its owner's
+ * destructor) is queued on a thread-local worklist instead, and the outermost run() works the
+ * list off in a loop. A chain of any length then takes a constant amount of stack, at the cost
+ * of objects being destroyed after their owner's destructor returned instead of during it.
+ */
+class teardown {
+public:
+	using destroy_func = void (*)(void*) noexcept;
+
+#ifdef RAW_ITERATIVE_TEARDOWN
+private:
+	struct pending {
+		void*		 object;
+		destroy_func destroy;
+	};
+
+	// Trivially destructible, so it stays usable while other thread_locals are destroyed
+	struct worklist {
+		pending* items	  = nullptr;
+		size_t	 size	  = 0;
+		size_t	 capacity = 0;
+		bool	 draining = false;
+		// Set once the buffer was freed at thread exit, from then on nothing is queued
+		bool closed = false;
+	};
+
+	// Frees the worklist buffer when its thread exits
+	struct buffer_owner {
+		~buffer_owner() {
+			std::free(local.items);
+			local.items	   = nullptr;
+			local.capacity = 0;
+			local.closed   = true;
+		}
+	};
+
+	static constexpr size_t initial_capacity = 64;
+
+	static thread_local worklist	 local;
+	static thread_local buffer_owner owner;
+
+	// False if the buffer cannot grow, the caller then destroys the object right away
+	static bool push(void* object, destroy_func destroy) noexcept {
+		worklist& list = local;
+		if (list.size == list.capacity) {
+			if (list.closed) {
+				return false;
+			}
+			size_t	 capacity = list.capacity ? list.capacity * 2 : initial_capacity;
+			pending* items	  =
+				static_cast<pending*>(std::realloc(list.items, capacity * sizeof(pending)));
+			if (!items) {
+				return false;
+			}
+			if (!list.items) {
+				// Touching owner registers its destructor for this thread
+				(void)&owner;
+			}
+			list.items	  = items;
+			list.capacity = capacity;
+		}
+		list.items[list.size++] = pending {object, destroy};
+		return true;
+	}
+
+public:
+	teardown() = delete;
+
+	template<destroy_func Destroy>
+	static void run(void* object) noexcept {
+		worklist& list = local;
+		if (list.draining) {
+			if (!push(object, Destroy)) {
+				Destroy(object);
+			}
+			return;
+		}
+		list.draining = true;
+		Destroy(object);
+		while (list.size) {
+			pending next = list.items[--list.size];
+			next.destroy(next.object);
+		}
+		list.draining = false;
+	}
+
+	// Objects queued on this thread, only non-zero while a teardown runs
+	[[nodiscard]] static size_t pending_count() noexcept {
+		return local.size;
+	}
+#else
+	teardown() = delete;
+
+	template<destroy_func Destroy>
+	static void run(void* object) noexcept {
+		Destroy(object);
+	}
+#endif
+};
+
+#ifdef RAW_ITERATIVE_TEARDOWN
+inline thread_local teardown::worklist	   teardown::local;
+inline thread_local teardown::buffer_owner teardown::owner;
+#endif
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_TEARDOWN_H
@@ -0,0 +1,102 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_THREAD_POLICY_H
+#define SMARTPOINTERS_THREAD_POLICY_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace raw {
+// Plain counters for objects that never cross threads
+struct single_threaded_policy {
+	using counter_type = size_t;
+
+	static constexpr bool is_thread_safe = false;
+
+	static inline void increment(counter_type& counter) noexcept {
+		counter++;
+	}
+
+	// Returns true when the counter dropped to zero
+	static inline bool decrement(counter_type& counter) noexcept {
+		return --counter == 0;
+	}
+
+	static inline bool try_increment_if_not_zero(counter_type& counter) noexcept {
+		if (counter > 0) {
+			counter++;
+			return true;
+		}
+		return false;
+	}
+
+	// Same, reporting compare-exchange retries for the contention profiler, there are none here
+	static inline bool try_increment_if_not_zero(counter_type& counter, size_t& retries) noexcept {
+		retries = 0;
+		return try_increment_if_not_zero(counter);
+	}
+
+	static inline size_t load(const counter_type& counter) noexcept {
+		return counter;
+	}
+};
+
+// Atomic counters, same memory ordering std::shared_ptr uses (see decrement)
+struct multi_threaded_policy {
+	using counter_type = std::atomic<size_t>;
+
+	static constexpr bool is_thread_safe = true;
+
+	static inline void increment(counter_type& counter) noexcept {
+		counter.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Returns true when the counter dropped to zero. seq_cst so the hazard slot scan that
+	// follows the last release cannot be ordered before it (same instruction as acq_rel on x86)
+	static inline bool decrement(counter_type& counter) noexcept {
+		return counter.fetch_sub(1, std::memory_order_seq_cst) == 1;
+	}
+
+	static inline bool try_increment_if_not_zero(counter_type& counter) noexcept {
+		size_t current_count = counter.load(std::memory_order_relaxed);
+		while (current_count > 0) {
+			if (counter.compare_exchange_weak(current_count, current_count + 1,
+											  std::memory_order_acquire,
+											  std::memory_order_relaxed)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Same, reporting how often the compare-exchange failed, for the contention profiler
+	static inline bool try_increment_if_not_zero(counter_type& counter, size_t& retries) noexcept {
+		retries				 = 0;
+		size_t current_count = counter.load(std::memory_order_relaxed);
+		while (current_count > 0) {
+			if (counter.compare_exchange_weak(current_count, current_count + 1,
+											  std::memory_order_acquire,
+											  std::memory_order_relaxed)) {
+				return true;
+			}
+			++retries;
+		}
+		return false;
+	}
+
+	static inline size_t load(const counter_type& counter) noexcept {
+		return counter.load(std::memory_order_acquire);
+	}
+};
+
+#ifdef RAW_MULTI_THREADED
+using default_thread_policy = multi_threaded_policy;
+#else
+using default_thread_policy = single_threaded_policy;
+#endif
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_THREAD_POLICY_H
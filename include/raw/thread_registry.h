@@ -0,0 +1,73 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_THREAD_REGISTRY_H
+#define SMARTPOINTERS_THREAD_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace raw {
+/**
+ * @brief Lock-free list of per-thread records that other threads can scan.
+ *
+ * Record must provide `std::atomic<bool> in_use` and `Record* next`. Records are never freed,
+ * a thread that exits only marks its record unused so the next thread can adopt it. That keeps
+ * scanners safe without any reclamation of their own.
+ */
+template<typename Record>
+class thread_registry {
+private:
+	std::atomic<Record*> head {nullptr};
+	std::atomic<size_t>	 record_count {0};
+
+public:
+	constexpr thread_registry() noexcept = default;
+
+	thread_registry(const thread_registry&)			   = delete;
+	thread_registry& operator=(const thread_registry&) = delete;
+
+	Record* acquire() {
+		for (Record* record = head.load(std::memory_order_acquire); record;
+			 record			= record->next) {
+			bool expected = false;
+			if (!record->in_use.load(std::memory_order_relaxed) &&
+				record->in_use.compare_exchange_strong(expected, true,
+													   std::memory_order_acq_rel)) {
+				return record;
+			}
+		}
+
+		Record* record = new Record();
+		record->in_use.store(true, std::memory_order_relaxed);
+		record->next = head.load(std::memory_order_relaxed);
+		while (!head.compare_exchange_weak(record->next, record, std::memory_order_release,
+										   std::memory_order_relaxed)) {
+		}
+		// Scanners that see the new count are guaranteed to see the record too
+		record_count.fetch_add(1, std::memory_order_seq_cst);
+		return record;
+	}
+
+	void release(Record* record) noexcept {
+		record->in_use.store(false, std::memory_order_release);
+	}
+
+	// Number of records ever created, zero means no thread has registered yet
+	[[nodiscard]] size_t size() const noexcept {
+		return record_count.load(std::memory_order_seq_cst);
+	}
+
+	template<typename Func>
+	void for_each(Func&& func) const {
+		for (Record* record = head.load(std::memory_order_acquire); record;
+			 record			= record->next) {
+			func(*record);
+		}
+	}
+};
+
+} // namespace raw
+
+#endif // SMARTPOINTERS_THREAD_REGISTRY_H
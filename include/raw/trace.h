@@ -0,0 +1,205 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_TRACE_H
+#define SMARTPOINTERS_TRACE_H
+
+#include <cstdint>
+
+#ifdef RAW_SMART_PTR_DEBUG
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+#include "event_log.h"
+#endif
+
+namespace raw {
+// Lifecycle events the pointers trace with RAW_SMART_PTR_DEBUG
+enum class trace_event : uint8_t {
+	// A shared_ptr or weak_ptr let go of its reference, use_count is the count before that
+	shared_release,
+	weak_release,
+	// A unique_ptr deleted what it owned
+	unique_delete,
+	unique_array_delete,
+	count
+};
+
+struct trace_record {
+	uint64_t timestamp_ns;
+	// Address of the object the pointer held
+	uint64_t	object;
+	uint64_t	use_count;
+	uint32_t	thread_id;
+	trace_event event;
+	uint8_t		reserved[3];
+};
+
+[[nodiscard]] inline const char* trace_event_name(trace_event event) noexcept {
+	switch (event) {
+	case trace_event::shared_release:
+		return "shared_ptr release";
+	case trace_event::weak_release:
+		return "weak_ptr release";
+	case trace_event::unique_delete:
+		return "unique_ptr delete";
+	case trace_event::unique_array_delete:
+		return "unique_ptr delete[]";
+	default:
+		return "unknown";
+	}
+}
+
+#ifdef RAW_SMART_PTR_DEBUG
+
+// Receives the traced records on the tracer's background thread, in order per thread
+class trace_sink {
+public:
+	virtual ~trace_sink() = default;
+
+	virtual void consume(const trace_record* records, size_t count) noexcept = 0;
+};
+
+// Writes one line of text per record
+class file_trace_sink final : public trace_sink {
+private:
+	std::FILE* file;
+
+public:
+	explicit file_trace_sink(std::FILE* file) noexcept : file(file) {}
+
+	void consume(const trace_record* records, size_t count) noexcept override {
+		for (size_t i = 0; i < count; ++i) {
+			const trace_record& record = records[i];
+			std::fprintf(file, "[thread %u] %llu ns: %s, pointer address 0x%llx, use count %llu\n",
+						 record.thread_id, static_cast<unsigned long long>(record.timestamp_ns),
+						 trace_event_name(record.event),
+						 static_cast<unsigned long long>(record.object),
+						 static_cast<unsigned long long>(record.use_count));
+		}
+		std::fflush(file);
+	}
+};
+
+/**
+ * @brief Sends pointer lifecycle events to a pluggable trace_sink.
+ *
+ * Tracing a destructor costs a thread-local sample check and a push into the thread's own ring
+ * (see event_log); the sink only runs on the background thread. A sink sees every sample_every-th
+ * event of each thread, full rings drop events instead of blocking.
+ *
+ * Compiled in with RAW_SMART_PTR_DEBUG only. By default the whole run is traced to stdout,
+ * RAW_TRACE_SAMPLE=n in the environment keeps every n-th event and 0 turns that session off.
+ */
+class tracer {
+public:
+	using log = event_log<trace_record, size_t(1) << 14>;
+
+private:
+	// Guarded by session_mutex, the log's flusher calls sink while a session runs
+	static std::mutex			 session_mutex;
+	static trace_sink*			 sink;
+	static std::atomic<uint32_t> sample_every;
+
+	// Events this thread still skips before it records the next one
+	static thread_local uint32_t sample_countdown;
+
+	static void deliver(const trace_record* records, size_t count) {
+		sink->consume(records, count);
+	}
+
+public:
+	tracer() = delete;
+
+	/**
+	 * @brief Starts tracing into session_sink, which has to outlive the session.
+	 * @return false if a session is already running.
+	 */
+	static bool start(trace_sink& session_sink, uint32_t session_sample_every = 1) {
+		std::lock_guard lock(session_mutex);
+		if (sink) {
+			return false;
+		}
+		sink = &session_sink;
+		sample_every.store(session_sample_every ? session_sample_every : 1,
+						   std::memory_order_relaxed);
+		if (!log::start(&deliver)) {
+			sink = nullptr;
+			return false;
+		}
+		return true;
+	}
+
+	// Stops tracing and hands the sink what the rings still hold
+	static void stop() {
+		std::lock_guard lock(session_mutex);
+		if (!sink) {
+			return;
+		}
+		log::stop();
+		sink = nullptr;
+	}
+
+	[[nodiscard]] static bool active() noexcept {
+		return log::active();
+	}
+
+	// Events lost to full rings in the current (or last) session, skipped samples not included
+	[[nodiscard]] static uint64_t dropped_events() noexcept {
+		return log::dropped_events();
+	}
+
+	// A null object is not traced, like a unique_ptr that owns nothing being destroyed
+	static void emit(trace_event event, const void* object, size_t use_count) noexcept {
+		if (!object || !log::active()) {
+			return;
+		}
+		if (sample_countdown) {
+			--sample_countdown;
+			return;
+		}
+		sample_countdown = sample_every.load(std::memory_order_relaxed) - 1;
+		log::push(trace_record {0, reinterpret_cast<uintptr_t>(object), use_count, 0, event, {}});
+	}
+};
+
+inline std::mutex			 tracer::session_mutex;
+inline trace_sink*			 tracer::sink			  = nullptr;
+inline std::atomic<uint32_t> tracer::sample_every {1};
+inline thread_local uint32_t tracer::sample_countdown = 0;
+
+// The default session, traces to stdout unless RAW_TRACE_SAMPLE=0
+struct tracer_default_session {
+	file_trace_sink sink {stdout};
+
+	tracer_default_session() {
+		const char* sample = std::getenv("RAW_TRACE_SAMPLE");
+		uint32_t	every  = sample ? static_cast<uint32_t>(std::strtoul(sample, nullptr, 10)) : 1;
+		if (every) {
+			tracer::start(sink, every);
+		}
+	}
+	~tracer_default_session() {
+		tracer::stop();
+	}
+};
+
+// Defined after the tracer's own statics, so it is constructed after and destroyed before them
+inline tracer_default_session tracer_default;
+
+#endif
+
+} // namespace raw
+
+// Hook used by the pointers, compiles to nothing unless RAW_SMART_PTR_DEBUG is defined
+#ifdef RAW_SMART_PTR_DEBUG
+#define RAW_TRACE(event, object, use_count) \
+	::raw::tracer::emit(::raw::trace_event::event, object, use_count)
+#else
+#define RAW_TRACE(event, object, use_count) ((void)0)
+#endif
+
+#endif // SMARTPOINTERS_TRACE_H
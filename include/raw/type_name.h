@@ -0,0 +1,34 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_TYPE_NAME_H
+#define SMARTPOINTERS_TYPE_NAME_H
+
+#include <algorithm>
+#include <source_location>
+#include <string>
+#include <string_view>
+
+namespace raw {
+// Function name of type_signature<T>(), the diagnostics cut the type out of it only for a report
+template<typename T>
+const char* type_signature() noexcept {
+	return std::source_location::current().function_name();
+}
+
+// "... [with T = node]" on GCC, "... [T = node]" on Clang, "...type_signature<node>(void)" on MSVC
+inline std::string type_name(const char* signature) {
+	std::string_view name(signature);
+	if (size_t at = name.find("T = "); at != std::string_view::npos) {
+		name.remove_prefix(at + 4);
+		name = name.substr(0, std::min(name.find(';'), name.rfind(']')));
+	} else if (size_t open = name.find("type_signature<"); open != std::string_view::npos) {
+		name.remove_prefix(open + 15);
+		name = name.substr(0, name.rfind(">("));
+	}
+	return std::string(name);
+}
+} // namespace raw
+
+#endif // SMARTPOINTERS_TYPE_NAME_H
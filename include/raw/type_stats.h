@@ -0,0 +1,224 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_TYPE_STATS_H
+#define SMARTPOINTERS_TYPE_STATS_H
+
+#include <cstdint>
+
+#ifdef RAW_TYPE_STATS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "thread_registry.h"
+#include "type_name.h"
+#endif
+
+namespace raw {
+// What the per-type statistics count, copies and moves are of shared_ptr and unique_ptr handles
+enum class type_event : uint8_t {
+	// make_shared, or shared_ptr taking ownership of a raw pointer or a unique_ptr
+	shared_created,
+	// make_unique, or unique_ptr taking ownership of a raw pointer
+	unique_created,
+	copied,
+	moved,
+	destroyed,
+	count
+};
+
+#ifdef RAW_TYPE_STATS
+
+// Totals over all threads for one pointee type
+struct type_stats_snapshot {
+	std::string type_name;
+	uint64_t	counts[size_t(type_event::count)] = {};
+	// Lifetimes are only known for objects owned by a hub
+	uint64_t timed_destroys	   = 0;
+	uint64_t total_lifetime_ns = 0;
+
+	[[nodiscard]] uint64_t operator[](type_event event) const noexcept {
+		return counts[size_t(event)];
+	}
+
+	[[nodiscard]] double average_lifetime_ns() const noexcept {
+		return timed_destroys ? double(total_lifetime_ns) / double(timed_destroys) : 0.0;
+	}
+};
+
+// Every type_stats<T> that counted anything, registered during static initialization
+struct type_stats_node {
+	type_stats_snapshot (*snapshot)();
+	type_stats_node* next;
+};
+
+inline std::atomic<type_stats_node*> type_stats_head {nullptr};
+
+inline bool register_type_stats(type_stats_node* node) noexcept {
+	node->next = type_stats_head.load(std::memory_order_relaxed);
+	while (!type_stats_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+												  std::memory_order_relaxed)) {
+	}
+	return true;
+}
+
+[[nodiscard]] inline uint64_t stats_clock_ns() noexcept {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+/**
+ * @brief Per-thread counters of what happens to the pointers of one pointee type.
+ *
+ * A thread only ever writes its own record, with plain relaxed stores, so counting costs no
+ * shared cache lines. snapshot() sums the records of all threads, including the ones that
+ * exited; their records are kept and adopted by later threads (see thread_registry).
+ *
+ * Compiled in with RAW_TYPE_STATS only.
+ */
+template<typename T>
+class type_stats {
+public:
+	struct alignas(64) thread_record {
+		std::atomic<bool>	  in_use {false};
+		thread_record*		  next = nullptr;
+		std::atomic<uint64_t> counts[size_t(type_event::count)] {};
+		std::atomic<uint64_t> timed_destroys {0};
+		std::atomic<uint64_t> total_lifetime_ns {0};
+	};
+
+private:
+	struct thread_state {
+		thread_record* record = nullptr;
+
+		~thread_state() {
+			if (record) {
+				registry.release(record);
+			}
+		}
+	};
+
+	static thread_registry<thread_record> registry;
+	static type_stats_node				  node;
+	static const bool					  registered;
+	static thread_local thread_state	  local_state;
+
+	// nullptr only if the first record of this thread could not be allocated
+	static thread_record* local_record() noexcept {
+		thread_state& state = local_state;
+		if (!state.record) {
+			try {
+				state.record = registry.acquire();
+			} catch (const std::bad_alloc&) {
+				return nullptr;
+			}
+		}
+		return state.record;
+	}
+
+	static void add(std::atomic<uint64_t>& counter, uint64_t value) noexcept {
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+public:
+	type_stats() = delete;
+
+	static void count(type_event event) noexcept {
+		// Odr-uses registered, so every counted type is in the list before main
+		(void)registered;
+		if (thread_record* record = local_record()) {
+			add(record->counts[size_t(event)], 1);
+		}
+	}
+
+	// A hub destroyed its object, lifetime_ns after it was created
+	static void count_destroy(uint64_t lifetime_ns) noexcept {
+		(void)registered;
+		if (thread_record* record = local_record()) {
+			add(record->counts[size_t(type_event::destroyed)], 1);
+			add(record->timed_destroys, 1);
+			add(record->total_lifetime_ns, lifetime_ns);
+		}
+	}
+
+	[[nodiscard]] static type_stats_snapshot snapshot() {
+		type_stats_snapshot totals;
+		totals.type_name = type_name(type_signature<T>());
+		registry.for_each([&totals](const thread_record& record) {
+			for (size_t i = 0; i < size_t(type_event::count); ++i) {
+				totals.counts[i] += record.counts[i].load(std::memory_order_relaxed);
+			}
+			totals.timed_destroys += record.timed_destroys.load(std::memory_order_relaxed);
+			totals.total_lifetime_ns += record.total_lifetime_ns.load(std::memory_order_relaxed);
+		});
+		return totals;
+	}
+};
+
+template<typename T>
+inline thread_registry<typename type_stats<T>::thread_record> type_stats<T>::registry;
+template<typename T>
+inline type_stats_node type_stats<T>::node {&type_stats<T>::snapshot, nullptr};
+template<typename T>
+inline const bool type_stats<T>::registered = register_type_stats(&type_stats<T>::node);
+template<typename T>
+inline thread_local typename type_stats<T>::thread_state type_stats<T>::local_state;
+
+// Lets the hub count its object's lifetime for T when it destroys it
+template<typename T, typename Hub>
+inline void stamp_hub(Hub* hub) noexcept {
+	hub->created_ns	   = stats_clock_ns();
+	hub->count_destroy = &type_stats<T>::count_destroy;
+}
+
+// Snapshots of every counted type, most created first
+[[nodiscard]] inline std::vector<type_stats_snapshot> collect_type_stats() {
+	std::vector<type_stats_snapshot> all;
+	for (type_stats_node* node = type_stats_head.load(std::memory_order_acquire); node;
+		 node				   = node->next) {
+		all.push_back(node->snapshot());
+	}
+	auto created = [](const type_stats_snapshot& stats) {
+		return stats[type_event::shared_created] + stats[type_event::unique_created];
+	};
+	std::sort(all.begin(), all.end(),
+			  [&](const type_stats_snapshot& a, const type_stats_snapshot& b) {
+				  return created(a) > created(b);
+			  });
+	return all;
+}
+
+inline void dump_type_stats(std::FILE* out = stderr) {
+	std::fprintf(out, "%12s %12s %12s %12s %12s %14s  %s\n", "shared made", "unique made",
+				 "copies", "moves", "destroyed", "avg life us", "type");
+	for (const type_stats_snapshot& stats : collect_type_stats()) {
+		std::fprintf(out, "%12llu %12llu %12llu %12llu %12llu %14.1f  %s\n",
+					 static_cast<unsigned long long>(stats[type_event::shared_created]),
+					 static_cast<unsigned long long>(stats[type_event::unique_created]),
+					 static_cast<unsigned long long>(stats[type_event::copied]),
+					 static_cast<unsigned long long>(stats[type_event::moved]),
+					 static_cast<unsigned long long>(stats[type_event::destroyed]),
+					 stats.average_lifetime_ns() / 1000.0, stats.type_name.c_str());
+	}
+}
+
+#endif
+
+} // namespace raw
+
+// Hooks used by the pointers, they compile to nothing unless RAW_TYPE_STATS is defined
+#ifdef RAW_TYPE_STATS
+#define RAW_COUNT_TYPE(type, event) ::raw::type_stats<type>::count(::raw::type_event::event)
+#define RAW_STAMP_HUB(hub, type) ::raw::stamp_hub<type>(hub)
+#else
+#define RAW_COUNT_TYPE(type, event) ((void)0)
+#define RAW_STAMP_HUB(hub, type) ((void)0)
+#endif
+
+#endif // SMARTPOINTERS_TYPE_STATS_H
@@ -6,39 +6,79 @@
 #define SMARTPOINTERS_UNIQUE_PTR_H
 
 #include "smart_ptr_base.h"
+#include "teardown.h"
 
 namespace raw {
 template<typename T>
 class unique_ptr : public smart_ptr_base<T> {
+private:
+	static void delete_owned(void* object) noexcept {
+		delete static_cast<T*>(object);
+	}
+
+	// release() without the recorder event, for transfers between unique_ptrs
+	T* take() noexcept {
+		T* temp	  = this->ptr;
+		this->ptr = nullptr;
+		return temp;
+	}
+
+	void replace(T* p) noexcept {
+		if (this->ptr == p) {
+			return;
+		}
+		RAW_RECORD_OP(unique_destroy, this->ptr);
+		RAW_TRACE(unique_delete, this->ptr, 0);
+		if (this->ptr) {
+			RAW_COUNT_TYPE(T, destroyed);
+			teardown::run<&unique_ptr::delete_owned>(this->ptr);
+		}
+		this->ptr = p;
+	}
+
 public:
 	// Inherit constructors
 	using smart_ptr_base<T>::smart_ptr_base;
 
+	explicit unique_ptr(T* p) noexcept : smart_ptr_base<T>(p) {
+		RAW_RECORD_OP(unique_make, p);
+		if (p) {
+			RAW_COUNT_TYPE(T, unique_created);
+		}
+	}
+
 	~unique_ptr() noexcept {
-#ifdef RAW_SMART_PTR_DEBUG
-		std::cout << "Deleting single object" << std::endl;
-		std::cout << "unique_ptr destructor called" << std::endl;
-		std::cout << "Pointer address: " << this->ptr << std::endl;
-#endif
-		delete this->ptr;
+		RAW_RECORD_OP(unique_destroy, this->ptr);
+		RAW_TRACE(unique_delete, this->ptr, 0);
+		if (this->ptr) {
+			RAW_COUNT_TYPE(T, destroyed);
+			teardown::run<&unique_ptr::delete_owned>(this->ptr);
+		}
 	}
 
 	// Move constructor
 	unique_ptr(unique_ptr&& other) noexcept : smart_ptr_base<T>(std::move(other.ptr)) {
 		other.ptr = nullptr;
+		RAW_RECORD_OP(unique_move, this->ptr);
+		if (this->ptr) {
+			RAW_COUNT_TYPE(T, moved);
+		}
 	}
 
 	// Move assignment operator
 	unique_ptr& operator=(unique_ptr&& other) noexcept {
 		// Clean up and transfer ownership
-		reset(other.release());
+		RAW_RECORD_OP(unique_move, other.ptr);
+		if (other.ptr) {
+			RAW_COUNT_TYPE(T, moved);
+		}
+		replace(other.take());
 		return *this;
 	}
 
 	unique_ptr& operator=(std::nullptr_t) noexcept {
 		// Clean up the current pointer
-		delete this->ptr;
-		this->ptr = nullptr;
+		replace(nullptr);
 		return *this;
 	}
 
@@ -47,17 +87,19 @@ public:
 	unique_ptr& operator=(const unique_ptr&) = delete;
 
 	T* release() noexcept {
-		T* temp	  = this->ptr;
-		this->ptr = nullptr;
-		return temp;
+		RAW_RECORD_OP(unique_release, this->ptr);
+		return take();
 	}
 
 	void reset(T* p = nullptr) noexcept {
 		if (this->ptr == p) {
 			return;
 		}
-		delete this->ptr;
-		this->ptr = p;
+		replace(p);
+		RAW_RECORD_OP(unique_make, p);
+		if (p) {
+			RAW_COUNT_TYPE(T, unique_created);
+		}
 	}
 
 	void swap(unique_ptr& other) noexcept {
@@ -67,35 +109,74 @@ public:
 
 template<typename T>
 class unique_ptr<T[]> : public smart_ptr_base<T[]> {
+private:
+	static void delete_owned(void* object) noexcept {
+		delete[] static_cast<T*>(object);
+	}
+
+	// release() without the recorder event, for transfers between unique_ptrs
+	T* take() noexcept {
+		T* temp	  = this->ptr;
+		this->ptr = nullptr;
+		return temp;
+	}
+
+	void replace(T* p) noexcept {
+		if (this->ptr == p) {
+			return;
+		}
+		RAW_RECORD_OP(unique_destroy, this->ptr);
+		RAW_TRACE(unique_array_delete, this->ptr, 0);
+		if (this->ptr) {
+			RAW_COUNT_TYPE(T[], destroyed);
+			teardown::run<&unique_ptr::delete_owned>(this->ptr);
+		}
+		this->ptr = p;
+	}
+
 public:
 	// Inherit constructors
 	using smart_ptr_base<T[]>::smart_ptr_base;
 
+	explicit unique_ptr(T* p) noexcept : smart_ptr_base<T[]>(p) {
+		RAW_RECORD_OP(unique_make, p);
+		if (p) {
+			RAW_COUNT_TYPE(T[], unique_created);
+		}
+	}
+
 	~unique_ptr() noexcept {
-#ifdef RAW_SMART_PTR_DEBUG
-		std::cout << "Deleting an array" << std::endl;
-		std::cout << "unique_ptr destructor called" << std::endl;
-		std::cout << "Pointer address: " << this->ptr << std::endl;
-#endif
-		delete[] this->ptr;
+		RAW_RECORD_OP(unique_destroy, this->ptr);
+		RAW_TRACE(unique_array_delete, this->ptr, 0);
+		if (this->ptr) {
+			RAW_COUNT_TYPE(T[], destroyed);
+			teardown::run<&unique_ptr::delete_owned>(this->ptr);
+		}
 	}
 
 	// Move constructor
 	unique_ptr(unique_ptr&& other) noexcept : smart_ptr_base<T[]>(std::move(other.ptr)) {
 		other.ptr = nullptr;
+		RAW_RECORD_OP(unique_move, this->ptr);
+		if (this->ptr) {
+			RAW_COUNT_TYPE(T[], moved);
+		}
 	}
 
 	// Move assignment operator
 	unique_ptr& operator=(unique_ptr&& other) noexcept {
 		// Clean up and transfer ownership
-		reset(other.release());
+		RAW_RECORD_OP(unique_move, other.ptr);
+		if (other.ptr) {
+			RAW_COUNT_TYPE(T[], moved);
+		}
+		replace(other.take());
 		return *this;
 	}
 
 	unique_ptr& operator=(std::nullptr_t) noexcept {
 		// Clean up the current pointer
-		delete[] this->ptr;
-		this->ptr = nullptr;
+		replace(nullptr);
 		return *this;
 	}
 
@@ -104,17 +185,19 @@ public:
 	unique_ptr& operator=(const unique_ptr&) = delete;
 
 	T* release() noexcept {
-		T* temp	  = this->ptr;
-		this->ptr = nullptr;
-		return temp;
+		RAW_RECORD_OP(unique_release, this->ptr);
+		return take();
 	}
 
 	void reset(T* p = nullptr) noexcept {
 		if (this->ptr == p) {
 			return;
 		}
-		delete[] this->ptr;
-		this->ptr = p;
+		replace(p);
+		RAW_RECORD_OP(unique_make, p);
+		if (p) {
+			RAW_COUNT_TYPE(T[], unique_created);
+		}
 	}
 
 	void swap(unique_ptr& other) noexcept {
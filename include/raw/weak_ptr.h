@@ -5,6 +5,7 @@
 #ifndef SMARTPOINTERS_WEAK_PTR_H
 #define SMARTPOINTERS_WEAK_PTR_H
 
+#include "hazard_pointer.h"
 #include "helper.h"
 #include "smart_ptr_base.h"
 
@@ -14,6 +15,8 @@ class weak_ptr_base : public smart_ptr_base<T> {
 protected:
 	hub* hub_ptr = nullptr;
 	friend class shared_ptr<T>;
+	friend class enable_shared_from_this<T>;
+	friend class atomic_weak_ptr<T>;
 
 public:
 	// Inherit constructors
@@ -28,11 +31,13 @@ public:
 	weak_ptr_base(const weak_ptr_base& other) noexcept {
 		this->ptr = other.ptr;
 		hub_ptr	  = other.hub_ptr;
+		RAW_RECORD_OP(weak_copy, hub_ptr);
 		if (hub_ptr)
 			hub_ptr->increment_weak_count();
 	}
 
 	weak_ptr_base(weak_ptr_base&& other) noexcept {
+		RAW_RECORD_OP(weak_move, other.hub_ptr);
 		this->ptr	  = other.ptr;
 		hub_ptr		  = other.hub_ptr;
 		other.ptr	  = nullptr;
@@ -42,11 +47,14 @@ public:
 	weak_ptr_base& operator=(const weak_ptr_base& other) noexcept {
 		if (this != &other) {
 			if (hub_ptr) {
+				RAW_RECORD_OP(weak_destroy, hub_ptr);
+				RAW_TRACE(weak_release, this->ptr, hub_ptr->get_use_count());
 				hub_ptr->decrement_weak_count();
 			}
 			this->ptr = other.ptr;
 			hub_ptr	  = other.hub_ptr;
 			if (hub_ptr) {
+				RAW_RECORD_OP(weak_copy, hub_ptr);
 				hub_ptr->increment_weak_count();
 			}
 		}
@@ -56,8 +64,11 @@ public:
 	weak_ptr_base& operator=(weak_ptr_base&& other) noexcept {
 		if (this != &other) {
 			if (hub_ptr) {
+				RAW_RECORD_OP(weak_destroy, hub_ptr);
+				RAW_TRACE(weak_release, this->ptr, hub_ptr->get_use_count());
 				hub_ptr->decrement_weak_count();
 			}
+			RAW_RECORD_OP(weak_move, other.hub_ptr);
 			this->ptr	  = other.ptr;
 			hub_ptr		  = other.hub_ptr;
 			other.ptr	  = nullptr;
@@ -68,6 +79,8 @@ public:
 
 	void reset() noexcept {
 		if (hub_ptr) {
+			RAW_RECORD_OP(weak_destroy, hub_ptr);
+			RAW_TRACE(weak_release, this->ptr, hub_ptr->get_use_count());
 			hub_ptr->decrement_weak_count();
 			hub_ptr = nullptr;
 		}
@@ -81,14 +94,10 @@ public:
 
 	~weak_ptr_base() noexcept {
 		if (hub_ptr) {
+			RAW_RECORD_OP(weak_destroy, hub_ptr);
+			RAW_TRACE(weak_release, this->ptr, hub_ptr->get_use_count());
 			hub_ptr->decrement_weak_count();
 		}
-#ifdef RAW_SMART_PTR_DEBUG
-		std::cout << "Decrementing counter" << std::endl;
-		std::cout << "weak_ptr destructor called" << std::endl;
-		std::cout << "Pointer address: " << this->ptr << std::endl;
-		std::cout << "Use count: " << use_count() << std::endl;
-#endif
 	}
 
 	inline size_t use_count() const noexcept {
@@ -96,23 +105,25 @@ public:
 	}
 
 	inline bool expired() const noexcept {
-#ifdef RAW_SMART_PTR_DEBUG
-		std::cout << use_count() << std::endl;
-#endif
 		return use_count() == 0;
 	}
 
 	inline shared_ptr<T> lock() const noexcept {
-#ifdef RAW_MULTI_THREADED
 		if (this->hub_ptr && this->hub_ptr->try_increment_use_count_if_not_zero()) {
-#else
-		if (this->hub_ptr && this->hub_ptr->use_count > 0) {
-			this->hub_ptr->use_count++;
-#endif
+			RAW_RECORD_OP(weak_lock, this->hub_ptr);
 			return shared_ptr<T>(this->ptr, this->hub_ptr);
 		}
+		RAW_RECORD_OP(weak_lock_failed, this->hub_ptr);
 		return shared_ptr<T>();
 	}
+
+	/**
+	 * @brief Keeps the object alive for as long as the guard lives, without taking ownership.
+	 * @return An empty guard if the object has already expired.
+	 */
+	inline hazard_guard<T> protect() const noexcept {
+		return hazard_guard<T>(this->ptr, this->hub_ptr);
+	}
 };
 template<typename T>
 class weak_ptr : public weak_ptr_base<T> {
@@ -128,17 +139,21 @@ public:
 		this->ptr	  = shared.get();
 		this->hub_ptr = shared.hub_ptr;
 		if (this->hub_ptr) {
+			RAW_RECORD_OP(weak_copy, this->hub_ptr);
 			this->hub_ptr->increment_weak_count();
 		}
 	}
 
 	inline weak_ptr& operator=(const shared_ptr<T>& shared) noexcept {
 		if (this->hub_ptr) {
+			RAW_RECORD_OP(weak_destroy, this->hub_ptr);
+			RAW_TRACE(weak_release, this->ptr, this->hub_ptr->get_use_count());
 			this->hub_ptr->decrement_weak_count();
 		}
 		this->ptr	  = shared.get();
 		this->hub_ptr = shared.hub_ptr;
 		if (this->hub_ptr) {
+			RAW_RECORD_OP(weak_copy, this->hub_ptr);
 			this->hub_ptr->increment_weak_count();
 		}
 		return *this;
@@ -158,17 +173,21 @@ public:
 		this->ptr	  = shared.get();
 		this->hub_ptr = shared.hub_ptr;
 		if (this->hub_ptr) {
+			RAW_RECORD_OP(weak_copy, this->hub_ptr);
 			this->hub_ptr->increment_weak_count();
 		}
 	}
 
 	inline weak_ptr& operator=(const shared_ptr<T[]>& shared) noexcept {
 		if (this->hub_ptr) {
+			RAW_RECORD_OP(weak_destroy, this->hub_ptr);
+			RAW_TRACE(weak_release, this->ptr, this->hub_ptr->get_use_count());
 			this->hub_ptr->decrement_weak_count();
 		}
 		this->ptr	  = shared.get();
 		this->hub_ptr = shared.hub_ptr;
 		if (this->hub_ptr) {
+			RAW_RECORD_OP(weak_copy, this->hub_ptr);
 			this->hub_ptr->increment_weak_count();
 		}
 		return *this;
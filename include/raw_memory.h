@@ -5,7 +5,14 @@
 #ifndef SMARTPOINTERS_RAW_MEMORY_H
 #define SMARTPOINTERS_RAW_MEMORY_H
 
+#include "raw/atomic_shared_ptr.h"
+#include "raw/cycle_collector.h"
+#include "raw/deferred_deleter.h"
+#include "raw/enable_shared_from_this.h"
+#include "raw/hazard_pointer.h"
 #include "raw/helper.h"
+#include "raw/intrusive_ptr.h"
+#include "raw/rcu_ptr.h"
 #include "raw/shared_ptr.h"
 #include "raw/unique_ptr.h"
 #include "raw/weak_ptr.h"
@@ -0,0 +1,38 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_ALLOC_COUNTER_H
+#define SMARTPOINTERS_ALLOC_COUNTER_H
+
+#include <cstdint>
+
+/**
+ * @brief Totals of the counting allocator linked into the test binary.
+ *
+ * Global operator new/delete are replaced, and on glibc malloc, calloc, realloc, aligned_alloc,
+ * posix_memalign and free are interposed as well, so raw::make_shared (which goes through
+ * std::aligned_alloc) is seen the same way as std::make_shared. Counting is compiled out under
+ * sanitizers and on other C libraries; alloc_counting_enabled() tells which case applies.
+ */
+struct AllocSnapshot {
+	uint64_t allocs = 0;
+	uint64_t frees	= 0;
+	// Requested bytes, not what the allocator rounded them up to
+	uint64_t bytes = 0;
+};
+
+bool alloc_counting_enabled();
+
+// Sum over all threads, cheap enough to take around every trial
+AllocSnapshot alloc_snapshot();
+
+/**
+ * Live heap bytes (usable size) allocated minus freed by the calling thread, and its high-water
+ * mark since the last alloc_reset_thread_peak(). Exact as long as one thread does the work.
+ */
+int64_t alloc_thread_live_bytes();
+int64_t alloc_thread_peak_bytes();
+void	alloc_reset_thread_peak();
+
+#endif // SMARTPOINTERS_ALLOC_COUNTER_H
@@ -0,0 +1,122 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_ATOMIC_H
+#define SMARTPOINTERS_BENCHMARK_ATOMIC_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "common_test_utils.h"
+
+
+void performance_comparison_atomic_test();
+
+// std::shared_ptr has atomic counts in every build, so this slot works without RAW_MULTI_THREADED
+struct StdAtomicSnapshotSlot {
+	using pointer_type = std::shared_ptr<ConcurrentTestObject>;
+
+	std::atomic<pointer_type> current;
+
+	static pointer_type make(int version) {
+		return std::make_shared<ConcurrentTestObject>(version);
+	}
+	pointer_type load() const {
+		return current.load();
+	}
+	void store(pointer_type next) {
+		current.store(std::move(next));
+	}
+};
+
+// reader_count threads load the snapshot reads_per_thread times each while one writer republishes
+template<typename SnapshotSlot>
+long long run_snapshot_readers_test(int reads_per_thread, int reader_count) {
+	SnapshotSlot slot;
+	slot.store(SnapshotSlot::make(0));
+
+	std::atomic<bool> start {false};
+	std::atomic<int>  readers_done {0};
+
+	std::vector<std::thread> readers;
+	readers.reserve(reader_count);
+	for (int t = 0; t < reader_count; ++t) {
+		readers.emplace_back([&] {
+			while (!start.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			long long sum = 0;
+			for (int j = 0; j < reads_per_thread; ++j) {
+				sum += slot.load()->id;
+			}
+			do_not_optimize(sum);
+			readers_done.fetch_add(1, std::memory_order_release);
+		});
+	}
+
+	std::thread writer([&] {
+		int version = 0;
+		while (readers_done.load(std::memory_order_acquire) < reader_count) {
+			slot.store(SnapshotSlot::make(++version));
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+	});
+
+	auto start_time = trial_begin();
+	start.store(true, std::memory_order_release);
+	for (std::thread& reader : readers) {
+		reader.join();
+	}
+	auto end_time = trial_end();
+	writer.join();
+	return elapsed_ns(start_time, end_time);
+}
+
+#ifdef RAW_MULTI_THREADED
+
+struct MutexSnapshotSlot {
+	using pointer_type = raw::shared_ptr<ConcurrentTestObject>;
+
+	mutable std::mutex mutex;
+	pointer_type	   current;
+
+	static pointer_type make(int version) {
+		return raw::make_shared<ConcurrentTestObject>(version);
+	}
+	pointer_type load() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return current;
+	}
+	void store(pointer_type next) {
+		std::lock_guard<std::mutex> lock(mutex);
+		current = std::move(next);
+	}
+};
+
+struct RawAtomicSnapshotSlot {
+	using pointer_type = raw::shared_ptr<ConcurrentTestObject>;
+
+	raw::atomic_shared_ptr<ConcurrentTestObject> current;
+
+	static pointer_type make(int version) {
+		return raw::make_shared<ConcurrentTestObject>(version);
+	}
+	pointer_type load() const {
+		return current.load();
+	}
+	void store(pointer_type next) {
+		current.store(std::move(next));
+	}
+};
+
+#endif
+
+#endif // SMARTPOINTERS_BENCHMARK_ATOMIC_H
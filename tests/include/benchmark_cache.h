@@ -0,0 +1,99 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_CACHE_H
+#define SMARTPOINTERS_BENCHMARK_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "common_test_utils.h"
+
+void performance_comparison_cache_test();
+
+// Bytes of working set one pool entry stands for, one cache line per control block
+inline constexpr size_t cold_pool_entry_bytes = 64;
+
+// Half the L1 data cache up to 4x the LLC in steps of 4, the last step capped at max_bytes
+std::vector<size_t> working_set_sweep(const CacheSizes& caches, size_t max_bytes);
+
+/**
+ * @brief Owners and observers of entries objects, visited in a random order.
+ *
+ * order holds one pool index per operation of a trial, drawn up front, so the hardware
+ * prefetcher cannot guess the next control block and every side visits the same sequence.
+ */
+template<typename SharedPtrType, typename WeakPtrType>
+struct ColdPool {
+	std::vector<SharedPtrType> owners;
+	std::vector<WeakPtrType>   observers;
+	std::vector<uint32_t>	   order;
+};
+
+template<typename SharedPtrType, typename WeakPtrType, typename MakeSharedFunc>
+ColdPool<SharedPtrType, WeakPtrType> build_cold_pool(size_t entries, int ops_per_trial,
+													 uint64_t seed,
+													 MakeSharedFunc make_shared_func) {
+	ColdPool<SharedPtrType, WeakPtrType> pool;
+	pool.owners.reserve(entries);
+	pool.observers.reserve(entries);
+	for (size_t i = 0; i < entries; ++i) {
+		pool.owners.push_back(make_shared_func(static_cast<int>(i)));
+		pool.observers.emplace_back(pool.owners.back());
+	}
+
+	std::mt19937_64							gen(seed);
+	std::uniform_int_distribution<uint32_t> dist_idx(0, static_cast<uint32_t>(entries - 1));
+	pool.order.resize(ops_per_trial);
+	for (uint32_t& idx : pool.order) {
+		idx = dist_idx(gen);
+	}
+	return pool;
+}
+
+template<typename PoolType>
+long long run_cold_use_count_test(const PoolType& pool, int ops) {
+	long long sum	= 0;
+	auto	  start = trial_begin();
+	for (int j = 0; j < ops; ++j) {
+		sum += pool.owners[pool.order[j]].use_count();
+	}
+	auto end = trial_end();
+	do_not_optimize(sum);
+	return elapsed_ns(start, end);
+}
+
+template<typename PoolType>
+long long run_cold_copy_test(const PoolType& pool, int ops) {
+	long long sum	= 0;
+	auto	  start = trial_begin();
+	for (int j = 0; j < ops; ++j) {
+		auto copy = pool.owners[pool.order[j]];
+		sum += copy->id;
+	}
+	auto end = trial_end();
+	do_not_optimize(sum);
+	return elapsed_ns(start, end);
+}
+
+template<typename PoolType>
+long long run_cold_lock_test(const PoolType& pool, int ops) {
+	long long sum	= 0;
+	auto	  start = trial_begin();
+	for (int j = 0; j < ops; ++j) {
+		if (auto locked = pool.observers[pool.order[j]].lock()) {
+			sum += locked->id;
+		}
+	}
+	auto end = trial_end();
+	do_not_optimize(sum);
+	return elapsed_ns(start, end);
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_CACHE_H
@@ -0,0 +1,133 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_CONTENTION_H
+#define SMARTPOINTERS_BENCHMARK_CONTENTION_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "common_test_utils.h"
+
+
+void performance_comparison_contention_test();
+
+// Starts thread_count workers together and returns the time until the last one finished
+template<typename WorkerFunc>
+long long run_threads_timed(int thread_count, WorkerFunc worker) {
+	std::atomic<bool>		 start {false};
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count);
+	for (int t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&, t] {
+			while (!start.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			worker(t);
+		});
+	}
+
+	auto start_time = trial_begin();
+	start.store(true, std::memory_order_release);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	auto end_time = trial_end();
+	return elapsed_ns(start_time, end_time);
+}
+
+// Every thread copies and drops the same shared_ptr, all hammering one use_count
+template<typename SharedPtrType, typename MakeSharedFunc>
+long long run_contended_copy_test(int ops_per_thread, int thread_count,
+								  MakeSharedFunc make_shared_func) {
+	SharedPtrType source = make_shared_func(1);
+	return run_threads_timed(thread_count, [&](int) {
+		long long sum = 0;
+		for (int j = 0; j < ops_per_thread; ++j) {
+			SharedPtrType copy = source;
+			sum += copy->id;
+		}
+		do_not_optimize(sum);
+	});
+}
+
+// Every thread lock()s the same weak_ptr; one extra thread expires it once all are halfway
+template<typename SharedPtrType, typename WeakPtrType, typename MakeSharedFunc>
+long long run_contended_lock_expire_test(int ops_per_thread, int thread_count,
+										 MakeSharedFunc make_shared_func) {
+	SharedPtrType	 owner = make_shared_func(1);
+	WeakPtrType		 weak  = owner;
+	std::atomic<int> halfway {0};
+
+	std::thread expirer([&] {
+		while (halfway.load(std::memory_order_acquire) < thread_count) {
+			std::this_thread::yield();
+		}
+		owner.reset();
+	});
+
+	long long elapsed = run_threads_timed(thread_count, [&](int) {
+		long long sum = 0;
+		for (int j = 0; j < ops_per_thread; ++j) {
+			if (j == ops_per_thread / 2) {
+				halfway.fetch_add(1, std::memory_order_release);
+			}
+			if (SharedPtrType locked = weak.lock()) {
+				sum += locked->id;
+			}
+		}
+		do_not_optimize(sum);
+	});
+	expirer.join();
+	return elapsed;
+}
+
+// thread_count producers hand freshly made pointers to thread_count consumers through one queue
+template<typename SharedPtrType, typename MakeSharedFunc>
+long long run_queue_handoff_test(int ops_per_thread, int thread_count,
+								 MakeSharedFunc make_shared_func) {
+	std::mutex				  queue_mutex;
+	std::queue<SharedPtrType> queue;
+	std::atomic<int>		  consumed {0};
+	const int				  total = ops_per_thread * thread_count;
+
+	return run_threads_timed(thread_count * 2, [&](int t) {
+		if (t < thread_count) {
+			for (int j = 0; j < ops_per_thread; ++j) {
+				SharedPtrType item = make_shared_func(j);
+				std::lock_guard<std::mutex> lock(queue_mutex);
+				queue.push(std::move(item));
+			}
+			return;
+		}
+		long long sum = 0;
+		while (consumed.load(std::memory_order_relaxed) < total) {
+			SharedPtrType item;
+			{
+				std::lock_guard<std::mutex> lock(queue_mutex);
+				if (!queue.empty()) {
+					item = std::move(queue.front());
+					queue.pop();
+				}
+			}
+			if (!item) {
+				std::this_thread::yield();
+				continue;
+			}
+			sum += item->id;
+			consumed.fetch_add(1, std::memory_order_relaxed);
+		}
+		do_not_optimize(sum);
+	});
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_CONTENTION_H
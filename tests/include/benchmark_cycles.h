@@ -0,0 +1,95 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_CYCLES_H
+#define SMARTPOINTERS_BENCHMARK_CYCLES_H
+
+#include <memory>
+#include <type_traits>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "common_test_utils.h"
+
+void performance_comparison_cycles_test();
+
+template<bool Raw>
+struct RingNode {
+	using node_ptr =
+		std::conditional_t<Raw, raw::shared_ptr<RingNode>, std::shared_ptr<RingNode>>;
+
+	TestObject payload;
+	node_ptr   next;
+
+	explicit RingNode(int id) : payload(id) {}
+
+	// Only the raw:: node can be traced, the std:: one never is
+	void trace(raw::cycle_tracer& tracer) noexcept
+		requires Raw
+	{
+		tracer(next);
+	}
+};
+
+// Builds a ring of length nodes and returns its first node
+template<bool Raw>
+typename RingNode<Raw>::node_ptr build_ring(int length) {
+	using node = RingNode<Raw>;
+	typename node::node_ptr first;
+	if constexpr (Raw) {
+		first = raw::make_shared<node>(0);
+	} else {
+		first = std::make_shared<node>(0);
+	}
+	typename node::node_ptr last = first;
+	for (int i = 1; i < length; ++i) {
+		if constexpr (Raw) {
+			last->next = raw::make_shared<node>(i);
+		} else {
+			last->next = std::make_shared<node>(i);
+		}
+		last = last->next;
+	}
+	last->next = first;
+	return first;
+}
+
+/**
+ * @brief Times dropping rings_count rings of ring_length nodes and freeing them.
+ *
+ * The std:: side breaks each ring by hand before dropping it. The raw:: side drops the rings
+ * and leaves them to raw::collect_cycles() when RAW_CYCLE_COLLECTOR is on, and breaks them by
+ * hand as well otherwise.
+ */
+template<bool Raw>
+long long run_ring_drop_test(int rings_count, int ring_length) {
+	using node_ptr = typename RingNode<Raw>::node_ptr;
+
+	std::unique_ptr<node_ptr[]> rings(new node_ptr[rings_count]);
+	for (int i = 0; i < rings_count; ++i) {
+		rings[i] = build_ring<Raw>(ring_length);
+	}
+
+	auto start = trial_begin();
+#ifdef RAW_CYCLE_COLLECTOR
+	constexpr bool collected = Raw;
+#else
+	constexpr bool collected = false;
+#endif
+	for (int i = 0; i < rings_count; ++i) {
+		if constexpr (!collected) {
+			rings[i]->next.reset();
+		}
+		rings[i].reset();
+	}
+#ifdef RAW_CYCLE_COLLECTOR
+	if constexpr (collected) {
+		raw::collect_cycles();
+	}
+#endif
+	auto end = trial_end();
+	return elapsed_ns(start, end);
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_CYCLES_H
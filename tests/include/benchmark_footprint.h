@@ -0,0 +1,69 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_FOOTPRINT_H
+#define SMARTPOINTERS_BENCHMARK_FOOTPRINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "alloc_counter.h"
+#include "common_test_utils.h"
+
+void performance_comparison_footprint_test();
+
+// Payload of exactly Size bytes
+template<size_t Size>
+struct FootprintObject {
+	std::byte bytes[Size];
+};
+
+template<size_t Size>
+struct IntrusiveFootprintObject
+	: public raw::intrusive_ref_counter<IntrusiveFootprintObject<Size>> {
+	std::byte bytes[Size];
+};
+
+// Resident set size of the process, 0 where /proc/self/statm is not available
+long long resident_bytes();
+
+// Returns freed heap pages to the OS so RSS growth afterwards reflects new allocations only
+void release_free_heap();
+
+struct FootprintSample {
+	// From the counting allocator (malloc_usable_size), negative if counting is compiled out
+	double heap_bytes_per_object;
+	double rss_bytes_per_object;
+};
+
+/**
+ * @brief Keeps object_count pointers from make_ptr alive at once and measures their heap cost.
+ *
+ * The handles themselves live in a vector that is resident before the first sample, so the
+ * numbers cover only what each pointer allocates; add sizeof(PtrType) for the full cost.
+ */
+template<typename PtrType, typename MakePtrFunc>
+FootprintSample measure_footprint(int object_count, MakePtrFunc make_ptr) {
+	std::vector<PtrType> ptrs(object_count);
+	release_free_heap();
+
+	int64_t	  heap_before = alloc_thread_live_bytes();
+	long long rss_before  = resident_bytes();
+	for (int i = 0; i < object_count; ++i) {
+		ptrs[i] = make_ptr();
+	}
+	int64_t	  heap_after = alloc_thread_live_bytes();
+	long long rss_after	 = resident_bytes();
+
+	FootprintSample sample;
+	sample.heap_bytes_per_object =
+		alloc_counting_enabled() ? static_cast<double>(heap_after - heap_before) / object_count
+								 : -1.0;
+	sample.rss_bytes_per_object = static_cast<double>(rss_after - rss_before) / object_count;
+	return sample;
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_FOOTPRINT_H
@@ -0,0 +1,133 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_HARNESS_H
+#define SMARTPOINTERS_BENCHMARK_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "benchmark_report.h"
+#include "common_test_utils.h"
+
+// Monotonic clock used by every benchmark, timings are reported in nanoseconds
+using benchmark_clock = std::chrono::steady_clock;
+
+inline long long elapsed_ns(benchmark_clock::time_point start, benchmark_clock::time_point end) {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// Bracket the measured part of a trial; hardware counters, if enabled, only run in between.
+// With RAW_BENCH_CACHE_FLUSH set, trial_begin() flushes the data caches before starting the clock
+benchmark_clock::time_point trial_begin();
+benchmark_clock::time_point trial_end();
+
+// Forces value to be materialized without the cost of a volatile store
+template<typename T>
+inline void do_not_optimize(const T& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template<typename T>
+inline void do_not_optimize(T& value) {
+	asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+// Makes the compiler assume all memory was read and written
+inline void clobber_memory() {
+	asm volatile("" : : : "memory");
+}
+
+/**
+ * @brief Knobs shared by every benchmark scenario.
+ *
+ * Defaults can be overridden through RAW_BENCH_WARMUP, RAW_BENCH_OUTLIER_IQR,
+ * RAW_BENCH_PIN_CPU, RAW_BENCH_PERF, RAW_BENCH_PERF_RAW, RAW_BENCH_TRACE_SEED,
+ * RAW_BENCH_TRACE_DIR, RAW_BENCH_RECORDING, RAW_BENCH_CACHE_FLUSH and
+ * RAW_BENCH_MAX_WORKING_SET_MB in the environment.
+ */
+struct HarnessConfig {
+	// Trials of each side that run before measuring and are thrown away
+	int warmup_trials = 2;
+	// Samples outside [Q1 - k * IQR, Q3 + k * IQR] are left out of the mean and median, 0 keeps
+	// everything. Min, max and the percentiles always see every sample.
+	double outlier_iqr_factor = 1.5;
+	// CPU that single-threaded suites pin to, -1 leaves scheduling alone
+	int pin_cpu = -1;
+	// Collect hardware counters (RAW_BENCH_PERF=1) and the optional raw event code to add
+	bool	 perf_counters	 = false;
+	uint64_t perf_raw_config = 0;
+	// Seed of the combined stress traces and the directory they are replayed from / saved to
+	uint64_t	trace_seed = 0x5241575452414345;
+	std::string trace_dir;
+	// Operation recording (see raw::op_recorder) the recorded workload suite replays
+	std::string recording_path;
+	// Start every measured trial with cold caches, and the largest working set the cache suite
+	// sweeps to (4x LLC unless this is smaller)
+	bool   flush_caches			 = false;
+	size_t max_working_set_bytes = size_t(256) << 20;
+};
+
+HarnessConfig& harness_config();
+
+// Per-core L1 data and L2 caches and the last level cache, in bytes
+struct CacheSizes {
+	size_t l1d = 32 * 1024;
+	size_t l2  = 1024 * 1024;
+	size_t llc = 8 * 1024 * 1024;
+};
+
+// Read from sysfs on Linux; a level that cannot be read keeps its default
+const CacheSizes& cache_sizes();
+
+// Evicts everything earlier trials left in the caches by writing a buffer of twice the LLC size
+void flush_data_caches();
+
+// Pins the calling thread to one CPU while alive and restores the old mask afterwards
+class ScopedCpuPin {
+private:
+	bool pinned = false;
+#ifdef __linux__
+	cpu_set_t saved_mask;
+#endif
+
+public:
+	explicit ScopedCpuPin(int cpu);
+	~ScopedCpuPin();
+
+	ScopedCpuPin(const ScopedCpuPin&)			 = delete;
+	ScopedCpuPin& operator=(const ScopedCpuPin&) = delete;
+
+	[[nodiscard]] bool active() const {
+		return pinned;
+	}
+};
+
+// Per-op nanosecond statistics, mean and median after outlier rejection
+BenchmarkStats compute_stats(std::vector<double> per_op_ns);
+
+void		print_table_header();
+void		print_table_header(const std::string& std_label, const std::string& raw_label);
+void		print_table_row(const std::string& scenario_name, const TestResults& results,
+							int initial_active_objects, int final_active_objects);
+
+/**
+ * @brief Runs warmup, then num_trials interleaved trials of each side.
+ * @param std_func, raw_func run operations_per_trial operations and return the elapsed ns.
+ */
+TestResults run_benchmark_scenario(const std::string& scenario_name, int num_trials,
+								   int operations_per_trial, std::function<long long(int)> std_func,
+								   std::function<long long(int)> raw_func);
+
+// 1, 2, 4, ... up to the number of hardware threads (always including that number itself)
+std::vector<int> benchmark_thread_counts();
+
+#endif // SMARTPOINTERS_BENCHMARK_HARNESS_H
@@ -0,0 +1,68 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_HAZARD_H
+#define SMARTPOINTERS_BENCHMARK_HAZARD_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "common_test_utils.h"
+
+
+void performance_comparison_hazard_test();
+
+struct LockReader {
+	static inline int read(const raw::weak_ptr<ConcurrentTestObject>& weak) {
+		raw::shared_ptr<ConcurrentTestObject> locked = weak.lock();
+		return locked ? locked->id : 0;
+	}
+};
+
+struct ProtectReader {
+	static inline int read(const raw::weak_ptr<ConcurrentTestObject>& weak) {
+		raw::hazard_guard<ConcurrentTestObject> guard = weak.protect();
+		return guard ? guard->id : 0;
+	}
+};
+
+// reader_count threads each read the same object reads_per_thread times through their own
+// weak_ptr, so every lock() bumps the one shared use_count
+template<typename Reader>
+long long run_weak_readers_test(int reads_per_thread, int reader_count) {
+	raw::shared_ptr<ConcurrentTestObject> owner = raw::make_shared<ConcurrentTestObject>(1);
+	std::vector<raw::weak_ptr<ConcurrentTestObject>> observers(reader_count, owner);
+
+	std::atomic<bool> start {false};
+
+	std::vector<std::thread> readers;
+	readers.reserve(reader_count);
+	for (int t = 0; t < reader_count; ++t) {
+		readers.emplace_back([&, t] {
+			while (!start.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			long long sum = 0;
+			for (int j = 0; j < reads_per_thread; ++j) {
+				sum += Reader::read(observers[t]);
+			}
+			do_not_optimize(sum);
+		});
+	}
+
+	auto start_time = trial_begin();
+	start.store(true, std::memory_order_release);
+	for (std::thread& reader : readers) {
+		reader.join();
+	}
+	auto end_time = trial_end();
+	return elapsed_ns(start_time, end_time);
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_HAZARD_H
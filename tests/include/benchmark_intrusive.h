@@ -0,0 +1,82 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_INTRUSIVE_H
+#define SMARTPOINTERS_BENCHMARK_INTRUSIVE_H
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "common_test_utils.h"
+
+
+void performance_comparison_intrusive_test();
+
+struct SharedGraphNode {
+	int								 value = 0;
+	raw::shared_ptr<SharedGraphNode> next;
+};
+
+struct IntrusiveGraphNode : public raw::intrusive_ref_counter<IntrusiveGraphNode> {
+	int									value = 0;
+	raw::intrusive_ptr<IntrusiveGraphNode> next;
+};
+
+// Every node is owned by the returned vector and by its predecessor
+template<typename PtrType, typename MakeNodeFunc>
+std::vector<PtrType> build_linked_graph(int node_count, MakeNodeFunc make_node_func) {
+	std::vector<PtrType> nodes;
+	nodes.reserve(node_count);
+	for (int j = 0; j < node_count; ++j) {
+		nodes.push_back(make_node_func(j));
+		if (j > 0) {
+			nodes[j - 1]->next = nodes[j];
+		}
+	}
+	return nodes;
+}
+
+template<typename PtrType, typename MakeNodeFunc>
+long long run_graph_copy_test(int node_count, MakeNodeFunc make_node_func) {
+	std::vector<PtrType> nodes = build_linked_graph<PtrType>(node_count, make_node_func);
+	std::vector<PtrType> copies;
+	copies.reserve(node_count);
+
+	auto start = trial_begin();
+	for (int j = 0; j < node_count; ++j) {
+		copies.push_back(nodes[j]);
+	}
+	auto end = trial_end();
+	return elapsed_ns(start, end);
+}
+
+template<typename PtrType, typename MakeNodeFunc>
+long long run_graph_destroy_test(int node_count, MakeNodeFunc make_node_func) {
+	std::vector<PtrType> nodes = build_linked_graph<PtrType>(node_count, make_node_func);
+
+	auto start = trial_begin();
+	nodes.clear();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
+}
+
+template<typename PtrType, typename MakeNodeFunc>
+long long run_graph_traversal_test(int node_count, MakeNodeFunc make_node_func) {
+	std::vector<PtrType> nodes = build_linked_graph<PtrType>(node_count, make_node_func);
+
+	auto start = trial_begin();
+	long long sum = 0;
+	for (auto* node = nodes.front().get(); node != nullptr; node = node->next.get()) {
+		sum += node->value;
+	}
+	do_not_optimize(sum);
+	auto end = trial_end();
+	return elapsed_ns(start, end);
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_INTRUSIVE_H
@@ -0,0 +1,60 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_PARALLEL_H
+#define SMARTPOINTERS_BENCHMARK_PARALLEL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "common_test_utils.h"
+
+void performance_comparison_parallel_test();
+
+// One slot of an in-memory index, non-trivial to build and to destroy
+struct IndexEntry {
+	uint64_t	key	 = 0;
+	uint32_t	next = ~0u;
+	std::string label;
+};
+
+/**
+ * @brief Times building an array of element_count entries, or dropping it with drop set.
+ *
+ * The std side always runs on the calling thread; the raw side builds and destroys across
+ * threads (raw::parallel(1) is the serial raw factory).
+ */
+template<bool Raw>
+long long run_huge_array_test(int element_count, size_t threads, bool drop) {
+	using array_ptr =
+		std::conditional_t<Raw, raw::shared_ptr<IndexEntry[]>, std::shared_ptr<IndexEntry[]>>;
+
+	auto build = [&] {
+		if constexpr (Raw) {
+			return raw::make_shared<IndexEntry[]>(raw::parallel(threads), element_count);
+		} else {
+			return std::make_shared<IndexEntry[]>(element_count);
+		}
+	};
+
+	if (drop) {
+		array_ptr array = build();
+		do_not_optimize(array[element_count - 1].next);
+		auto start = trial_begin();
+		array.reset();
+		auto end = trial_end();
+		return elapsed_ns(start, end);
+	}
+	auto	  start = trial_begin();
+	array_ptr array = build();
+	auto	  end	= trial_end();
+	do_not_optimize(array[element_count - 1].next);
+	return elapsed_ns(start, end);
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_PARALLEL_H
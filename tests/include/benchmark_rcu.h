@@ -0,0 +1,28 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_RCU_H
+#define SMARTPOINTERS_BENCHMARK_RCU_H
+
+#include "benchmark_atomic.h"
+
+void performance_comparison_rcu_test();
+
+struct RcuSnapshotSlot {
+	using pointer_type = raw::unique_ptr<ConcurrentTestObject>;
+
+	raw::rcu_ptr<ConcurrentTestObject> current;
+
+	static pointer_type make(int version) {
+		return raw::make_unique<ConcurrentTestObject>(version);
+	}
+	raw::rcu_read_guard<ConcurrentTestObject> load() const {
+		return current.read();
+	}
+	void store(pointer_type next) {
+		current.publish(std::move(next));
+	}
+};
+
+#endif // SMARTPOINTERS_BENCHMARK_RCU_H
@@ -0,0 +1,90 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_RECLAIM_H
+#define SMARTPOINTERS_BENCHMARK_RECLAIM_H
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "benchmark_workload.h"
+#include "common_test_utils.h"
+
+void performance_comparison_reclaim_test();
+
+struct SnapshotWorkload {
+	int requests;
+	// Every swap_every-th request replaces the shared snapshot, dropping the old one's last owner
+	int swap_every;
+	int snapshot_nodes;
+	// Nodes of the graph every request builds and drops for its response
+	int response_nodes;
+};
+
+/**
+ * @brief Latency of each request of a handler that reads a large shared snapshot.
+ *
+ * New snapshots are built outside the timed part, as if by another component; installing one
+ * is timed, so with inline reclamation the request that drops the old snapshot pays for its
+ * whole destructor cascade. With deferred set (raw:: side only) the snapshots opt in to
+ * deferred_deleter, and if no reclaimer thread runs the queue is drained between requests.
+ */
+template<typename Family>
+std::vector<double> run_snapshot_requests(const SnapshotWorkload& workload, bool deferred) {
+	using node_ptr = typename Family::template shared_ptr<WorkloadTreeNode<Family>>;
+
+	auto build_snapshot = [&] {
+		node_ptr snapshot = build_workload_tree<Family>(0, workload.snapshot_nodes);
+#ifdef RAW_DEFERRED_RECLAIM
+		if constexpr (std::is_same_v<Family, RawPointerFamily>) {
+			if (deferred) {
+				snapshot.defer_reclamation();
+			}
+		}
+#endif
+		return snapshot;
+	};
+
+	std::vector<double> latencies;
+	latencies.reserve(workload.requests);
+	node_ptr  snapshot = build_snapshot();
+	long long sum	   = 0;
+	for (int request = 0; request < workload.requests; ++request) {
+		node_ptr next;
+		if (request % workload.swap_every == workload.swap_every - 1) {
+			next = build_snapshot();
+		}
+
+		auto	 start	  = benchmark_clock::now();
+		node_ptr response = build_workload_tree<Family>(0, workload.response_nodes);
+		sum += snapshot->payload.id + response->payload.id;
+		response.reset();
+		if (next) {
+			snapshot = std::move(next);
+		}
+		auto end = benchmark_clock::now();
+		latencies.push_back(static_cast<double>(elapsed_ns(start, end)));
+
+#ifdef RAW_DEFERRED_RECLAIM
+		if (deferred && !raw::deferred_deleter::running()) {
+			raw::drain_reclamation();
+		}
+#endif
+	}
+	snapshot.reset();
+#ifdef RAW_DEFERRED_RECLAIM
+	if (deferred) {
+		raw::drain_reclamation();
+	}
+#else
+	(void)deferred;
+#endif
+	do_not_optimize(sum);
+	return latencies;
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_RECLAIM_H
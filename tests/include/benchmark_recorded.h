@@ -0,0 +1,138 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_RECORDED_H
+#define SMARTPOINTERS_BENCHMARK_RECORDED_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "benchmark_trace.h"
+#include "common_test_utils.h"
+
+void performance_comparison_recorded_test();
+
+// Handles the replay keeps for one recorded object
+template<typename SharedPtrType, typename WeakPtrType, typename UniquePtrType>
+struct ReplaySlot {
+	std::vector<SharedPtrType> owners;
+	std::vector<WeakPtrType>   observers;
+	UniquePtrType			   unique;
+};
+
+/**
+ * @brief Replays a trace of raw::recorded_op steps against one pointer family.
+ *
+ * Each slot stands for one recorded object. Steps that make no sense for the slot's current
+ * state (a copy with no owner left, say) are skipped, so synthetic traces replay as well.
+ */
+template<typename SharedPtrType, typename WeakPtrType, typename UniquePtrType,
+		 typename MakeSharedFunc, typename MakeUniqueFunc>
+long long run_recorded_replay_test(const OpTrace& trace, MakeSharedFunc make_shared_func,
+								   MakeUniqueFunc make_unique_func) {
+	using slot_type = ReplaySlot<SharedPtrType, WeakPtrType, UniquePtrType>;
+
+	// Capacity for every handle a slot can ever hold, nothing reallocates while timing
+	std::vector<uint32_t> owner_bound(trace.pool_size, 0);
+	std::vector<uint32_t> observer_bound(trace.pool_size, 0);
+	for (const TraceOp& step : trace.ops) {
+		switch (static_cast<raw::recorded_op>(step.op)) {
+		case raw::recorded_op::shared_make:
+		case raw::recorded_op::shared_copy:
+		case raw::recorded_op::weak_lock:
+			++owner_bound[step.idx1];
+			break;
+		case raw::recorded_op::weak_copy:
+			++observer_bound[step.idx1];
+			break;
+		default:
+			break;
+		}
+	}
+	std::vector<slot_type> slots(trace.pool_size);
+	for (size_t i = 0; i < slots.size(); ++i) {
+		slots[i].owners.reserve(owner_bound[i]);
+		slots[i].observers.reserve(observer_bound[i]);
+	}
+
+	auto start = trial_begin();
+	for (const TraceOp& step : trace.ops) {
+		slot_type& slot = slots[step.idx1];
+		switch (static_cast<raw::recorded_op>(step.op)) {
+		case raw::recorded_op::shared_make:
+			slot.owners.push_back(make_shared_func(static_cast<int>(step.value)));
+			break;
+		case raw::recorded_op::shared_copy:
+			if (!slot.owners.empty()) {
+				slot.owners.push_back(slot.owners.back());
+			}
+			break;
+		case raw::recorded_op::shared_move:
+			if (!slot.owners.empty()) {
+				SharedPtrType moved(std::move(slot.owners.back()));
+				slot.owners.back() = std::move(moved);
+			}
+			break;
+		case raw::recorded_op::shared_destroy:
+			if (!slot.owners.empty()) {
+				slot.owners.pop_back();
+			}
+			break;
+		case raw::recorded_op::weak_copy:
+			if (!slot.owners.empty()) {
+				slot.observers.push_back(WeakPtrType(slot.owners.back()));
+			} else if (!slot.observers.empty()) {
+				slot.observers.push_back(slot.observers.back());
+			}
+			break;
+		case raw::recorded_op::weak_move:
+			if (!slot.observers.empty()) {
+				WeakPtrType moved(std::move(slot.observers.back()));
+				slot.observers.back() = std::move(moved);
+			}
+			break;
+		case raw::recorded_op::weak_destroy:
+			if (!slot.observers.empty()) {
+				slot.observers.pop_back();
+			}
+			break;
+		case raw::recorded_op::weak_lock:
+		case raw::recorded_op::weak_lock_failed:
+			if (!slot.observers.empty()) {
+				SharedPtrType locked = slot.observers.back().lock();
+				do_not_optimize(locked ? locked->id : -1);
+				// A successful lock is a new owner, its release is recorded as shared_destroy
+				if (locked && step.op == static_cast<uint8_t>(raw::recorded_op::weak_lock)) {
+					slot.owners.push_back(std::move(locked));
+				}
+			}
+			break;
+		case raw::recorded_op::unique_make:
+			slot.unique = make_unique_func(static_cast<int>(step.value));
+			break;
+		case raw::recorded_op::unique_move:
+			if (slot.unique) {
+				UniquePtrType moved(std::move(slot.unique));
+				slot.unique = std::move(moved);
+			}
+			break;
+		case raw::recorded_op::unique_destroy:
+			slot.unique.reset();
+			break;
+		case raw::recorded_op::unique_release:
+			// Whoever took the object over deletes it, the replay does so right away
+			delete slot.unique.release();
+			break;
+		default:
+			break;
+		}
+	}
+	auto end = trial_end();
+	return elapsed_ns(start, end);
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_RECORDED_H
@@ -0,0 +1,49 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_REPORT_H
+#define SMARTPOINTERS_BENCHMARK_REPORT_H
+
+#include <string>
+
+#include "common_test_utils.h"
+
+/**
+ * @brief Where the machine-readable copies of the benchmark tables go.
+ *
+ * Every row printed by print_table_row() is also collected here. finish_report() writes the
+ * collected rows (plus compiler, flags and CPU model) as JSON and/or CSV and compares the RAW
+ * medians against a baseline CSV written by an earlier run.
+ */
+struct ReportOptions {
+	// Empty paths disable the corresponding output
+	std::string json_path;
+	std::string csv_path;
+	std::string baseline_path;
+	// A RAW median slower than the baseline by more than this many percent is a regression
+	double regression_threshold_percent = 5.0;
+};
+
+ReportOptions& report_options();
+
+/**
+ * @brief Reads --json=, --csv=, --baseline= and --threshold= into report_options().
+ * @return false (after printing usage) on an unknown or malformed argument.
+ */
+bool parse_report_args(int argc, char* argv[]);
+
+// Rows recorded after this call are tagged with suite, scenario names are only unique per suite
+void begin_report_suite(const std::string& suite);
+void set_report_labels(const std::string& std_label, const std::string& raw_label);
+void record_report_row(const std::string& scenario_name, const TestResults& results,
+					   int initial_active_objects, int final_active_objects);
+
+/**
+ * @brief Writes the requested outputs and runs the baseline comparison.
+ * @return false if an output could not be written, the baseline could not be read or a
+ * scenario regressed.
+ */
+bool finish_report();
+
+#endif // SMARTPOINTERS_BENCHMARK_REPORT_H
@@ -10,32 +10,25 @@
 #include <vector>
 
 #include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "benchmark_trace.h"
 #include "common_test_utils.h"
 
-void		calculate_stats(const std::vector<long long>& durations, long long& min_val,
-							long long& max_val, long long& avg_val);
-void		print_table_header();
-void		print_table_row(const std::string& scenario_name, const TestResults& results,
-							int initial_active_objects, int final_active_objects);
-TestResults run_benchmark_scenario(const std::string& scenario_name, int num_trials,
-								   int operations_per_trial, std::function<long long(int)> std_func,
-								   std::function<long long(int)> raw_func);
 
-long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_pointers_in_pool);
+long long run_combined_stress_impl_shared(bool use_raw, const OpTrace& trace);
 void	  performance_comparison_shared_test();
 
 template<typename SharedPtrType, typename MakeSharedFunc>
 long long run_shared_single_obj_creation_test(int			 operations_per_trial,
 											  MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType ptr_local = make_shared_func(j);
-		volatile int  dummy_val = ptr_local ? ptr_local->id : -1;
-		(void)dummy_val;
+		do_not_optimize(ptr_local ? ptr_local->id : -1);
 		ptr_local.reset();
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrArrayType, typename MakeSharedArrayFunc>
@@ -45,18 +38,17 @@ long long run_shared_array_creation_test(int				 operations_per_trial,
 	std::mt19937					gen(rd());
 	std::uniform_int_distribution<> dist_array_size(1, 10);
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		size_t			   current_array_size = dist_array_size(gen);
 		SharedPtrArrayType ptr_local		  = make_shared_array_func(current_array_size);
 		if (ptr_local && current_array_size > 0) {
-			volatile int dummy_val = ptr_local[current_array_size / 2].id;
-			(void)dummy_val;
+			do_not_optimize(ptr_local[current_array_size / 2].id);
 		}
 		ptr_local.reset();
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrType, typename MakeSharedFunc>
@@ -67,12 +59,12 @@ long long run_shared_reset_single_test(int operations_per_trial, MakeSharedFunc
 		ptrs.push_back(make_shared_func(j));
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		ptrs[j] = nullptr;
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrArrayType, typename MakeSharedArrayFunc>
@@ -88,41 +80,39 @@ long long run_shared_reset_array_test(int				  operations_per_trial,
 		ptrs.push_back(make_shared_array_func(dist_array_size(gen)));
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		ptrs[j] = nullptr;
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrType, typename MakeSharedFunc>
 long long run_shared_move_construct_single_test(int			   operations_per_trial,
 												MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType src_ptr = make_shared_func(j);
 		SharedPtrType dest_ptr(std::move(src_ptr));
-		volatile int  dummy_val = dest_ptr ? dest_ptr->id : -1;
-		(void)dummy_val;
+		do_not_optimize(dest_ptr ? dest_ptr->id : -1);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrType, typename MakeSharedFunc>
 long long run_shared_move_assign_single_test(int			operations_per_trial,
 											 MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType src_ptr  = make_shared_func(j);
 		SharedPtrType dest_ptr = make_shared_func(j + 1000);
 		dest_ptr			   = std::move(src_ptr);
-		volatile int dummy_val = dest_ptr ? dest_ptr->id : -1;
-		(void)dummy_val;
+		do_not_optimize(dest_ptr ? dest_ptr->id : -1);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrArrayType, typename MakeSharedArrayFunc>
@@ -132,7 +122,7 @@ long long run_shared_move_assign_array_test(int					operations_per_trial,
 	std::mt19937					gen(rd());
 	std::uniform_int_distribution<> dist_array_size(1, 10);
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		size_t			   current_array_size_src  = dist_array_size(gen);
 		size_t			   current_array_size_dest = dist_array_size(gen);
@@ -140,12 +130,11 @@ long long run_shared_move_assign_array_test(int					operations_per_trial,
 		SharedPtrArrayType dest_ptr = make_shared_array_func(current_array_size_dest);
 		dest_ptr					= std::move(src_ptr);
 		if (dest_ptr && current_array_size_src > 0) {
-			volatile int dummy_val = dest_ptr[0].id;
-			(void)dummy_val;
+			do_not_optimize(dest_ptr[0].id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrType, typename MakeSharedFunc>
@@ -156,14 +145,13 @@ long long run_shared_access_single_test(int operations_per_trial, MakeSharedFunc
 		ptrs.push_back(make_shared_func(j));
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
-		volatile int val = ptrs[j]->id;
-		(void)val;
+		do_not_optimize(ptrs[j]->id);
 		(void)ptrs[j].get();
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrArrayType, typename MakeSharedArrayFunc>
@@ -183,30 +171,28 @@ long long run_shared_access_array_element_test(int				   operations_per_trial,
 		sizes.push_back(current_size);
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		if (ptrs[j] && sizes[j] > 0) {
-			size_t		 elem_idx = std::uniform_int_distribution<size_t>(0, sizes[j] - 1)(gen);
-			volatile int val	  = ptrs[j][elem_idx].id;
-			(void)val;
+			size_t elem_idx = std::uniform_int_distribution<size_t>(0, sizes[j] - 1)(gen);
+			do_not_optimize(ptrs[j][elem_idx].id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrType, typename MakeSharedFunc>
 long long run_shared_copy_construct_single_test(int			   operations_per_trial,
 												MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType src_ptr = make_shared_func(j);
 		SharedPtrType dest_ptr(src_ptr);
-		volatile int  dummy_val = dest_ptr ? dest_ptr->id : -1;
-		(void)dummy_val;
+		do_not_optimize(dest_ptr ? dest_ptr->id : -1);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrType, typename MakeSharedFunc>
@@ -223,12 +209,12 @@ long long run_shared_copy_assign_single_test(int			operations_per_trial,
 		dest_ptrs.emplace_back(nullptr);
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		dest_ptrs[j] = src_ptrs[j];
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrArrayType, typename MakeSharedArrayFunc>
@@ -249,12 +235,12 @@ long long run_shared_copy_assign_array_test(int					operations_per_trial,
 		dest_ptrs.emplace_back(nullptr);
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		dest_ptrs[j] = src_ptrs[j];
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrType, typename MakeSharedFunc>
@@ -262,14 +248,14 @@ long long run_shared_use_count_test(int operations_per_trial, MakeSharedFunc mak
 	SharedPtrType p_main = make_shared_func(0);
 	SharedPtrType p_copy = p_main;
 
-	volatile size_t total_count = 0;
-	auto			start		= std::chrono::high_resolution_clock::now();
+	size_t total_count = 0;
+	auto   start	   = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		total_count += p_main.use_count();
+		do_not_optimize(total_count);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	(void)total_count;
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename SharedPtrType, typename MakeSharedFunc>
@@ -277,16 +263,16 @@ long long run_shared_unique_test(int operations_per_trial, MakeSharedFunc make_s
 	SharedPtrType p_main = make_shared_func(0);
 	SharedPtrType p_copy = p_main;
 
-	volatile int unique_count = 0;
-	auto		 start		  = std::chrono::high_resolution_clock::now();
+	int	 unique_count = 0;
+	auto start		  = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		if (p_main.unique()) {
 			unique_count++;
 		}
+		do_not_optimize(unique_count);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	(void)unique_count;
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 #endif // SMARTPOINTERS_BENCHMARK_SHARED_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_TEARDOWN_H
+#define SMARTPOINTERS_BENCHMARK_TEARDOWN_H
+
+#include <type_traits>
+#include <utility>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "benchmark_workload.h"
+#include "common_test_utils.h"
+
+void performance_comparison_teardown_test();
+
+// Every node owns the next one, so dropping the head releases the whole chain
+template<typename Family>
+struct SharedChainNode {
+	TestObject											  payload;
+	typename Family::template shared_ptr<SharedChainNode> next;
+
+	explicit SharedChainNode(int value) : payload(value) {}
+};
+
+template<typename Family>
+struct UniqueChainNode {
+	TestObject											  payload;
+	typename Family::template unique_ptr<UniqueChainNode> next;
+
+	explicit UniqueChainNode(int value) : payload(value) {}
+};
+
+/**
+ * @brief Builds a chain of node_count nodes and times dropping its head.
+ *
+ * Without RAW_ITERATIVE_TEARDOWN (and always on the std side) every node is destroyed from
+ * inside its owner's destructor, so the chain length is limited by the stack.
+ */
+template<typename Family, template<typename> class Node>
+long long run_chain_drop_test(int node_count) {
+	using node_ptr = decltype(std::declval<Node<Family>&>().next);
+	node_ptr head;
+	for (int i = 0; i < node_count; ++i) {
+		node_ptr node;
+		if constexpr (std::is_same_v<Node<Family>, SharedChainNode<Family>>) {
+			node = Family::template make_shared<Node<Family>>(i);
+		} else {
+			node = Family::template make_unique<Node<Family>>(i);
+		}
+		node->next = std::move(head);
+		head	   = std::move(node);
+	}
+
+	auto start = trial_begin();
+	head.reset();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
+}
+
+// Drops a complete binary tree, the case where the worklist holds more than one node
+template<typename Family>
+long long run_tree_drop_test(int node_count) {
+	auto root = build_workload_tree<Family>(0, node_count);
+
+	auto start = trial_begin();
+	root.reset();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_TEARDOWN_H
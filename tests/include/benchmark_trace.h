@@ -0,0 +1,70 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_TRACE_H
+#define SMARTPOINTERS_BENCHMARK_TRACE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One step of a combined stress workload.
+ *
+ * Every random draw a step may need is made up front, so replaying a trace costs a few loads and
+ * the std and raw sides execute exactly the same sequence. What op means is up to the suite that
+ * replays it (the case labels of its stress switch).
+ */
+struct TraceOp {
+	uint8_t op;
+	// Length of an array the step creates, 1..10
+	uint8_t array_size;
+	// Uniform in [0, 100), decides the optional side operations of a step
+	uint8_t chance;
+	// Element of the touched array, taken modulo its current length
+	uint8_t	 element;
+	uint32_t idx1;
+	uint32_t idx2;
+	uint32_t value;
+};
+
+static_assert(sizeof(TraceOp) == 16, "TraceOp is written to trace files as is");
+
+struct OpTrace {
+	// Pointer slots the indices refer to and the number of distinct op codes
+	uint32_t			 pool_size = 0;
+	uint32_t			 op_kinds  = 0;
+	std::vector<TraceOp> ops;
+};
+
+// length steps drawn from an mt19937_64 seeded with seed
+OpTrace generate_op_trace(uint32_t op_kinds, uint32_t pool_size, int length, uint64_t seed);
+
+/**
+ * @brief Binary trace files: a 32 byte header followed by the TraceOp records in host byte order.
+ * @return false if the file could not be written, or could not be read or is not a valid trace.
+ */
+bool save_op_trace(const OpTrace& trace, const std::string& path);
+bool load_op_trace(const std::string& path, OpTrace& trace);
+
+/**
+ * @brief Turns a raw::op_recorder recording into a trace for the recorded workload suite.
+ *
+ * Events are put in timestamp order and every recorded object gets its own slot, so op is a
+ * raw::recorded_op, idx1 == idx2 is the slot and value the recording thread.
+ * @return false if path is not a recording or holds no events.
+ */
+bool load_recording(const std::string& path, OpTrace& trace);
+
+/**
+ * @brief The trace a combined stress scenario replays.
+ *
+ * Generated from harness_config().trace_seed mixed with name, so every run measures the same
+ * workload. With RAW_BENCH_TRACE_DIR set, <dir>/<name>.trace is replayed when it exists and
+ * written otherwise; a recorded trace dropped there replaces the synthetic one.
+ */
+const OpTrace& stress_trace(const std::string& name, uint32_t op_kinds, uint32_t pool_size,
+							int length);
+
+#endif // SMARTPOINTERS_BENCHMARK_TRACE_H
@@ -13,29 +13,22 @@
 #include <vector>
 
 #include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "benchmark_trace.h"
 #include "common_test_utils.h"
 
-void		calculate_stats(const std::vector<long long>& durations, long long& min_val,
-							long long& max_val, long long& avg_val);
-void		print_table_header();
-void		print_table_row(const std::string& scenario_name, const TestResults& results,
-							int initial_active_objects, int final_active_objects);
-TestResults run_benchmark_scenario(const std::string& scenario_name, int num_trials,
-								   int operations_per_trial, std::function<long long(int)> std_func,
-								   std::function<long long(int)> raw_func);
-long long	run_combined_stress_impl(bool use_raw, int iterations, int max_pointers_in_pool);
+long long	run_combined_stress_impl(bool use_raw, const OpTrace& trace);
 void		performance_comparison_unique_test();
 
 template<typename UniquePtrType, typename MakeUniqueFunc>
 long long run_single_obj_creation_test(int operations_per_trial, MakeUniqueFunc make_unique_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
-		UniquePtrType ptr		= make_unique_func(j);
-		volatile int  dummy_val = ptr ? ptr->id : -1;
-		(void)dummy_val;
+		UniquePtrType ptr = make_unique_func(j);
+		do_not_optimize(ptr ? ptr->id : -1);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename UniquePtrArrayType, typename MakeUniqueArrayFunc>
@@ -45,17 +38,16 @@ long long run_array_creation_test(int				  operations_per_trial,
 	std::mt19937					gen(rd());
 	std::uniform_int_distribution<> dist_array_size(1, 10);
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		size_t			   current_array_size = dist_array_size(gen);
 		UniquePtrArrayType ptr				  = make_unique_array_func(current_array_size);
 		if (ptr && current_array_size > 0) {
-			volatile int dummy_val = ptr[0].id;
-			(void)dummy_val;
+			do_not_optimize(ptr[0].id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename UniquePtrType, typename MakeUniqueFunc>
@@ -66,12 +58,12 @@ long long run_reset_single_test(int operations_per_trial, MakeUniqueFunc make_un
 		ptrs.push_back(make_unique_func(j));
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		ptrs[j].reset();
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename UniquePtrArrayType, typename MakeUniqueArrayFunc>
@@ -87,12 +79,12 @@ long long run_reset_array_test(int				   operations_per_trial,
 		ptrs.push_back(make_unique_array_func(dist_array_size(gen)));
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		ptrs[j].reset();
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename UniquePtrType, typename MakeUniqueFunc>
@@ -106,12 +98,12 @@ long long run_move_construct_single_test(int			operations_per_trial,
 	std::vector<UniquePtrType> dest_ptrs;
 	dest_ptrs.reserve(operations_per_trial);
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		dest_ptrs.emplace_back(std::move(src_ptrs[j]));
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename UniquePtrType, typename MakeUniqueFunc>
@@ -127,12 +119,12 @@ long long run_move_assign_single_test(int operations_per_trial, MakeUniqueFunc m
 		dest_ptrs.emplace_back(nullptr);
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		dest_ptrs[j] = std::move(src_ptrs[j]);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename UniquePtrArrayType, typename MakeUniqueArrayFunc>
@@ -153,12 +145,12 @@ long long run_move_assign_array_test(int				 operations_per_trial,
 		dest_ptrs.emplace_back(nullptr);
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		dest_ptrs[j] = std::move(src_ptrs[j]);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename UniquePtrType, typename MakeUniqueFunc>
@@ -169,14 +161,13 @@ long long run_access_single_test(int operations_per_trial, MakeUniqueFunc make_u
 		ptrs.push_back(make_unique_func(j));
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
-		volatile int val = ptrs[j]->id;
-		(void)val;
+		do_not_optimize(ptrs[j]->id);
 		(void)ptrs[j].get();
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename UniquePtrArrayType, typename MakeUniqueArrayFunc>
@@ -196,15 +187,14 @@ long long run_access_array_element_test(int					operations_per_trial,
 		sizes.push_back(current_size);
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		if (ptrs[j] && sizes[j] > 0) {
-			volatile int val = ptrs[j][0].id;
-			(void)val;
+			do_not_optimize(ptrs[j][0].id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 #endif // SMARTPOINTERS_BENCHMARK_UNIQUE_H
@@ -10,18 +10,12 @@
 #include <vector>
 
 #include "../../include/raw_memory.h"
+#include "benchmark_harness.h"
+#include "benchmark_trace.h"
 #include "common_test_utils.h"
 
-void		calculate_stats(const std::vector<long long>& durations, long long& min_val,
-							long long& max_val, long long& avg_val);
-void		print_table_header();
-void		print_table_row(const std::string& scenario_name, const TestResults& results,
-							int initial_active_objects, int final_active_objects);
-TestResults run_benchmark_scenario(const std::string& scenario_name, int num_trials,
-								   int operations_per_trial, std::function<long long(int)> std_func,
-								   std::function<long long(int)> raw_func);
 
-long long run_combined_stress_impl_weak(bool use_raw, int iterations, int max_pointers_in_pool);
+long long run_combined_stress_impl_weak(bool use_raw, const OpTrace& trace);
 void	  performance_comparison_weak_test();
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
@@ -33,55 +27,50 @@ long long run_weak_from_shared_creation_test(int			operations_per_trial,
 		shared_ptrs.push_back(make_shared_func(j));
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		WeakPtrType wp_local(shared_ptrs[j]);
 		if (wp_local.lock()) {
-			volatile int id_val = wp_local.lock()->id;
-			(void)id_val;
+			do_not_optimize(wp_local.lock()->id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
 long long run_weak_copy_construct_test(int operations_per_trial, MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType sp = make_shared_func(j);
 		WeakPtrType	  src_wp(sp);
 		WeakPtrType	  dest_wp(src_wp);
 		if (dest_wp.lock()) {
-			volatile int dummy = dest_wp.lock()->id;
-			(void)dummy;
+			do_not_optimize(dest_wp.lock()->id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
 long long run_weak_move_construct_test(int operations_per_trial, MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType sp = make_shared_func(j);
 		WeakPtrType	  src_wp(sp);
 		WeakPtrType	  dest_wp(std::move(src_wp));
 		if (dest_wp.lock()) {
-			volatile int dummy = dest_wp.lock()->id;
-			(void)dummy;
+			do_not_optimize(dest_wp.lock()->id);
 		}
 	}
-	auto end = std::chrono::duration_cast<std::chrono::microseconds>(
-				   std::chrono::high_resolution_clock::now() - start)
-				   .count();
-	return end;
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
 long long run_weak_copy_assign_test(int operations_per_trial, MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType sp1 = make_shared_func(j);
 		SharedPtrType sp2 = make_shared_func(j + 1000);
@@ -89,17 +78,16 @@ long long run_weak_copy_assign_test(int operations_per_trial, MakeSharedFunc mak
 		WeakPtrType	  dest_wp(sp2);
 		dest_wp = src_wp;
 		if (dest_wp.lock()) {
-			volatile int dummy = dest_wp.lock()->id;
-			(void)dummy;
+			do_not_optimize(dest_wp.lock()->id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
 long long run_weak_move_assign_test(int operations_per_trial, MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType sp1 = make_shared_func(j);
 		SharedPtrType sp2 = make_shared_func(j + 1000);
@@ -107,47 +95,44 @@ long long run_weak_move_assign_test(int operations_per_trial, MakeSharedFunc mak
 		WeakPtrType	  dest_wp(sp2);
 		dest_wp = std::move(src_wp);
 		if (dest_wp.lock()) {
-			volatile int dummy = dest_wp.lock()->id;
-			(void)dummy;
+			do_not_optimize(dest_wp.lock()->id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
 long long run_weak_shared_assign_test(int operations_per_trial, MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType sp = make_shared_func(j);
 		WeakPtrType	  wp;
 		wp = sp;
 		if (wp.lock()) {
-			volatile int dummy = wp.lock()->id;
-			(void)dummy;
+			do_not_optimize(wp.lock()->id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
 long long run_weak_reset_test(int operations_per_trial, MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType sp = make_shared_func(j);
 		WeakPtrType	  wp(sp);
 		wp.reset();
-		volatile bool is_expired = wp.expired();
-		(void)is_expired;
+		do_not_optimize(wp.expired());
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
 long long run_weak_swap_test(int operations_per_trial, MakeSharedFunc make_shared_func) {
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		SharedPtrType sp1 = make_shared_func(j);
 		SharedPtrType sp2 = make_shared_func(j + 1000);
@@ -155,12 +140,11 @@ long long run_weak_swap_test(int operations_per_trial, MakeSharedFunc make_share
 		WeakPtrType	  wp2(sp2);
 		wp1.swap(wp2);
 		if (wp1.lock()) {
-			volatile int dummy = wp1.lock()->id;
-			(void)dummy;
+			do_not_optimize(wp1.lock()->id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
@@ -170,14 +154,14 @@ long long run_weak_use_count_test(int operations_per_trial, MakeSharedFunc make_
 	SharedPtrType p_copy2 = p_main;
 	WeakPtrType	  wp(p_main);
 
-	volatile size_t total_count = 0;
-	auto			start		= std::chrono::high_resolution_clock::now();
+	size_t total_count = 0;
+	auto   start	   = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		total_count += wp.use_count();
+		do_not_optimize(total_count);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	(void)total_count;
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
@@ -185,8 +169,8 @@ long long run_weak_expired_test(int operations_per_trial, MakeSharedFunc make_sh
 	SharedPtrType p_main = make_shared_func(0);
 	WeakPtrType	  wp(p_main);
 
-	volatile int expired_count = 0;
-	auto		 start		   = std::chrono::high_resolution_clock::now();
+	int	 expired_count = 0;
+	auto start		   = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		if (j % 2 == 0) {
 			p_main.reset();
@@ -197,10 +181,10 @@ long long run_weak_expired_test(int operations_per_trial, MakeSharedFunc make_sh
 		if (wp.expired()) {
 			expired_count++;
 		}
+		do_not_optimize(expired_count);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	(void)expired_count;
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrType, typename SharedPtrType, typename MakeSharedFunc>
@@ -208,8 +192,8 @@ long long run_weak_lock_test(int operations_per_trial, MakeSharedFunc make_share
 	SharedPtrType p_main = make_shared_func(0);
 	WeakPtrType	  wp(p_main);
 
-	volatile int dummy_sum = 0;
-	auto		 start	   = std::chrono::high_resolution_clock::now();
+	int	 dummy_sum = 0;
+	auto start	   = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		if (j % 2 == 0) {
 			p_main.reset();
@@ -221,10 +205,10 @@ long long run_weak_lock_test(int operations_per_trial, MakeSharedFunc make_share
 		if (locked_ptr) {
 			dummy_sum += locked_ptr->id;
 		}
+		do_not_optimize(dummy_sum);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	(void)dummy_sum;
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrArrayType, typename SharedPtrArrayType, typename MakeSharedArrayFunc>
@@ -234,18 +218,17 @@ long long run_weak_array_from_shared_creation_test(int				   operations_per_tria
 	std::mt19937					gen(rd());
 	std::uniform_int_distribution<> dist_array_size(1, 10);
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		size_t			   current_array_size = dist_array_size(gen);
 		SharedPtrArrayType sp				  = make_shared_array_func(current_array_size);
 		WeakPtrArrayType   wp(sp);
 		if (wp.lock() && current_array_size > 0) {
-			volatile int dummy = wp.lock()[0].id;
-			(void)dummy;
+			do_not_optimize(wp.lock()[0].id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrArrayType, typename SharedPtrArrayType, typename MakeSharedArrayFunc>
@@ -255,19 +238,18 @@ long long run_weak_array_shared_assign_test(int					operations_per_trial,
 	std::mt19937					gen(rd());
 	std::uniform_int_distribution<> dist_array_size(1, 10);
 
-	auto start = std::chrono::high_resolution_clock::now();
+	auto start = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		size_t			   current_array_size = dist_array_size(gen);
 		SharedPtrArrayType sp				  = make_shared_array_func(current_array_size);
 		WeakPtrArrayType   wp;
 		wp = sp;
 		if (wp.lock() && current_array_size > 0) {
-			volatile int dummy = wp.lock()[0].id;
-			(void)dummy;
+			do_not_optimize(wp.lock()[0].id);
 		}
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 template<typename WeakPtrArrayType, typename SharedPtrArrayType, typename MakeSharedArrayFunc>
@@ -280,8 +262,8 @@ long long run_weak_array_lock_test(int				   operations_per_trial,
 	SharedPtrArrayType p_main = make_shared_array_func(dist_array_size(gen));
 	WeakPtrArrayType   wp(p_main);
 
-	volatile int dummy_sum = 0;
-	auto		 start	   = std::chrono::high_resolution_clock::now();
+	int	 dummy_sum = 0;
+	auto start	   = trial_begin();
 	for (int j = 0; j < operations_per_trial; ++j) {
 		if (j % 2 == 0) {
 			p_main.reset();
@@ -293,10 +275,10 @@ long long run_weak_array_lock_test(int				   operations_per_trial,
 		if (locked_ptr && p_main && dist_array_size(gen) > 0) {
 			dummy_sum += locked_ptr[0].id;
 		}
+		do_not_optimize(dummy_sum);
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	(void)dummy_sum;
-	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	auto end = trial_end();
+	return elapsed_ns(start, end);
 }
 
 #endif // SMARTPOINTERS_BENCHMARK_WEAK_H
\ No newline at end of file
@@ -0,0 +1,405 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_BENCHMARK_WORKLOAD_H
+#define SMARTPOINTERS_BENCHMARK_WORKLOAD_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "benchmark_contention.h"
+#include "benchmark_harness.h"
+#include "common_test_utils.h"
+
+void performance_comparison_workload_test();
+
+// The pointer types and factories one side of a workload is built from
+struct StdPointerFamily {
+	template<typename T>
+	using shared_ptr = std::shared_ptr<T>;
+	template<typename T>
+	using weak_ptr = std::weak_ptr<T>;
+	template<typename T>
+	using unique_ptr = std::unique_ptr<T>;
+
+	template<typename T, typename... Args>
+	static shared_ptr<T> make_shared(Args&&... args) {
+		return std::make_shared<T>(std::forward<Args>(args)...);
+	}
+	template<typename T, typename... Args>
+	static unique_ptr<T> make_unique(Args&&... args) {
+		return std::make_unique<T>(std::forward<Args>(args)...);
+	}
+};
+
+struct RawPointerFamily {
+	template<typename T>
+	using shared_ptr = raw::shared_ptr<T>;
+	template<typename T>
+	using weak_ptr = raw::weak_ptr<T>;
+	template<typename T>
+	using unique_ptr = raw::unique_ptr<T>;
+
+	template<typename T, typename... Args>
+	static shared_ptr<T> make_shared(Args&&... args) {
+		return raw::make_shared<T>(std::forward<Args>(args)...);
+	}
+	template<typename T, typename... Args>
+	static unique_ptr<T> make_unique(Args&&... args) {
+		return raw::make_unique<T>(std::forward<Args>(args)...);
+	}
+};
+
+// Children are owned, the parent is only observed so the tree never keeps itself alive
+template<typename Family>
+struct WorkloadTreeNode {
+	TestObject											   payload;
+	typename Family::template shared_ptr<WorkloadTreeNode> left;
+	typename Family::template shared_ptr<WorkloadTreeNode> right;
+	typename Family::template weak_ptr<WorkloadTreeNode>   parent;
+
+	explicit WorkloadTreeNode(int value) : payload(value) {}
+};
+
+template<typename Family>
+struct WorkloadDagNode {
+	TestObject payload;
+	// Nodes with two owners are reached twice, the walk only descends the first time
+	bool															   visited = false;
+	std::vector<typename Family::template shared_ptr<WorkloadDagNode>> children;
+
+	explicit WorkloadDagNode(int value) : payload(value) {}
+};
+
+// Node index of a complete binary tree stored level by level, children of i are 2i+1 and 2i+2
+template<typename Family>
+typename Family::template shared_ptr<WorkloadTreeNode<Family>> build_workload_tree(int index,
+																				   int node_count) {
+	if (index >= node_count) {
+		return {};
+	}
+	auto node	= Family::template make_shared<WorkloadTreeNode<Family>>(index);
+	node->left	= build_workload_tree<Family>(2 * index + 1, node_count);
+	node->right = build_workload_tree<Family>(2 * index + 2, node_count);
+	if (node->left) {
+		node->left->parent = node;
+	}
+	if (node->right) {
+		node->right->parent = node;
+	}
+	return node;
+}
+
+/**
+ * @brief Builds a complete binary tree of node_count nodes, walks it depth first and drops it.
+ *
+ * The walk keeps copies of the nodes on its stack and looks every node's parent up through its
+ * weak_ptr, the way code holding a node usually reaches upwards.
+ */
+template<typename Family>
+long long run_tree_workload_test(int node_count) {
+	using node_ptr = typename Family::template shared_ptr<WorkloadTreeNode<Family>>;
+	std::vector<node_ptr> stack;
+	stack.reserve(64);
+
+	auto	  start = trial_begin();
+	node_ptr  root	= build_workload_tree<Family>(0, node_count);
+	long long sum	= 0;
+	stack.push_back(root);
+	while (!stack.empty()) {
+		node_ptr node = std::move(stack.back());
+		stack.pop_back();
+		sum += node->payload.id;
+		if (node_ptr parent = node->parent.lock()) {
+			sum += parent->payload.id;
+		}
+		if (node->right) {
+			stack.push_back(node->right);
+		}
+		if (node->left) {
+			stack.push_back(node->left);
+		}
+	}
+	root.reset();
+	auto end = trial_end();
+	do_not_optimize(sum);
+	return elapsed_ns(start, end);
+}
+
+/**
+ * @brief Builds a layered DAG of node_count nodes, walks it from the roots and drops it.
+ *
+ * Every node owns an edge to the node below it and one to a random node of the next layer, so
+ * most nodes have two owners and the walk meets them twice.
+ */
+template<typename Family>
+long long run_dag_workload_test(int node_count, int layers) {
+	using node_type = WorkloadDagNode<Family>;
+	using node_ptr	= typename Family::template shared_ptr<node_type>;
+
+	const int width = std::max(node_count / layers, 1);
+
+	std::mt19937					   gen(static_cast<uint32_t>(node_count));
+	std::uniform_int_distribution<int> dist_target(0, width - 1);
+	std::vector<int>				   extra_edge(static_cast<size_t>(width) * layers);
+	for (int& target : extra_edge) {
+		target = dist_target(gen);
+	}
+	std::vector<node_ptr> roots;
+	std::vector<node_ptr> layer;
+	std::vector<node_ptr> next_layer;
+	std::vector<node_ptr> stack;
+	roots.reserve(width);
+	layer.reserve(width);
+	next_layer.reserve(width);
+	stack.reserve(static_cast<size_t>(layers) * 2);
+
+	auto start = trial_begin();
+	for (int i = 0; i < width; ++i) {
+		roots.push_back(Family::template make_shared<node_type>(i));
+	}
+	layer = roots;
+	for (int l = 1; l < layers; ++l) {
+		for (int i = 0; i < width; ++i) {
+			next_layer.push_back(Family::template make_shared<node_type>(l * width + i));
+		}
+		for (int i = 0; i < width; ++i) {
+			layer[i]->children.reserve(2);
+			layer[i]->children.push_back(next_layer[i]);
+			layer[i]->children.push_back(next_layer[extra_edge[l * width + i]]);
+		}
+		std::swap(layer, next_layer);
+		next_layer.clear();
+	}
+	layer.clear();
+
+	long long sum = 0;
+	for (const node_ptr& root : roots) {
+		stack.push_back(root);
+		while (!stack.empty()) {
+			node_ptr node = std::move(stack.back());
+			stack.pop_back();
+			if (node->visited) {
+				continue;
+			}
+			node->visited = true;
+			sum += node->payload.id;
+			for (const node_ptr& child : node->children) {
+				stack.push_back(child);
+			}
+		}
+	}
+	roots.clear();
+	auto end = trial_end();
+	do_not_optimize(sum);
+	return elapsed_ns(start, end);
+}
+
+/**
+ * @brief Fixed-capacity LRU cache that hands out shared values.
+ *
+ * A lookup returns a copy of the cached pointer, so a value evicted while a caller still holds
+ * it stays alive until the caller is done. Once full, the least recently used entry is reused
+ * for the new key and only the value itself is allocated.
+ */
+template<typename Family>
+class WorkloadLruCache {
+public:
+	using value_ptr = typename Family::template shared_ptr<TestObject>;
+
+private:
+	using entry_list = std::list<std::pair<int, value_ptr>>;
+
+	size_t capacity;
+	// Most recently used first
+	entry_list											   entries;
+	std::unordered_map<int, typename entry_list::iterator> index;
+
+public:
+	explicit WorkloadLruCache(size_t capacity) : capacity(capacity) {
+		index.reserve(capacity);
+	}
+
+	value_ptr get(int key) {
+		auto it = index.find(key);
+		if (it != index.end()) {
+			entries.splice(entries.begin(), entries, it->second);
+			return it->second->second;
+		}
+		value_ptr value = Family::template make_shared<TestObject>(key);
+		if (entries.size() < capacity) {
+			entries.emplace_front(key, value);
+		} else {
+			index.erase(entries.back().first);
+			entries.splice(entries.begin(), entries, std::prev(entries.end()));
+			entries.front().first  = key;
+			entries.front().second = value;
+		}
+		index.emplace(key, entries.begin());
+		return value;
+	}
+};
+
+/**
+ * @brief lookup_count lookups on an LRU cache, most of them on a hot set that fits in it.
+ *
+ * The caller keeps the last few values it got, the way requests in flight do.
+ */
+template<typename Family>
+long long run_lru_workload_test(int lookup_count, int capacity) {
+	using value_ptr = typename Family::template shared_ptr<TestObject>;
+	constexpr size_t in_flight = 16;
+
+	std::mt19937					   gen(static_cast<uint32_t>(lookup_count));
+	std::uniform_int_distribution<int> dist_chance(0, 99);
+	std::uniform_int_distribution<int> dist_hot(0, capacity / 2 - 1);
+	std::uniform_int_distribution<int> dist_cold(0, capacity * 10 - 1);
+	std::vector<int>				   keys(lookup_count);
+	for (int& key : keys) {
+		key = dist_chance(gen) < 80 ? dist_hot(gen) : dist_cold(gen);
+	}
+	WorkloadLruCache<Family> cache(capacity);
+	std::vector<value_ptr>	 held(in_flight);
+
+	auto	  start = trial_begin();
+	long long sum	= 0;
+	for (int j = 0; j < lookup_count; ++j) {
+		value_ptr& slot = held[j % in_flight];
+		slot			= cache.get(keys[j]);
+		sum += slot->id;
+	}
+	auto end = trial_end();
+	do_not_optimize(sum);
+	return elapsed_ns(start, end);
+}
+
+/**
+ * @brief Observers registered through weak_ptrs, notified every round.
+ *
+ * Each round a few observers are replaced (the old one dies, the new one subscribes), then all
+ * registered observers are notified through lock(). Every sweep_interval rounds the expired
+ * entries are erased from the registry. notify_count / observer_count rounds are run.
+ */
+template<typename Family>
+long long run_observer_workload_test(int notify_count, int observer_count, int churn,
+									 int sweep_interval) {
+	using observer_ptr = typename Family::template shared_ptr<TestObject>;
+	using observer_ref = typename Family::template weak_ptr<TestObject>;
+
+	const int rounds = std::max(notify_count / observer_count, 1);
+
+	std::mt19937					   gen(static_cast<uint32_t>(notify_count));
+	std::uniform_int_distribution<int> dist_slot(0, observer_count - 1);
+	std::vector<int>				   replaced(static_cast<size_t>(rounds) * churn);
+	for (int& slot : replaced) {
+		slot = dist_slot(gen);
+	}
+	std::vector<observer_ptr> observers;
+	std::vector<observer_ref> registry;
+	observers.reserve(observer_count);
+	registry.reserve(observer_count + static_cast<size_t>(sweep_interval) * churn);
+	for (int i = 0; i < observer_count; ++i) {
+		observers.push_back(Family::template make_shared<TestObject>(i));
+		registry.emplace_back(observers.back());
+	}
+
+	auto	  start = trial_begin();
+	long long sum	= 0;
+	for (int round = 0; round < rounds; ++round) {
+		for (int c = 0; c < churn; ++c) {
+			observer_ptr& observer = observers[replaced[round * churn + c]];
+			observer			   = Family::template make_shared<TestObject>(round);
+			registry.emplace_back(observer);
+		}
+		for (const observer_ref& ref : registry) {
+			if (observer_ptr observer = ref.lock()) {
+				sum += observer->id;
+			}
+		}
+		if ((round + 1) % sweep_interval == 0) {
+			std::erase_if(registry, [](const observer_ref& ref) { return ref.expired(); });
+		}
+	}
+	auto end = trial_end();
+	do_not_optimize(sum);
+	return elapsed_ns(start, end);
+}
+
+// Bounded blocking queue between two pipeline stages
+template<typename T>
+class PipelineQueue {
+private:
+	std::mutex				queue_mutex;
+	std::condition_variable not_empty;
+	std::condition_variable not_full;
+	std::deque<T>			items;
+	size_t					capacity;
+
+public:
+	explicit PipelineQueue(size_t capacity) : capacity(capacity) {}
+
+	void push(T item) {
+		std::unique_lock lock(queue_mutex);
+		not_full.wait(lock, [&] { return items.size() < capacity; });
+		items.push_back(std::move(item));
+		lock.unlock();
+		not_empty.notify_one();
+	}
+
+	T pop() {
+		std::unique_lock lock(queue_mutex);
+		not_empty.wait(lock, [&] { return !items.empty(); });
+		T item = std::move(items.front());
+		items.pop_front();
+		lock.unlock();
+		not_full.notify_one();
+		return item;
+	}
+};
+
+/**
+ * @brief Three threads pass message_count unique_ptr messages down a pipeline.
+ *
+ * The first stage makes the messages, the second rewrites them in place and passes them on, the
+ * last reads and destroys them. An empty pointer ends the stream.
+ */
+template<typename Family>
+long long run_pipeline_workload_test(int message_count, size_t queue_capacity) {
+	using message_ptr = typename Family::template unique_ptr<ConcurrentTestObject>;
+	PipelineQueue<message_ptr> first(queue_capacity);
+	PipelineQueue<message_ptr> second(queue_capacity);
+
+	return run_threads_timed(3, [&](int stage) {
+		if (stage == 0) {
+			for (int j = 0; j < message_count; ++j) {
+				first.push(Family::template make_unique<ConcurrentTestObject>(j));
+			}
+			first.push(message_ptr());
+		} else if (stage == 1) {
+			while (message_ptr message = first.pop()) {
+				message->id = message->id * 2 + 1;
+				second.push(std::move(message));
+			}
+			second.push(message_ptr());
+		} else {
+			long long sum = 0;
+			while (message_ptr message = second.pop()) {
+				sum += message->id;
+			}
+			do_not_optimize(sum);
+		}
+	});
+}
+
+#endif // SMARTPOINTERS_BENCHMARK_WORKLOAD_H
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <memory>
@@ -53,12 +54,63 @@ public:
 	}
 };
 
+// Same idea as TestObject, but safe to create and destroy from several threads at once
+extern std::atomic<int> s_active_concurrent_test_objects;
+
+class ConcurrentTestObject {
+public:
+	int id;
+	ConcurrentTestObject(int _id = 0) : id(_id) {
+		s_active_concurrent_test_objects.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	ConcurrentTestObject(const ConcurrentTestObject& other) : id(other.id) {
+		s_active_concurrent_test_objects.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	~ConcurrentTestObject() {
+		s_active_concurrent_test_objects.fetch_sub(1, std::memory_order_relaxed);
+	}
+};
+
 void verify_active_objects(const std::string& test_name, int expected_count);
+void verify_active_concurrent_objects(const std::string& test_name, int expected_count);
+
+// Per-operation timings of one side of a scenario, in nanoseconds
+struct BenchmarkStats {
+	double min_ns, max_ns, mean_ns;
+	double median_ns, p90_ns, p99_ns, p999_ns;
+	int	   samples, outliers;
+};
+
+// Hardware counter events per operation, averaged over all trials; negative if not collected
+struct PerfCounterStats {
+	double cycles		 = -1.0;
+	double instructions	 = -1.0;
+	double l1d_misses	 = -1.0;
+	double llc_misses	 = -1.0;
+	double branch_misses = -1.0;
+	// Model-specific event chosen with RAW_BENCH_PERF_RAW, e.g. mem_load_retired.l3_miss
+	double raw_event = -1.0;
+};
+
+// Allocator traffic per operation, averaged over all trials; negative if not counted
+struct AllocStats {
+	double allocs_per_op = -1.0;
+	double frees_per_op	 = -1.0;
+	double bytes_per_op	 = -1.0;
+	// Largest growth of live heap bytes within one trial, on the thread that ran it
+	long long peak_live_bytes = -1;
+};
 
 struct TestResults {
-	long long std_min_us, std_max_us, std_avg_us;
-	long long raw_min_us, raw_max_us, raw_avg_us;
-	double	  raw_vs_std_avg_percent;
+	BenchmarkStats	 std_stats;
+	BenchmarkStats	 raw_stats;
+	double			 raw_vs_std_median_percent;
+	PerfCounterStats std_perf;
+	PerfCounterStats raw_perf;
+	AllocStats		 std_alloc;
+	AllocStats		 raw_alloc;
 };
 
 #endif // SMARTPOINTERS_COMMON_TEST_UTILS_H
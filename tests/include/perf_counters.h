@@ -0,0 +1,48 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_PERF_COUNTERS_H
+#define SMARTPOINTERS_PERF_COUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+#include "common_test_utils.h"
+
+/**
+ * @brief Hardware counters of the calling thread and every thread it starts afterwards.
+ *
+ * Backed by Linux perf_event_open, user-space events only so it works with the default
+ * perf_event_paranoid. Counters that cannot be opened (no PMU in a container, missing
+ * permissions, other platforms) are simply reported as not collected.
+ */
+class PerfCounters {
+public:
+	enum event : int { cycles, instructions, l1d_misses, llc_misses, branch_misses, raw_event };
+	static constexpr int event_count = raw_event + 1;
+
+private:
+	int fds[event_count];
+
+public:
+	// raw_config is a PERF_TYPE_RAW event code, 0 leaves the raw_event counter out
+	explicit PerfCounters(uint64_t raw_config);
+	~PerfCounters();
+
+	PerfCounters(const PerfCounters&)			 = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	// Counting only happens between enable() and disable(), totals accumulate across pairs
+	void enable();
+	void disable();
+
+	[[nodiscard]] bool any_available() const;
+	// Totals scaled for multiplexing and divided by operations
+	[[nodiscard]] PerfCounterStats per_op(double operations) const;
+
+	// Why the last counter failed to open, empty if everything opened
+	static std::string last_error();
+};
+
+#endif // SMARTPOINTERS_PERF_COUNTERS_H
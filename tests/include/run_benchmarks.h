@@ -0,0 +1,48 @@
+//
+// Created by progamers on 5/30/25.
+//
+
+#ifndef SMARTPOINTERS_RUN_BENCHMARKS_H
+#define SMARTPOINTERS_RUN_BENCHMARKS_H
+
+#include "benchmark_atomic.h"
+#include "benchmark_cache.h"
+#include "benchmark_contention.h"
+#include "benchmark_cycles.h"
+#include "benchmark_footprint.h"
+#include "benchmark_hazard.h"
+#include "benchmark_intrusive.h"
+#include "benchmark_parallel.h"
+#include "benchmark_rcu.h"
+#include "benchmark_reclaim.h"
+#include "benchmark_recorded.h"
+#include "benchmark_shared.h"
+#include "benchmark_teardown.h"
+#include "benchmark_unique.h"
+#include "benchmark_weak.h"
+#include "benchmark_workload.h"
+
+void run_all_benchmarks() {
+	std::cout
+		<< "------------------------------------------- Starting performance tests -------------------------------------------\n";
+	performance_comparison_unique_test();
+	performance_comparison_shared_test();
+	performance_comparison_weak_test();
+	performance_comparison_contention_test();
+	performance_comparison_intrusive_test();
+	performance_comparison_atomic_test();
+	performance_comparison_hazard_test();
+	performance_comparison_rcu_test();
+	performance_comparison_recorded_test();
+	performance_comparison_workload_test();
+	performance_comparison_teardown_test();
+	performance_comparison_reclaim_test();
+	performance_comparison_parallel_test();
+	performance_comparison_cycles_test();
+	performance_comparison_cache_test();
+	performance_comparison_footprint_test();
+	std::cout
+		<< "------------------------------------------- Performance tests completed -------------------------------------------\n";
+}
+
+#endif // SMARTPOINTERS_RUN_BENCHMARKS_H
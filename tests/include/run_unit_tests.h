@@ -0,0 +1,46 @@
+//
+// Created by progamers on 5/30/25.
+//
+
+#ifndef SMARTPOINTERS_RUN_UNIT_TESTS_H
+#define SMARTPOINTERS_RUN_UNIT_TESTS_H
+
+#include "unit_atomic.h"
+#include "unit_cycles.h"
+#include "unit_deferred.h"
+#include "unit_diagnostics.h"
+#include "unit_hazard.h"
+#include "unit_intrusive.h"
+#include "unit_parallel.h"
+#include "unit_rcu.h"
+#include "unit_recorder.h"
+#include "unit_shared.h"
+#include "unit_teardown.h"
+#include "unit_tracer.h"
+#include "unit_type_stats.h"
+#include "unit_unique.h"
+#include "unit_weak.h"
+
+void run_all_unit_tests() {
+	std::cout
+		<< "------------------------------------------- Starting all tests -------------------------------------------\n";
+	run_all_unique_tests();
+	run_all_shared_tests();
+	run_all_weak_tests();
+	run_all_intrusive_tests();
+	run_all_atomic_tests();
+	run_all_hazard_tests();
+	run_all_rcu_tests();
+	run_all_recorder_tests();
+	run_all_tracer_tests();
+	run_all_diagnostics_tests();
+	run_all_type_stats_tests();
+	run_all_teardown_tests();
+	run_all_deferred_tests();
+	run_all_parallel_tests();
+	run_all_cycles_tests();
+	std::cout
+		<< "------------------------------------------- Unit tests completed -------------------------------------------\n";
+}
+
+#endif // SMARTPOINTERS_RUN_UNIT_TESTS_H
@@ -0,0 +1,22 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_ATOMIC_H
+#define SMARTPOINTERS_UNIT_ATOMIC_H
+
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_atomic_shared_load_store();
+void test_atomic_shared_exchange();
+void test_atomic_weak_operations();
+
+void stress_test_atomic_shared_ptr(int writes, int reader_threads = 4);
+
+void run_all_atomic_tests();
+
+#endif // SMARTPOINTERS_UNIT_ATOMIC_H
@@ -0,0 +1,33 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_CYCLES_H
+#define SMARTPOINTERS_UNIT_CYCLES_H
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_cycle_rings(int length = 100);
+
+void test_cycle_from_unique_ptr(int length = 10);
+
+void test_cycle_live_owner();
+
+void test_cycle_weak_observed();
+
+void test_cycle_object_budget(int length = 100);
+
+void test_cycle_root_budget(int rings = 5);
+
+void test_cycle_root_budget_ring(int length = 100, size_t max_roots = 10);
+
+void test_cycle_background_thread(int rings_per_thread = 2000, int threads = 4);
+
+void run_all_cycles_tests();
+
+#endif // SMARTPOINTERS_UNIT_CYCLES_H
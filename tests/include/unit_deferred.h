@@ -0,0 +1,24 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_DEFERRED_H
+#define SMARTPOINTERS_UNIT_DEFERRED_H
+
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_deferred_drain();
+
+void test_deferred_nested();
+
+void test_deferred_array_slices(size_t size = 10000, size_t slice = 3000);
+
+void test_deferred_reclaimer_thread(int objects_per_thread = 10000, int threads = 4);
+
+void run_all_deferred_tests();
+
+#endif // SMARTPOINTERS_UNIT_DEFERRED_H
@@ -0,0 +1,22 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_DIAGNOSTICS_H
+#define SMARTPOINTERS_UNIT_DIAGNOSTICS_H
+
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_live_registry_finds_cycle();
+
+void test_live_registry_sampling(int hubs = 1000, uint32_t sample_every = 4);
+
+void test_contention_profiler(int copies_per_thread = 10000, int threads = 4);
+
+void run_all_diagnostics_tests();
+
+#endif // SMARTPOINTERS_UNIT_DIAGNOSTICS_H
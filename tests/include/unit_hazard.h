@@ -0,0 +1,23 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_HAZARD_H
+#define SMARTPOINTERS_UNIT_HAZARD_H
+
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_hazard_protect();
+void test_hazard_deferred_destruction();
+void test_hazard_guard_semantics();
+void test_hazard_slot_exhaustion();
+
+void stress_test_hazard_guard(int rounds, int reader_threads = 4);
+
+void run_all_hazard_tests();
+
+#endif // SMARTPOINTERS_UNIT_HAZARD_H
@@ -0,0 +1,39 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_INTRUSIVE_H
+#define SMARTPOINTERS_UNIT_INTRUSIVE_H
+
+#include <random>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+class IntrusiveTestObject : public TestObject,
+							public raw::intrusive_ref_counter<IntrusiveTestObject> {
+public:
+	using TestObject::TestObject;
+};
+
+class LocalIntrusiveTestObject
+	: public TestObject,
+	  public raw::intrusive_ref_counter<LocalIntrusiveTestObject, raw::single_threaded_policy> {
+public:
+	using TestObject::TestObject;
+};
+
+template<typename T>
+void print_intrusive_ptr_state(const std::string& name, const raw::intrusive_ptr<T>& ptr);
+
+void test_intrusive_construction();
+void test_intrusive_copy_move_semantics();
+void test_intrusive_manipulation();
+void test_intrusive_thread_policy();
+
+void stress_test_intrusive_ptr(int iterations, int max_pointers_in_pool = 100);
+
+void run_all_intrusive_tests();
+
+#endif // SMARTPOINTERS_UNIT_INTRUSIVE_H
@@ -0,0 +1,25 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_PARALLEL_H
+#define SMARTPOINTERS_UNIT_PARALLEL_H
+
+#include <cstddef>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_parallel_thread_count();
+
+void test_parallel_make_shared(size_t size = raw::parallel::min_chunk * 4 + 3);
+
+void test_parallel_rollback(size_t size = raw::parallel::min_chunk * 4 + 3);
+
+void test_parallel_destroy_threads(size_t size = raw::parallel::min_chunk * 8);
+
+void test_parallel_make_unique(size_t size = raw::parallel::min_chunk * 4 + 3);
+
+void run_all_parallel_tests();
+
+#endif // SMARTPOINTERS_UNIT_PARALLEL_H
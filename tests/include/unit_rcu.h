@@ -0,0 +1,22 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_RCU_H
+#define SMARTPOINTERS_UNIT_RCU_H
+
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_rcu_read_publish();
+void test_rcu_deferred_reclaim();
+void test_rcu_nested_read_sections();
+
+void stress_test_rcu_ptr(int publishes, int reader_threads = 4);
+
+void run_all_rcu_tests();
+
+#endif // SMARTPOINTERS_UNIT_RCU_H
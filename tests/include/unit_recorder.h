@@ -0,0 +1,21 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_RECORDER_H
+#define SMARTPOINTERS_UNIT_RECORDER_H
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_recorder_captures_operations();
+
+void stress_test_recorder(int copies_per_thread, int threads = 4);
+
+void run_all_recorder_tests();
+
+#endif // SMARTPOINTERS_UNIT_RECORDER_H
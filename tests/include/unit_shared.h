@@ -26,6 +26,7 @@ void test_shared_array_construction();
 void test_shared_array_copy_move_semantics();
 void test_shared_array_manipulation();
 void test_shared_from_unique();
+void test_shared_from_this();
 
 void stress_test_shared_ptr(int iterations, int max_pointers_in_pool = 100);
 
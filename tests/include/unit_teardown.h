@@ -0,0 +1,23 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_TEARDOWN_H
+#define SMARTPOINTERS_UNIT_TEARDOWN_H
+
+#include <cstddef>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_teardown_unique_chain(int nodes = 10'000'000, size_t stack_bytes = 1 << 20);
+
+void test_teardown_shared_chain(int nodes = 10'000'000, size_t stack_bytes = 1 << 20);
+
+void test_teardown_intrusive_chain(int nodes = 1'000'000, size_t stack_bytes = 1 << 20);
+
+void test_teardown_tree(int depth = 16);
+
+void run_all_teardown_tests();
+
+#endif // SMARTPOINTERS_UNIT_TEARDOWN_H
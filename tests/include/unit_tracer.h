@@ -0,0 +1,19 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_TRACER_H
+#define SMARTPOINTERS_UNIT_TRACER_H
+
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_tracer_captures_lifecycle();
+
+void test_tracer_sampling(int events = 1000, uint32_t sample_every = 4);
+
+void run_all_tracer_tests();
+
+#endif // SMARTPOINTERS_UNIT_TRACER_H
@@ -0,0 +1,20 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#ifndef SMARTPOINTERS_UNIT_TYPE_STATS_H
+#define SMARTPOINTERS_UNIT_TYPE_STATS_H
+
+#include <thread>
+#include <vector>
+
+#include "../../include/raw_memory.h"
+#include "common_test_utils.h"
+
+void test_type_stats_counts();
+
+void test_type_stats_threads(int objects_per_thread = 1000, int threads = 4);
+
+void run_all_type_stats_tests();
+
+#endif // SMARTPOINTERS_UNIT_TYPE_STATS_H
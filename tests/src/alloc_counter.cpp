@@ -0,0 +1,239 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/alloc_counter.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define RAW_SANITIZED_BUILD 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || \
+	__has_feature(memory_sanitizer)
+#define RAW_SANITIZED_BUILD 1
+#endif
+#endif
+
+// Sanitizers bring their own allocator, replacing it would hide every report
+#if defined(__GLIBC__) && !defined(RAW_SANITIZED_BUILD)
+#define RAW_COUNT_ALLOCATIONS 1
+#include <malloc.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void  __libc_free(void* ptr);
+}
+#endif
+
+#ifdef RAW_COUNT_ALLOCATIONS
+namespace {
+/**
+ * One shard per thread (modulo shard_count) so counting adds no shared cache line traffic to
+ * the contention benchmarks. A shard is only written by the thread that owns it, hence plain
+ * load + store instead of an RMW; with more live threads than shards a few updates may be lost.
+ */
+struct alignas(64) alloc_shard {
+	std::atomic<uint64_t> allocs {0};
+	std::atomic<uint64_t> frees {0};
+	std::atomic<uint64_t> bytes {0};
+	std::atomic<int64_t>  live {0};
+	std::atomic<int64_t>  peak {0};
+};
+
+constexpr unsigned shard_count = 128;
+
+// Constant-initialized, so allocations made before main() already have somewhere to go
+alloc_shard			  shards[shard_count];
+std::atomic<unsigned> next_shard {0};
+// A trivial thread_local, touching it never allocates
+thread_local unsigned shard_index = shard_count;
+
+alloc_shard& local_shard() {
+	if (shard_index == shard_count) {
+		shard_index = next_shard.fetch_add(1, std::memory_order_relaxed) % shard_count;
+	}
+	return shards[shard_index];
+}
+
+template<typename Int>
+void bump(std::atomic<Int>& counter, Int delta) {
+	counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+void record_alloc(void* ptr, size_t requested) {
+	if (!ptr) {
+		return;
+	}
+	alloc_shard& shard = local_shard();
+	bump<uint64_t>(shard.allocs, 1);
+	bump<uint64_t>(shard.bytes, requested);
+	int64_t live = shard.live.load(std::memory_order_relaxed) +
+				   static_cast<int64_t>(malloc_usable_size(ptr));
+	shard.live.store(live, std::memory_order_relaxed);
+	if (live > shard.peak.load(std::memory_order_relaxed)) {
+		shard.peak.store(live, std::memory_order_relaxed);
+	}
+}
+
+void record_free(size_t usable) {
+	alloc_shard& shard = local_shard();
+	bump<uint64_t>(shard.frees, 1);
+	bump<int64_t>(shard.live, -static_cast<int64_t>(usable));
+}
+
+void* counted_new(size_t size, size_t alignment) {
+	if (size == 0) {
+		size = 1;
+	}
+	for (;;) {
+		void* ptr = alignment > alignof(std::max_align_t) ? __libc_memalign(alignment, size)
+														  : __libc_malloc(size);
+		if (ptr) {
+			record_alloc(ptr, size);
+			return ptr;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if (!handler) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+void counted_delete(void* ptr) noexcept {
+	if (ptr) {
+		record_free(malloc_usable_size(ptr));
+		__libc_free(ptr);
+	}
+}
+} // namespace
+
+// The array and nothrow forms of the standard library forward to these
+void* operator new(size_t size) {
+	return counted_new(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+	return counted_new(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+	counted_delete(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	counted_delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	counted_delete(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+	counted_delete(ptr);
+}
+
+extern "C" {
+void* malloc(size_t size) noexcept {
+	void* ptr = __libc_malloc(size);
+	record_alloc(ptr, size);
+	return ptr;
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+	void* ptr = __libc_calloc(count, size);
+	record_alloc(ptr, count * size);
+	return ptr;
+}
+
+void* realloc(void* old_ptr, size_t size) noexcept {
+	size_t old_usable = old_ptr ? malloc_usable_size(old_ptr) : 0;
+	void*  ptr		  = __libc_realloc(old_ptr, size);
+	// A failed realloc leaves the old block alone, realloc(p, 0) frees it
+	if (old_ptr && (ptr || size == 0)) {
+		record_free(old_usable);
+	}
+	record_alloc(ptr, size);
+	return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+	void* ptr = __libc_memalign(alignment, size);
+	record_alloc(ptr, size);
+	return ptr;
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) noexcept {
+	if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+		return EINVAL;
+	}
+	void* ptr = __libc_memalign(alignment, size);
+	if (!ptr) {
+		return ENOMEM;
+	}
+	record_alloc(ptr, size);
+	*out = ptr;
+	return 0;
+}
+
+void free(void* ptr) noexcept {
+	counted_delete(ptr);
+}
+}
+
+bool alloc_counting_enabled() {
+	return true;
+}
+
+AllocSnapshot alloc_snapshot() {
+	AllocSnapshot total;
+	for (const alloc_shard& shard : shards) {
+		total.allocs += shard.allocs.load(std::memory_order_relaxed);
+		total.frees += shard.frees.load(std::memory_order_relaxed);
+		total.bytes += shard.bytes.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+int64_t alloc_thread_live_bytes() {
+	return local_shard().live.load(std::memory_order_relaxed);
+}
+
+int64_t alloc_thread_peak_bytes() {
+	return local_shard().peak.load(std::memory_order_relaxed);
+}
+
+void alloc_reset_thread_peak() {
+	alloc_shard& shard = local_shard();
+	shard.peak.store(shard.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+#else
+
+bool alloc_counting_enabled() {
+	return false;
+}
+
+AllocSnapshot alloc_snapshot() {
+	return {};
+}
+
+int64_t alloc_thread_live_bytes() {
+	return 0;
+}
+
+int64_t alloc_thread_peak_bytes() {
+	return 0;
+}
+
+void alloc_reset_thread_peak() {}
+
+#endif
@@ -0,0 +1,64 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_atomic.h"
+
+#include <iostream>
+
+#ifdef RAW_MULTI_THREADED
+
+void performance_comparison_atomic_test() {
+	std::cout << "\n--- Performance Comparison Test: raw::atomic_shared_ptr reader scaling ---\n";
+	begin_report_suite("atomic");
+
+	const int NUM_TRIALS	   = 10;
+	const int READS_PER_THREAD = 200000;
+
+	int initial_active_objects_before_test = s_active_concurrent_test_objects;
+
+	print_table_header("MUTEX", "RAW ATOMIC");
+	for (int readers : benchmark_thread_counts()) {
+		std::string scenario_name = "Snapshot Readers x" + std::to_string(readers);
+		TestResults results		  = run_benchmark_scenario(
+			  scenario_name, NUM_TRIALS, READS_PER_THREAD,
+			  [&](int ops) {
+				  return run_snapshot_readers_test<MutexSnapshotSlot>(ops, readers);
+			  },
+			  [&](int ops) {
+				  return run_snapshot_readers_test<RawAtomicSnapshotSlot>(ops, readers);
+			  });
+		print_table_row(scenario_name, results, initial_active_objects_before_test,
+						s_active_concurrent_test_objects);
+		verify_active_concurrent_objects(scenario_name, initial_active_objects_before_test);
+	}
+
+	print_table_header("STD ATOMIC", "RAW ATOMIC");
+	for (int readers : benchmark_thread_counts()) {
+		std::string scenario_name = "Snapshot Readers x" + std::to_string(readers);
+		TestResults results		  = run_benchmark_scenario(
+			  scenario_name, NUM_TRIALS, READS_PER_THREAD,
+			  [&](int ops) {
+				  return run_snapshot_readers_test<StdAtomicSnapshotSlot>(ops, readers);
+			  },
+			  [&](int ops) {
+				  return run_snapshot_readers_test<RawAtomicSnapshotSlot>(ops, readers);
+			  });
+		print_table_row(scenario_name, results, initial_active_objects_before_test,
+						s_active_concurrent_test_objects);
+		verify_active_concurrent_objects(scenario_name, initial_active_objects_before_test);
+	}
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
+
+#else
+
+void performance_comparison_atomic_test() {
+	std::cout << "\n--- Performance Comparison Test: raw::atomic_shared_ptr reader scaling ---\n";
+	std::cout << "Skipped, raw::atomic_shared_ptr needs RAW_MULTI_THREADED.\n";
+}
+
+#endif
@@ -0,0 +1,94 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_cache.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+// 24K, 1536K, 96M: whole mebibytes when they are, kibibytes otherwise
+std::string format_bytes(size_t bytes) {
+	if (bytes % (size_t(1) << 20) == 0) {
+		return std::to_string(bytes >> 20) + "M";
+	}
+	return std::to_string(bytes >> 10) + "K";
+}
+} // namespace
+
+std::vector<size_t> working_set_sweep(const CacheSizes& caches, size_t max_bytes) {
+	size_t				last = std::max(std::min(4 * caches.llc, max_bytes), caches.l1d / 2);
+	std::vector<size_t> sizes;
+	for (size_t size = caches.l1d / 2; size < last; size *= 4) {
+		sizes.push_back(size);
+	}
+	sizes.push_back(last);
+	return sizes;
+}
+
+void performance_comparison_cache_test() {
+	std::cout << "\n--- Performance Comparison Test: cold control blocks, large working sets ---\n";
+	begin_report_suite("cache");
+	ScopedCpuPin pin(harness_config().pin_cpu);
+
+	const int NUM_TRIALS	= 10;
+	const int OPS_PER_TRIAL = 200000;
+
+	const HarnessConfig& config = harness_config();
+	const CacheSizes&	 caches = cache_sizes();
+	std::cout << "L1d " << format_bytes(caches.l1d) << ", L2 " << format_bytes(caches.l2)
+			  << ", LLC " << format_bytes(caches.llc) << ", " << cold_pool_entry_bytes
+			  << " bytes of working set per pointer, cache flush between trials "
+			  << (config.flush_caches ? "on" : "off (RAW_BENCH_CACHE_FLUSH=1)") << "\n";
+
+	auto std_make_shared_single = [](int val) {
+		return std::make_shared<TestObject>(val);
+	};
+	auto raw_make_shared_single = [](int val) {
+		return raw::make_shared<TestObject>(val);
+	};
+
+	print_table_header();
+
+	int initial_active_objects_before_test = s_active_test_objects;
+
+	for (size_t working_set : working_set_sweep(caches, config.max_working_set_bytes)) {
+		const size_t	  entries = working_set / cold_pool_entry_bytes;
+		const std::string label	  = format_bytes(working_set);
+		// Same seed on both sides, they visit the same indices in the same order
+		const uint64_t seed = config.trace_seed ^ working_set;
+		{
+			auto std_pool = build_cold_pool<std::shared_ptr<TestObject>, std::weak_ptr<TestObject>>(
+				entries, OPS_PER_TRIAL, seed, std_make_shared_single);
+			auto raw_pool = build_cold_pool<raw::shared_ptr<TestObject>, raw::weak_ptr<TestObject>>(
+				entries, OPS_PER_TRIAL, seed, raw_make_shared_single);
+
+			TestResults use_count_results = run_benchmark_scenario(
+				"Cold use_count() " + label, NUM_TRIALS, OPS_PER_TRIAL,
+				[&](int ops) { return run_cold_use_count_test(std_pool, ops); },
+				[&](int ops) { return run_cold_use_count_test(raw_pool, ops); });
+			print_table_row("Cold use_count() " + label, use_count_results,
+							initial_active_objects_before_test, s_active_test_objects);
+
+			TestResults copy_results = run_benchmark_scenario(
+				"Cold Copy " + label, NUM_TRIALS, OPS_PER_TRIAL,
+				[&](int ops) { return run_cold_copy_test(std_pool, ops); },
+				[&](int ops) { return run_cold_copy_test(raw_pool, ops); });
+			print_table_row("Cold Copy " + label, copy_results, initial_active_objects_before_test,
+							s_active_test_objects);
+
+			TestResults lock_results = run_benchmark_scenario(
+				"Cold lock() " + label, NUM_TRIALS, OPS_PER_TRIAL,
+				[&](int ops) { return run_cold_lock_test(std_pool, ops); },
+				[&](int ops) { return run_cold_lock_test(raw_pool, ops); });
+			print_table_row("Cold lock() " + label, lock_results,
+							initial_active_objects_before_test, s_active_test_objects);
+		}
+		verify_active_objects("Cold pool " + label, initial_active_objects_before_test);
+	}
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
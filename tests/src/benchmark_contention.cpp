@@ -0,0 +1,82 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_contention.h"
+
+#include <iostream>
+
+void performance_comparison_contention_test() {
+	std::cout << "\n--- Performance Comparison Test: cross-thread refcount contention ---\n";
+	begin_report_suite("contention");
+
+	const int NUM_TRIALS	 = 10;
+	const int OPS_PER_THREAD = 100000;
+
+#ifdef RAW_MULTI_THREADED
+	std::cout << "raw:: reference counts: atomic (RAW_MULTI_THREADED)\n";
+	std::vector<int> thread_counts = benchmark_thread_counts();
+#else
+	// Plain counters may not be shared between threads, so raw only runs the race-free cases
+	std::cout << "raw:: reference counts: plain (single-threaded build), 1 thread only\n";
+	std::vector<int> thread_counts = {1};
+#endif
+
+	auto make_std = [](int i) { return std::make_shared<ConcurrentTestObject>(i); };
+	auto make_raw = [](int i) { return raw::make_shared<ConcurrentTestObject>(i); };
+
+	using StdShared = std::shared_ptr<ConcurrentTestObject>;
+	using RawShared = raw::shared_ptr<ConcurrentTestObject>;
+
+	int initial_active_objects_before_test = s_active_concurrent_test_objects;
+
+	print_table_header();
+	for (int threads : thread_counts) {
+		std::string scenario_name = "Contended Copy x" + std::to_string(threads);
+		TestResults results		  = run_benchmark_scenario(
+			  scenario_name, NUM_TRIALS, OPS_PER_THREAD,
+			  [&](int ops) { return run_contended_copy_test<StdShared>(ops, threads, make_std); },
+			  [&](int ops) { return run_contended_copy_test<RawShared>(ops, threads, make_raw); });
+		print_table_row(scenario_name, results, initial_active_objects_before_test,
+						s_active_concurrent_test_objects);
+		verify_active_concurrent_objects(scenario_name, initial_active_objects_before_test);
+	}
+
+#ifdef RAW_MULTI_THREADED
+	for (int threads : thread_counts) {
+		std::string scenario_name = "Lock While Expiring x" + std::to_string(threads);
+		TestResults results		  = run_benchmark_scenario(
+			  scenario_name, NUM_TRIALS, OPS_PER_THREAD,
+			  [&](int ops) {
+				  return run_contended_lock_expire_test<StdShared,
+														std::weak_ptr<ConcurrentTestObject>>(
+					  ops, threads, make_std);
+			  },
+			  [&](int ops) {
+				  return run_contended_lock_expire_test<RawShared,
+														raw::weak_ptr<ConcurrentTestObject>>(
+					  ops, threads, make_raw);
+			  });
+		print_table_row(scenario_name, results, initial_active_objects_before_test,
+						s_active_concurrent_test_objects);
+		verify_active_concurrent_objects(scenario_name, initial_active_objects_before_test);
+	}
+#else
+	std::cout << "Lock While Expiring skipped, the expiring thread would race on plain counters.\n";
+#endif
+
+	for (int threads : thread_counts) {
+		std::string scenario_name = "Queue Handoff x" + std::to_string(threads);
+		TestResults results		  = run_benchmark_scenario(
+			  scenario_name, NUM_TRIALS, OPS_PER_THREAD,
+			  [&](int ops) { return run_queue_handoff_test<StdShared>(ops, threads, make_std); },
+			  [&](int ops) { return run_queue_handoff_test<RawShared>(ops, threads, make_raw); });
+		print_table_row(scenario_name, results, initial_active_objects_before_test,
+						s_active_concurrent_test_objects);
+		verify_active_concurrent_objects(scenario_name, initial_active_objects_before_test);
+	}
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
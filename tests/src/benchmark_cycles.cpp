@@ -0,0 +1,102 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_cycles.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#ifdef RAW_CYCLE_COLLECTOR
+namespace {
+/**
+ * @brief Drops rings_count garbage rings, then runs bounded passes until every one is collected.
+ *
+ * Prints one row per max_roots: the passes it took, the longest and the mean pause, the total
+ * pause and the time spent destroying the garbage after the pauses.
+ */
+void print_pause_table(int rings_count, int ring_length) {
+	std::cout << std::left << std::setw(28) << "max_roots" << std::right;
+	for (const char* column : {"Passes", "Max pause", "Mean pause", "Total pause", "Release"}) {
+		std::cout << " | " << std::setw(12) << column;
+	}
+	std::cout << "\n" << std::fixed << std::setprecision(2);
+
+	for (size_t max_roots : {std::numeric_limits<size_t>::max(), size_t(4096), size_t(512),
+							 size_t(64)}) {
+		for (int i = 0; i < rings_count; ++i) {
+			build_ring<true>(ring_length).reset();
+		}
+		size_t	 passes		= 0;
+		uint64_t max_pause	= 0;
+		uint64_t pause_sum	= 0;
+		uint64_t release	= 0;
+		for (;;) {
+			raw::cycle_report report = raw::collect_cycles({.max_roots = max_roots});
+			if (report.roots == 0 && report.pending == 0) {
+				break;
+			}
+			++passes;
+			max_pause = std::max(max_pause, report.pause_ns);
+			pause_sum += report.pause_ns;
+			release += report.release_ns;
+		}
+
+		std::string name = max_roots == std::numeric_limits<size_t>::max()
+							   ? std::string("unbounded")
+							   : std::to_string(max_roots);
+		std::cout << std::left << std::setw(28) << name << std::right << " | " << std::setw(12)
+				  << passes << " | " << std::setw(12) << max_pause / 1000.0 << " | "
+				  << std::setw(12) << (passes ? pause_sum / 1000.0 / passes : 0.0) << " | "
+				  << std::setw(12) << pause_sum / 1000.0 << " | " << std::setw(12)
+				  << release / 1000.0 << "\n";
+	}
+	std::cout << "(times in us)\n";
+}
+} // namespace
+#endif
+
+void performance_comparison_cycles_test() {
+	std::cout << "\n--- Performance Comparison Test: freeing garbage cycles ---\n";
+	begin_report_suite("cycles");
+
+	const int NUM_TRIALS  = 5;
+	const int RINGS		  = 4096;
+	const int RING_LENGTH = 16;
+
+#ifdef RAW_CYCLE_COLLECTOR
+	std::cout << "std:: side breaks every ring by hand, raw:: side drops them and calls "
+				 "raw::collect_cycles()\n";
+	raw::collect_cycles();
+#else
+	std::cout << "Configure with RAW_CYCLE_COLLECTOR=ON to collect the raw:: rings, until then "
+				 "both sides break them by hand\n";
+#endif
+
+	int initial_active_objects_before_test = s_active_test_objects;
+
+	print_table_header();
+	for (int length : {1, RING_LENGTH}) {
+		std::string scenario_name = "Ring Drop x" + std::to_string(length);
+		TestResults results		  = run_benchmark_scenario(
+			  scenario_name, NUM_TRIALS, RINGS * length,
+			  [&](int) { return run_ring_drop_test<false>(RINGS, length); },
+			  [&](int) { return run_ring_drop_test<true>(RINGS, length); });
+		print_table_row(scenario_name, results, initial_active_objects_before_test,
+						s_active_test_objects);
+	}
+
+#ifdef RAW_CYCLE_COLLECTOR
+	std::cout << "\nPause of the passes that collect " << RINGS << " rings of " << RING_LENGTH
+			  << " nodes\n";
+	print_pause_table(RINGS, RING_LENGTH);
+	verify_active_objects("Bounded cycle passes", initial_active_objects_before_test);
+#endif
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
@@ -0,0 +1,172 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_footprint.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+long long resident_bytes() {
+#if defined(__linux__)
+	std::ifstream statm("/proc/self/statm");
+	long long	  total_pages	 = 0;
+	long long	  resident_pages = 0;
+	if (statm >> total_pages >> resident_pages) {
+		return resident_pages * sysconf(_SC_PAGESIZE);
+	}
+#endif
+	return 0;
+}
+
+void release_free_heap() {
+#if defined(__GLIBC__)
+	malloc_trim(0);
+#endif
+}
+
+namespace {
+const int OBJECT_COUNT = 1000000;
+const int ARRAY_COUNT  = 100000;
+const int ARRAY_LENGTH = 16;
+
+template<typename T>
+void print_sizeof_row(const std::string& name) {
+	std::cout << std::left << std::setw(48) << name << "| " << std::right << std::setw(8)
+			  << sizeof(T) << "\n";
+}
+
+void print_footprint_header() {
+	std::cout << std::left << std::setw(48) << "Flavor"
+			  << "| " << std::right << std::setw(12) << "Object (B)"
+			  << " | " << std::setw(12) << "sizeof ptr"
+			  << " | " << std::setw(12) << "Heap B/obj"
+			  << " | " << std::setw(12) << "RSS B/obj"
+			  << " | " << std::setw(12) << "Total B/obj" << "\n";
+}
+
+void print_footprint_row(const std::string& flavor, size_t object_bytes, size_t handle_bytes,
+						 const FootprintSample& sample) {
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << std::left << std::setw(48) << flavor << "| " << std::right << std::setw(12)
+			  << object_bytes << " | " << std::setw(12) << handle_bytes << " | ";
+	if (sample.heap_bytes_per_object < 0.0) {
+		std::cout << std::setw(12) << "-";
+	} else {
+		std::cout << std::setw(12) << sample.heap_bytes_per_object;
+	}
+	// Heap accounting is exact, RSS only backs it up where counting is off
+	double heap = sample.heap_bytes_per_object >= 0.0 ? sample.heap_bytes_per_object
+													  : sample.rss_bytes_per_object;
+	std::cout << " | " << std::setw(12) << sample.rss_bytes_per_object << " | " << std::setw(12)
+			  << handle_bytes + heap << "\n";
+}
+
+template<size_t Size>
+void measure_single_object_flavors() {
+	using object		   = FootprintObject<Size>;
+	using intrusive_object = IntrusiveFootprintObject<Size>;
+
+	print_footprint_row(
+		"std::make_shared<T>", Size, sizeof(std::shared_ptr<object>),
+		measure_footprint<std::shared_ptr<object>>(
+			OBJECT_COUNT, [] { return std::make_shared<object>(); }));
+	print_footprint_row(
+		"raw::make_shared<T>", Size, sizeof(raw::shared_ptr<object>),
+		measure_footprint<raw::shared_ptr<object>>(
+			OBJECT_COUNT, [] { return raw::make_shared<object>(); }));
+	print_footprint_row(
+		"std::shared_ptr<T>(new T)", Size, sizeof(std::shared_ptr<object>),
+		measure_footprint<std::shared_ptr<object>>(
+			OBJECT_COUNT, [] { return std::shared_ptr<object>(new object()); }));
+	print_footprint_row(
+		"raw::shared_ptr<T>(new T)", Size, sizeof(raw::shared_ptr<object>),
+		measure_footprint<raw::shared_ptr<object>>(
+			OBJECT_COUNT, [] { return raw::shared_ptr<object>(new object()); }));
+	print_footprint_row(
+		"raw::make_intrusive<T>", Size, sizeof(raw::intrusive_ptr<intrusive_object>),
+		measure_footprint<raw::intrusive_ptr<intrusive_object>>(
+			OBJECT_COUNT, [] { return raw::make_intrusive<intrusive_object>(); }));
+	print_footprint_row(
+		"std::make_unique<T>", Size, sizeof(std::unique_ptr<object>),
+		measure_footprint<std::unique_ptr<object>>(
+			OBJECT_COUNT, [] { return std::make_unique<object>(); }));
+	print_footprint_row(
+		"raw::make_unique<T>", Size, sizeof(raw::unique_ptr<object>),
+		measure_footprint<raw::unique_ptr<object>>(
+			OBJECT_COUNT, [] { return raw::make_unique<object>(); }));
+}
+
+template<size_t Size>
+void measure_array_flavors() {
+	using object = FootprintObject<Size>;
+
+	// Reported per element, the array header is spread over ARRAY_LENGTH objects
+	auto per_element = [](FootprintSample sample) {
+		if (sample.heap_bytes_per_object >= 0.0) {
+			sample.heap_bytes_per_object /= ARRAY_LENGTH;
+		}
+		sample.rss_bytes_per_object /= ARRAY_LENGTH;
+		return sample;
+	};
+	const std::string suffix = " (per element, n = " + std::to_string(ARRAY_LENGTH) + ")";
+
+	auto make_std_array = [] { return std::make_shared<object[]>(ARRAY_LENGTH); };
+	auto make_raw_array = [] { return raw::make_shared<object[]>(ARRAY_LENGTH); };
+
+	print_footprint_row(
+		"std::make_shared<T[]>(n)" + suffix, Size, 0,
+		per_element(measure_footprint<std::shared_ptr<object[]>>(ARRAY_COUNT, make_std_array)));
+	print_footprint_row(
+		"raw::make_shared<T[]>(n)" + suffix, Size, 0,
+		per_element(measure_footprint<raw::shared_ptr<object[]>>(ARRAY_COUNT, make_raw_array)));
+}
+} // namespace
+
+void performance_comparison_footprint_test() {
+	std::cout << "\n--- Memory Footprint: raw:: vs std:: pointer flavors ---\n";
+
+	std::cout << "\n";
+	std::cout << std::left << std::setw(48) << "Type"
+			  << "| " << std::right << std::setw(8) << "sizeof" << "\n";
+	print_sizeof_row<raw::unique_ptr<TestObject>>("raw::unique_ptr<T>");
+	print_sizeof_row<std::unique_ptr<TestObject>>("std::unique_ptr<T>");
+	print_sizeof_row<raw::unique_ptr<TestObject[]>>("raw::unique_ptr<T[]>");
+	print_sizeof_row<std::unique_ptr<TestObject[]>>("std::unique_ptr<T[]>");
+	print_sizeof_row<raw::shared_ptr<TestObject>>("raw::shared_ptr<T>");
+	print_sizeof_row<std::shared_ptr<TestObject>>("std::shared_ptr<T>");
+	print_sizeof_row<raw::weak_ptr<TestObject>>("raw::weak_ptr<T>");
+	print_sizeof_row<std::weak_ptr<TestObject>>("std::weak_ptr<T>");
+	print_sizeof_row<raw::intrusive_ptr<IntrusiveFootprintObject<8>>>("raw::intrusive_ptr<T>");
+	print_sizeof_row<raw::hazard_guard<TestObject>>("raw::hazard_guard<T>");
+	print_sizeof_row<raw::rcu_ptr<TestObject>>("raw::rcu_ptr<T>");
+#ifdef RAW_MULTI_THREADED
+	print_sizeof_row<raw::atomic_shared_ptr<TestObject>>("raw::atomic_shared_ptr<T>");
+#endif
+	print_sizeof_row<std::atomic<std::shared_ptr<TestObject>>>("std::atomic<std::shared_ptr<T>>");
+	print_sizeof_row<raw::hub>("raw::hub (control block)");
+	print_sizeof_row<combined<FootprintObject<8>>>("combined<T> (make_shared block, 8 B T)");
+	print_sizeof_row<combined<FootprintObject<64>>>("combined<T> (make_shared block, 64 B T)");
+	print_sizeof_row<combined<FootprintObject<256>>>("combined<T> (make_shared block, 256 B T)");
+
+	std::cout << "\nBytes per live object, " << OBJECT_COUNT << " objects alive at once ("
+			  << ARRAY_COUNT << " arrays):\n";
+	print_footprint_header();
+	measure_single_object_flavors<8>();
+	measure_single_object_flavors<64>();
+	measure_single_object_flavors<256>();
+	measure_array_flavors<8>();
+	measure_array_flavors<64>();
+	std::cout << "Footprint report finished.\n";
+}
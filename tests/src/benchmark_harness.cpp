@@ -0,0 +1,427 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <thread>
+
+#include "../include/alloc_counter.h"
+#include "../include/perf_counters.h"
+
+namespace {
+int env_int(const char* name, int fallback) {
+	const char* value = std::getenv(name);
+	return value ? std::atoi(value) : fallback;
+}
+
+double env_double(const char* name, double fallback) {
+	const char* value = std::getenv(name);
+	return value ? std::atof(value) : fallback;
+}
+
+// Nearest-rank percentile of an already sorted sample
+double percentile(const std::vector<double>& sorted, double fraction) {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+	return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+// What one side of a scenario accumulates over its measured trials
+struct SideAccounting {
+	std::optional<PerfCounters> perf;
+	AllocSnapshot				trial_start;
+	int64_t						live_at_trial_start = 0;
+	AllocSnapshot				allocated;
+	long long					peak_live_bytes = 0;
+};
+
+// Side whose trial is running, nullptr during warmup and outside run_benchmark_scenario
+SideAccounting* active_side = nullptr;
+
+// Widths of the heap and events/op columns of one side
+constexpr int alloc_column_width = 9;
+constexpr int peak_column_width	 = 12;
+constexpr int alloc_block_width	 = 3 + 3 * alloc_column_width + peak_column_width;
+constexpr int perf_column_width	 = 9;
+constexpr int perf_block_width	 = 3 + perf_column_width * PerfCounters::event_count;
+
+void print_separator() {
+	std::cout << std::string(2 * alloc_block_width, '-');
+	if (harness_config().perf_counters) {
+		std::cout << std::string(2 * perf_block_width, '-');
+	}
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+}
+
+void print_alloc_cells(const AllocStats& alloc) {
+	std::cout << " | ";
+	if (alloc.allocs_per_op < 0.0) {
+		std::cout << std::setw(3 * alloc_column_width) << "-" << std::setw(peak_column_width)
+				  << "-";
+		return;
+	}
+	std::cout << std::setw(alloc_column_width) << alloc.allocs_per_op
+			  << std::setw(alloc_column_width) << alloc.frees_per_op
+			  << std::setw(alloc_column_width) << alloc.bytes_per_op
+			  << std::setw(peak_column_width) << alloc.peak_live_bytes;
+}
+
+AllocStats alloc_stats(const SideAccounting& side, double total_ops) {
+	AllocStats stats;
+	if (!alloc_counting_enabled()) {
+		return stats;
+	}
+	stats.allocs_per_op	  = side.allocated.allocs / total_ops;
+	stats.frees_per_op	  = side.allocated.frees / total_ops;
+	stats.bytes_per_op	  = side.allocated.bytes / total_ops;
+	stats.peak_live_bytes = side.peak_live_bytes;
+	return stats;
+}
+
+void print_perf_cells(const PerfCounterStats& perf) {
+	std::cout << " | ";
+	for (double value : {perf.cycles, perf.instructions, perf.l1d_misses, perf.llc_misses,
+						 perf.branch_misses, perf.raw_event}) {
+		if (value < 0.0) {
+			std::cout << std::setw(perf_column_width) << "-";
+		} else {
+			std::cout << std::setw(perf_column_width) << value;
+		}
+	}
+}
+} // namespace
+
+HarnessConfig& harness_config() {
+	static HarnessConfig config = [] {
+		HarnessConfig cfg;
+		cfg.warmup_trials	   = env_int("RAW_BENCH_WARMUP", cfg.warmup_trials);
+		cfg.outlier_iqr_factor = env_double("RAW_BENCH_OUTLIER_IQR", cfg.outlier_iqr_factor);
+		cfg.pin_cpu			   = env_int("RAW_BENCH_PIN_CPU", cfg.pin_cpu);
+		cfg.perf_counters	   = env_int("RAW_BENCH_PERF", cfg.perf_counters) != 0;
+		if (const char* raw = std::getenv("RAW_BENCH_PERF_RAW")) {
+			cfg.perf_raw_config = std::strtoull(raw, nullptr, 0);
+		}
+		if (const char* seed = std::getenv("RAW_BENCH_TRACE_SEED")) {
+			cfg.trace_seed = std::strtoull(seed, nullptr, 0);
+		}
+		if (const char* dir = std::getenv("RAW_BENCH_TRACE_DIR")) {
+			cfg.trace_dir = dir;
+		}
+		if (const char* recording = std::getenv("RAW_BENCH_RECORDING")) {
+			cfg.recording_path = recording;
+		}
+		cfg.flush_caches = env_int("RAW_BENCH_CACHE_FLUSH", cfg.flush_caches) != 0;
+		if (const char* max_mb = std::getenv("RAW_BENCH_MAX_WORKING_SET_MB")) {
+			cfg.max_working_set_bytes = std::strtoull(max_mb, nullptr, 0) << 20;
+		}
+		return cfg;
+	}();
+	return config;
+}
+
+const CacheSizes& cache_sizes() {
+	static CacheSizes sizes = [] {
+		CacheSizes detected;
+#ifdef __linux__
+		const std::string sysfs_cache = "/sys/devices/system/cpu/cpu0/cache/index";
+		int				  last_level  = 0;
+		for (int index = 0;; ++index) {
+			std::string	  dir	= sysfs_cache + std::to_string(index);
+			std::ifstream level_file(dir + "/level");
+			std::ifstream type_file(dir + "/type");
+			std::ifstream size_file(dir + "/size");
+			int			  level	= 0;
+			std::string	  type;
+			size_t		  size	= 0;
+			char		  unit	= 'K';
+			if (!(level_file >> level) || !(type_file >> type) || !(size_file >> size)) {
+				break;
+			}
+			size_file >> unit;
+			size <<= unit == 'M' ? 20 : unit == 'G' ? 30 : 10;
+			if (level == 1 && type == "Data") {
+				detected.l1d = size;
+			} else if (level == 2) {
+				detected.l2 = size;
+			}
+			// Without an L3 the L2 is the last level
+			if (level >= 2 && level >= last_level) {
+				last_level	 = level;
+				detected.llc = size;
+			}
+		}
+#endif
+		return detected;
+	}();
+	return sizes;
+}
+
+void flush_data_caches() {
+	static std::vector<unsigned char> buffer(2 * cache_sizes().llc);
+	for (size_t i = 0; i < buffer.size(); i += 64) {
+		++buffer[i];
+	}
+	clobber_memory();
+}
+
+ScopedCpuPin::ScopedCpuPin(int cpu) {
+#ifdef __linux__
+	if (cpu < 0 || sched_getaffinity(0, sizeof(saved_mask), &saved_mask) != 0) {
+		return;
+	}
+	cpu_set_t target;
+	CPU_ZERO(&target);
+	CPU_SET(cpu, &target);
+	pinned = sched_setaffinity(0, sizeof(target), &target) == 0;
+	if (!pinned) {
+		std::cerr << "Could not pin benchmark thread to CPU " << cpu << ", running unpinned\n";
+	}
+#else
+	(void)cpu;
+#endif
+}
+
+ScopedCpuPin::~ScopedCpuPin() {
+#ifdef __linux__
+	if (pinned) {
+		sched_setaffinity(0, sizeof(saved_mask), &saved_mask);
+	}
+#endif
+}
+
+BenchmarkStats compute_stats(std::vector<double> per_op_ns) {
+	BenchmarkStats stats {};
+	if (per_op_ns.empty()) {
+		return stats;
+	}
+	std::sort(per_op_ns.begin(), per_op_ns.end());
+
+	// The tail is what min, max and the percentiles are for, so they see every sample
+	stats.min_ns  = per_op_ns.front();
+	stats.max_ns  = per_op_ns.back();
+	stats.p90_ns  = percentile(per_op_ns, 0.90);
+	stats.p99_ns  = percentile(per_op_ns, 0.99);
+	stats.p999_ns = percentile(per_op_ns, 0.999);
+
+	double factor = harness_config().outlier_iqr_factor;
+	if (factor > 0.0 && per_op_ns.size() >= 4) {
+		double q1	 = percentile(per_op_ns, 0.25);
+		double q3	 = percentile(per_op_ns, 0.75);
+		double lower = q1 - factor * (q3 - q1);
+		double upper = q3 + factor * (q3 - q1);
+
+		size_t before = per_op_ns.size();
+		std::erase_if(per_op_ns, [&](double sample) { return sample < lower || sample > upper; });
+		stats.outliers = static_cast<int>(before - per_op_ns.size());
+	}
+
+	double sum = 0.0;
+	for (double sample : per_op_ns) {
+		sum += sample;
+	}
+	stats.samples	= static_cast<int>(per_op_ns.size());
+	stats.mean_ns	= sum / per_op_ns.size();
+	stats.median_ns = percentile(per_op_ns, 0.50);
+	return stats;
+}
+
+void print_table_header() {
+	print_table_header("STD", "RAW");
+}
+
+void print_table_header(const std::string& std_label, const std::string& raw_label) {
+	set_report_labels(std_label, raw_label);
+	std::cout << "\n";
+	print_separator();
+	std::cout << std::left << std::setw(30) << "Scenario";
+	std::cout << "| " << std::right << std::setw(40) << std_label + " (ns/op)";
+	std::cout << " | " << std::right << std::setw(40) << raw_label + " (ns/op)";
+	std::cout << " | " << std::right << std::setw(34) << "Comparison";
+	std::cout << " | " << std::right << std::setw(14) << "Outliers";
+	std::cout << " | " << std::right << std::setw(24) << "Active Objects Start/End";
+	std::cout << " | " << std::setw(alloc_block_width - 3) << std_label + " heap/op";
+	std::cout << " | " << std::setw(alloc_block_width - 3) << raw_label + " heap/op";
+	if (harness_config().perf_counters) {
+		std::cout << " | " << std::setw(perf_block_width - 3) << std_label + " events/op";
+		std::cout << " | " << std::setw(perf_block_width - 3) << raw_label + " events/op";
+	}
+	std::cout << "\n";
+	std::cout << std::left << std::setw(30) << "";
+	for (int side = 0; side < 2; ++side) {
+		std::cout << (side == 0 ? "| " : " | ") << std::right << std::setw(10) << "Median"
+				  << std::setw(10) << "P90" << std::setw(10) << "P99" << std::setw(10) << "P99.9";
+	}
+	std::cout << " | " << std::right << std::setw(34)
+			  << raw_label + " vs " + std_label + " Median (%)";
+	std::cout << " | " << std::right << std::setw(7) << "Std" << std::setw(7) << "Raw";
+	std::cout << " | " << std::right << std::setw(12) << "Pre-test" << std::setw(12) << "Post-test";
+	for (int side = 0; side < 2; ++side) {
+		std::cout << " | " << std::setw(alloc_column_width) << "Allocs"
+				  << std::setw(alloc_column_width) << "Frees" << std::setw(alloc_column_width)
+				  << "Bytes" << std::setw(peak_column_width) << "Peak live B";
+	}
+	if (harness_config().perf_counters) {
+		for (int side = 0; side < 2; ++side) {
+			std::cout << " | ";
+			for (const char* event :
+				 {"Cycles", "Instr", "L1D-miss", "LLC-miss", "Br-miss", "Raw"}) {
+				std::cout << std::setw(perf_column_width) << event;
+			}
+		}
+	}
+	std::cout << "\n";
+	print_separator();
+}
+
+void print_table_row(const std::string& scenario_name, const TestResults& results,
+					 int initial_active_objects, int final_active_objects) {
+	record_report_row(scenario_name, results, initial_active_objects, final_active_objects);
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::left << std::setw(30) << scenario_name;
+
+	for (const BenchmarkStats* stats : {&results.std_stats, &results.raw_stats}) {
+		std::cout << (stats == &results.std_stats ? "| " : " | ") << std::right << std::setw(10)
+				  << stats->median_ns << std::setw(10) << stats->p90_ns << std::setw(10)
+				  << stats->p99_ns << std::setw(10) << stats->p999_ns;
+	}
+
+	std::cout << " | " << std::right;
+	std::cout << std::showpos << std::setw(34) << results.raw_vs_std_median_percent;
+	std::cout << std::noshowpos;
+
+	std::cout << " | " << std::right << std::setw(7) << results.std_stats.outliers << std::setw(7)
+			  << results.raw_stats.outliers;
+
+	std::cout << " | " << std::right << std::setw(12) << initial_active_objects << std::setw(12)
+			  << final_active_objects;
+
+	print_alloc_cells(results.std_alloc);
+	print_alloc_cells(results.raw_alloc);
+	if (harness_config().perf_counters) {
+		print_perf_cells(results.std_perf);
+		print_perf_cells(results.raw_perf);
+	}
+	std::cout << "\n";
+}
+
+TestResults run_benchmark_scenario(const std::string& scenario_name, int num_trials,
+								   int operations_per_trial, std::function<long long(int)> std_func,
+								   std::function<long long(int)> raw_func) {
+	const HarnessConfig& config = harness_config();
+	for (int i = 0; i < config.warmup_trials; ++i) {
+		std_func(operations_per_trial);
+		raw_func(operations_per_trial);
+	}
+
+	// Opened after warmup so only measured trials count; inherit covers threads started later
+	SideAccounting std_side;
+	SideAccounting raw_side;
+	if (config.perf_counters) {
+		std_side.perf.emplace(config.perf_raw_config);
+		raw_side.perf.emplace(config.perf_raw_config);
+		static bool warned = false;
+		if (!std_side.perf->any_available() && !warned) {
+			std::cerr << "Hardware counters unavailable (" << PerfCounters::last_error()
+					  << "), events/op columns stay empty\n";
+			warned = true;
+		}
+	}
+
+	const double ops = std::max(operations_per_trial, 1);
+
+	auto timed = [&](const std::function<long long(int)>& func, SideAccounting& side) {
+		active_side = &side;
+		double ns	= func(operations_per_trial) / ops;
+		active_side = nullptr;
+		return ns;
+	};
+
+	// Alternating which side goes first keeps slow drift (thermal, frequency) out of the ratio
+	std::vector<double> std_per_op_ns;
+	std::vector<double> raw_per_op_ns;
+	std_per_op_ns.reserve(num_trials);
+	raw_per_op_ns.reserve(num_trials);
+	for (int i = 0; i < num_trials; ++i) {
+		if (i % 2 == 0) {
+			std_per_op_ns.push_back(timed(std_func, std_side));
+			raw_per_op_ns.push_back(timed(raw_func, raw_side));
+		} else {
+			raw_per_op_ns.push_back(timed(raw_func, raw_side));
+			std_per_op_ns.push_back(timed(std_func, std_side));
+		}
+	}
+
+	TestResults results;
+	results.std_stats = compute_stats(std::move(std_per_op_ns));
+	results.raw_stats = compute_stats(std::move(raw_per_op_ns));
+
+	if (results.std_stats.median_ns != 0.0) {
+		results.raw_vs_std_median_percent =
+			(results.raw_stats.median_ns - results.std_stats.median_ns) /
+			results.std_stats.median_ns * 100.0;
+	} else {
+		results.raw_vs_std_median_percent = 0.0;
+	}
+	results.std_alloc = alloc_stats(std_side, ops * num_trials);
+	results.raw_alloc = alloc_stats(raw_side, ops * num_trials);
+	if (config.perf_counters) {
+		results.std_perf = std_side.perf->per_op(ops * num_trials);
+		results.raw_perf = raw_side.perf->per_op(ops * num_trials);
+	}
+	(void)scenario_name;
+	return results;
+}
+
+benchmark_clock::time_point trial_begin() {
+	if (harness_config().flush_caches) {
+		flush_data_caches();
+	}
+	if (active_side) {
+		active_side->trial_start		 = alloc_snapshot();
+		active_side->live_at_trial_start = alloc_thread_live_bytes();
+		alloc_reset_thread_peak();
+		if (active_side->perf) {
+			active_side->perf->enable();
+		}
+	}
+	return benchmark_clock::now();
+}
+
+benchmark_clock::time_point trial_end() {
+	benchmark_clock::time_point end = benchmark_clock::now();
+	if (active_side) {
+		if (active_side->perf) {
+			active_side->perf->disable();
+		}
+		AllocSnapshot  after	 = alloc_snapshot();
+		AllocSnapshot& allocated = active_side->allocated;
+		allocated.allocs += after.allocs - active_side->trial_start.allocs;
+		allocated.frees += after.frees - active_side->trial_start.frees;
+		allocated.bytes += after.bytes - active_side->trial_start.bytes;
+		active_side->peak_live_bytes =
+			std::max<long long>(active_side->peak_live_bytes,
+								alloc_thread_peak_bytes() - active_side->live_at_trial_start);
+	}
+	return end;
+}
+
+std::vector<int> benchmark_thread_counts() {
+	int				 hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<int> counts;
+	for (int threads = 1; threads < hardware_threads; threads *= 2) {
+		counts.push_back(threads);
+	}
+	counts.push_back(hardware_threads);
+	return counts;
+}
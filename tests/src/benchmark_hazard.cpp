@@ -0,0 +1,40 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_hazard.h"
+
+#include <iostream>
+
+void performance_comparison_hazard_test() {
+	std::cout << "\n--- Performance Comparison Test: weak_ptr::protect() vs weak_ptr::lock() ---\n";
+	begin_report_suite("hazard");
+
+	const int NUM_TRIALS	   = 10;
+	const int READS_PER_THREAD = 1000000;
+
+#ifdef RAW_MULTI_THREADED
+	std::vector<int> reader_counts = benchmark_thread_counts();
+#else
+	// Plain counters must stay on one thread
+	std::vector<int> reader_counts = {1};
+#endif
+
+	int initial_active_objects_before_test = s_active_concurrent_test_objects;
+
+	print_table_header("LOCK", "PROTECT");
+	for (int readers : reader_counts) {
+		std::string scenario_name = "Weak Readers x" + std::to_string(readers);
+		TestResults results		  = run_benchmark_scenario(
+			  scenario_name, NUM_TRIALS, READS_PER_THREAD,
+			  [&](int ops) { return run_weak_readers_test<LockReader>(ops, readers); },
+			  [&](int ops) { return run_weak_readers_test<ProtectReader>(ops, readers); });
+		print_table_row(scenario_name, results, initial_active_objects_before_test,
+						s_active_concurrent_test_objects);
+		verify_active_concurrent_objects(scenario_name, initial_active_objects_before_test);
+	}
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
@@ -0,0 +1,76 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_intrusive.h"
+
+#include <iostream>
+
+void performance_comparison_intrusive_test() {
+	std::cout << "\n--- Performance Comparison Test: raw::intrusive_ptr vs raw::shared_ptr ---\n";
+	begin_report_suite("intrusive");
+
+	const int NUM_TRIALS  = 10;
+	const int GRAPH_NODES = 1000000;
+
+	std::cout << "sizeof(raw::shared_ptr) = " << sizeof(raw::shared_ptr<SharedGraphNode>)
+			  << ", sizeof(raw::intrusive_ptr) = " << sizeof(raw::intrusive_ptr<IntrusiveGraphNode>)
+			  << ", graph nodes = " << GRAPH_NODES << "\n";
+
+	print_table_header("SHARED", "INTRUSIVE");
+
+	int initial_active_objects_before_test = s_active_test_objects;
+
+	auto make_shared_node = [](int val) {
+		raw::shared_ptr<SharedGraphNode> node = raw::make_shared<SharedGraphNode>();
+		node->value							  = val;
+		return node;
+	};
+	auto make_intrusive_node = [](int val) {
+		raw::intrusive_ptr<IntrusiveGraphNode> node = raw::make_intrusive<IntrusiveGraphNode>();
+		node->value									= val;
+		return node;
+	};
+
+	TestResults copy_results = run_benchmark_scenario(
+		"Graph Copy", NUM_TRIALS, GRAPH_NODES,
+		[&](int nodes) {
+			return run_graph_copy_test<raw::shared_ptr<SharedGraphNode>>(nodes, make_shared_node);
+		},
+		[&](int nodes) {
+			return run_graph_copy_test<raw::intrusive_ptr<IntrusiveGraphNode>>(
+				nodes, make_intrusive_node);
+		});
+	print_table_row("Graph Copy", copy_results, initial_active_objects_before_test,
+					s_active_test_objects);
+
+	TestResults destroy_results = run_benchmark_scenario(
+		"Graph Destroy", NUM_TRIALS, GRAPH_NODES,
+		[&](int nodes) {
+			return run_graph_destroy_test<raw::shared_ptr<SharedGraphNode>>(nodes,
+																			make_shared_node);
+		},
+		[&](int nodes) {
+			return run_graph_destroy_test<raw::intrusive_ptr<IntrusiveGraphNode>>(
+				nodes, make_intrusive_node);
+		});
+	print_table_row("Graph Destroy", destroy_results, initial_active_objects_before_test,
+					s_active_test_objects);
+
+	TestResults traversal_results = run_benchmark_scenario(
+		"Graph Traversal", NUM_TRIALS, GRAPH_NODES,
+		[&](int nodes) {
+			return run_graph_traversal_test<raw::shared_ptr<SharedGraphNode>>(nodes,
+																			  make_shared_node);
+		},
+		[&](int nodes) {
+			return run_graph_traversal_test<raw::intrusive_ptr<IntrusiveGraphNode>>(
+				nodes, make_intrusive_node);
+		});
+	print_table_row("Graph Traversal", traversal_results, initial_active_objects_before_test,
+					s_active_test_objects);
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
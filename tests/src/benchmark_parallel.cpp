@@ -0,0 +1,38 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_parallel.h"
+
+#include <iostream>
+
+void performance_comparison_parallel_test() {
+	std::cout << "\n--- Performance Comparison Test: building and dropping huge arrays ---\n";
+	begin_report_suite("parallel");
+
+	const int NUM_TRIALS = 5;
+	const int ELEMENTS	 = 1 << 22;
+
+	std::cout << "std:: side is serial, raw:: side uses raw::parallel(threads); arrays of "
+			  << ELEMENTS << " elements\n";
+
+	int initial_active_objects_before_test = s_active_test_objects;
+
+	print_table_header();
+	for (int threads : benchmark_thread_counts()) {
+		for (bool drop : {false, true}) {
+			std::string scenario_name =
+				std::string(drop ? "Array Drop x" : "Array Build x") + std::to_string(threads);
+			TestResults results = run_benchmark_scenario(
+				scenario_name, NUM_TRIALS, ELEMENTS,
+				[&](int elements) { return run_huge_array_test<false>(elements, 1, drop); },
+				[&](int elements) { return run_huge_array_test<true>(elements, threads, drop); });
+			print_table_row(scenario_name, results, initial_active_objects_before_test,
+							s_active_test_objects);
+		}
+	}
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
@@ -0,0 +1,35 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_rcu.h"
+
+#include <iostream>
+
+void performance_comparison_rcu_test() {
+	std::cout << "\n--- Performance Comparison Test: raw::rcu_ptr reader scaling ---\n";
+	begin_report_suite("rcu");
+
+	const int NUM_TRIALS	   = 10;
+	const int READS_PER_THREAD = 200000;
+
+	int initial_active_objects_before_test = s_active_concurrent_test_objects;
+
+	print_table_header("STD ATOMIC", "RCU");
+	for (int readers : benchmark_thread_counts()) {
+		std::string scenario_name = "Snapshot Readers x" + std::to_string(readers);
+		TestResults results		  = run_benchmark_scenario(
+			  scenario_name, NUM_TRIALS, READS_PER_THREAD,
+			  [&](int ops) {
+				  return run_snapshot_readers_test<StdAtomicSnapshotSlot>(ops, readers);
+			  },
+			  [&](int ops) { return run_snapshot_readers_test<RcuSnapshotSlot>(ops, readers); });
+		print_table_row(scenario_name, results, initial_active_objects_before_test,
+						s_active_concurrent_test_objects);
+		verify_active_concurrent_objects(scenario_name, initial_active_objects_before_test);
+	}
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
@@ -0,0 +1,99 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_reclaim.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+struct LatencySide {
+	std::string			name;
+	std::vector<double> latencies;
+};
+
+double latency_percentile(const std::vector<double>& sorted, double fraction) {
+	size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+	return sorted[index];
+}
+
+void print_percentile_table(std::vector<LatencySide>& sides) {
+	std::cout << std::left << std::setw(28) << "Requests (us)" << std::right;
+	for (const char* column : {"p50", "p90", "p99", "p99.9", "max"}) {
+		std::cout << " | " << std::setw(10) << column;
+	}
+	std::cout << "\n" << std::fixed << std::setprecision(2);
+	for (LatencySide& side : sides) {
+		std::sort(side.latencies.begin(), side.latencies.end());
+		std::cout << std::left << std::setw(28) << side.name << std::right;
+		for (double fraction : {0.50, 0.90, 0.99, 0.999, 1.0}) {
+			std::cout << " | " << std::setw(10)
+					  << latency_percentile(side.latencies, fraction) / 1000.0;
+		}
+		std::cout << "\n";
+	}
+}
+
+// Request counts per power-of-two latency bucket, one column per side
+void print_latency_histogram(const std::vector<LatencySide>& sides) {
+	double longest = 0.0;
+	for (const LatencySide& side : sides) {
+		longest = std::max(longest, side.latencies.back());
+	}
+	std::cout << "\n" << std::left << std::setw(28) << "Latency histogram" << std::right;
+	for (const LatencySide& side : sides) {
+		std::cout << " | " << std::setw(20) << side.name;
+	}
+	std::cout << "\n";
+	for (double upper = 1000.0, lower = 0.0; lower <= longest; lower = upper, upper *= 2.0) {
+		std::string bucket = "< " + std::to_string(static_cast<long long>(upper / 1000.0)) + " us";
+		std::cout << std::left << std::setw(28) << bucket << std::right;
+		for (const LatencySide& side : sides) {
+			auto first = std::lower_bound(side.latencies.begin(), side.latencies.end(), lower);
+			auto last  = std::lower_bound(side.latencies.begin(), side.latencies.end(), upper);
+			std::cout << " | " << std::setw(20) << last - first;
+		}
+		std::cout << "\n";
+	}
+}
+} // namespace
+
+void performance_comparison_reclaim_test() {
+	std::cout << "\n--- Performance Comparison Test: dropping a large snapshot ---\n";
+
+	SnapshotWorkload workload {};
+	workload.requests		= 5000;
+	workload.swap_every		= 50;
+	workload.snapshot_nodes = (1 << 15) - 1;
+	workload.response_nodes = 63;
+
+	int initial_active_objects_before_test = s_active_test_objects;
+
+	std::vector<LatencySide> sides;
+	sides.push_back({"std::shared_ptr", run_snapshot_requests<StdPointerFamily>(workload, false)});
+	sides.push_back({"raw inline", run_snapshot_requests<RawPointerFamily>(workload, false)});
+#ifdef RAW_DEFERRED_RECLAIM
+	sides.push_back(
+		{"raw deferred, drain", run_snapshot_requests<RawPointerFamily>(workload, true)});
+	if (raw::deferred_deleter::start()) {
+		sides.push_back(
+			{"raw deferred, thread", run_snapshot_requests<RawPointerFamily>(workload, true)});
+		raw::deferred_deleter::stop();
+	}
+#else
+	std::cout << "Configure with RAW_DEFERRED_RECLAIM=ON to compare deferred reclamation\n";
+#endif
+	verify_active_objects("Snapshot requests", initial_active_objects_before_test);
+
+	std::cout << "One in " << workload.swap_every << " of " << workload.requests
+			  << " requests drops a " << workload.snapshot_nodes << " node snapshot\n";
+	print_percentile_table(sides);
+	print_latency_histogram(sides);
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
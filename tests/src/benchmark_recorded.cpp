@@ -0,0 +1,79 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_recorded.h"
+
+#include <iostream>
+#include <memory>
+
+void performance_comparison_recorded_test() {
+	std::cout << "\n--- Performance Comparison Test: recorded workload replay ---\n";
+	begin_report_suite("recorded");
+	ScopedCpuPin pin(harness_config().pin_cpu);
+
+	const int NUM_TRIALS	= 100;
+	const int REPLAY_LENGTH = 10000;
+	const int POOL_SIZE		= 100;
+
+	const HarnessConfig& config = harness_config();
+	OpTrace				 recording;
+	const OpTrace*		 replay = nullptr;
+	if (!config.recording_path.empty()) {
+		if (load_recording(config.recording_path, recording)) {
+			std::cout << "Replaying " << recording.ops.size() << " recorded operations on "
+					  << recording.pool_size << " objects from " << config.recording_path
+					  << "\n";
+			// Kept in the trace format, later runs can replay it without the recording
+			if (!config.trace_dir.empty() &&
+				!save_op_trace(recording, config.trace_dir + "/recorded.trace")) {
+				std::cerr << "Could not write " << config.trace_dir << "/recorded.trace\n";
+			}
+			replay = &recording;
+		} else {
+			std::cerr << config.recording_path
+					  << " is not an operation recording, replaying a generated trace instead\n";
+		}
+	}
+	if (!replay) {
+		replay = &stress_trace("recorded", static_cast<uint32_t>(raw::recorded_op::count),
+							   POOL_SIZE, REPLAY_LENGTH);
+	}
+
+	print_table_header();
+
+	int initial_active_objects_before_test = s_active_test_objects;
+
+	auto std_make_shared_single = [](int val) {
+		return std::make_shared<TestObject>(val);
+	};
+	auto raw_make_shared_single = [](int val) {
+		return raw::make_shared<TestObject>(val);
+	};
+	auto std_make_unique_single = [](int val) {
+		return std::make_unique<TestObject>(val);
+	};
+	auto raw_make_unique_single = [](int val) {
+		return raw::make_unique<TestObject>(val);
+	};
+
+	TestResults replay_results = run_benchmark_scenario(
+		"Recorded Workload Replay", NUM_TRIALS, static_cast<int>(replay->ops.size()),
+		[&](int) {
+			return run_recorded_replay_test<std::shared_ptr<TestObject>, std::weak_ptr<TestObject>,
+											std::unique_ptr<TestObject>>(
+				*replay, std_make_shared_single, std_make_unique_single);
+		},
+		[&](int) {
+			return run_recorded_replay_test<raw::shared_ptr<TestObject>, raw::weak_ptr<TestObject>,
+											raw::unique_ptr<TestObject>>(
+				*replay, raw_make_shared_single, raw_make_unique_single);
+		});
+	print_table_row("Recorded Workload Replay", replay_results, initial_active_objects_before_test,
+					s_active_test_objects);
+	verify_active_objects("Recorded Workload Replay", initial_active_objects_before_test);
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
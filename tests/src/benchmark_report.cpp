@@ -0,0 +1,476 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_report.h"
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef RAW_BUILD_FLAGS
+#define RAW_BUILD_FLAGS "unknown"
+#endif
+
+namespace {
+struct ReportRow {
+	std::string suite;
+	std::string scenario;
+	std::string std_label;
+	std::string raw_label;
+	TestResults results;
+	int			initial_active_objects;
+	int			final_active_objects;
+};
+
+struct ReportState {
+	std::string			   suite	 = "default";
+	std::string			   std_label = "STD";
+	std::string			   raw_label = "RAW";
+	std::vector<ReportRow> rows;
+};
+
+ReportState& report_state() {
+	static ReportState state;
+	return state;
+}
+
+void print_usage(const char* program) {
+	std::cerr << "Usage: " << program
+			  << " [--json=PATH] [--csv=PATH] [--baseline=CSV_PATH] [--threshold=PERCENT]\n"
+			  << "  --json, --csv  write every benchmark row with build metadata to PATH\n"
+			  << "  --baseline     compare RAW medians against a CSV written by --csv\n"
+			  << "  --threshold    slowdown in percent that counts as a regression (default 5)\n";
+}
+
+std::string compiler_name() {
+#if defined(__clang__)
+	return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+	return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+	return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+	return "unknown";
+#endif
+}
+
+std::string cpu_model() {
+	std::ifstream cpuinfo("/proc/cpuinfo");
+	std::string	  line;
+	while (std::getline(cpuinfo, line)) {
+		if (line.rfind("model name", 0) == 0 || line.rfind("Processor", 0) == 0) {
+			size_t colon = line.find(':');
+			if (colon != std::string::npos && colon + 2 <= line.size()) {
+				return line.substr(colon + 2);
+			}
+		}
+	}
+	return "unknown";
+}
+
+std::string utc_timestamp() {
+	std::time_t now = std::time(nullptr);
+	std::tm	   utc {};
+#ifdef _WIN32
+	gmtime_s(&utc, &now);
+#else
+	gmtime_r(&now, &utc);
+#endif
+	std::ostringstream out;
+	out << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ");
+	return out.str();
+}
+
+std::vector<std::pair<std::string, std::string>> environment_metadata() {
+	return {
+		{"compiler", compiler_name()},
+		{"flags", RAW_BUILD_FLAGS},
+#ifdef RAW_MULTI_THREADED
+		{"counting", "atomic"},
+#else
+		{"counting", "plain"},
+#endif
+		{"cpu_model", cpu_model()},
+		{"hardware_threads", std::to_string(std::thread::hardware_concurrency())},
+		{"timestamp", utc_timestamp()},
+	};
+}
+
+std::string json_escape(const std::string& text) {
+	std::ostringstream out;
+	for (char c : text) {
+		switch (c) {
+		case '"':
+			out << "\\\"";
+			break;
+		case '\\':
+			out << "\\\\";
+			break;
+		case '\n':
+			out << "\\n";
+			break;
+		case '\t':
+			out << "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+					<< std::dec << std::setfill(' ');
+			} else {
+				out << c;
+			}
+		}
+	}
+	return out.str();
+}
+
+std::string csv_escape(const std::string& text) {
+	if (text.find_first_of(",\"\n") == std::string::npos) {
+		return text;
+	}
+	std::string quoted = "\"";
+	for (char c : text) {
+		quoted += c;
+		if (c == '"') {
+			quoted += '"';
+		}
+	}
+	return quoted + "\"";
+}
+
+std::vector<std::string> split_csv_line(const std::string& line) {
+	std::vector<std::string> fields(1);
+	bool					 quoted = false;
+	for (size_t i = 0; i < line.size(); ++i) {
+		char c = line[i];
+		if (quoted) {
+			if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+				fields.back() += '"';
+				++i;
+			} else if (c == '"') {
+				quoted = false;
+			} else {
+				fields.back() += c;
+			}
+		} else if (c == '"') {
+			quoted = true;
+		} else if (c == ',') {
+			fields.emplace_back();
+		} else if (c != '\r') {
+			fields.back() += c;
+		}
+	}
+	return fields;
+}
+
+std::vector<std::pair<const char*, double>> perf_fields(const PerfCounterStats& perf) {
+	return {{"cycles_per_op", perf.cycles},
+			{"instructions_per_op", perf.instructions},
+			{"l1d_misses_per_op", perf.l1d_misses},
+			{"llc_misses_per_op", perf.llc_misses},
+			{"branch_misses_per_op", perf.branch_misses},
+			{"raw_event_per_op", perf.raw_event}};
+}
+
+std::vector<std::pair<const char*, double>> alloc_fields(const AllocStats& alloc) {
+	return {{"allocs_per_op", alloc.allocs_per_op},
+			{"frees_per_op", alloc.frees_per_op},
+			{"bytes_per_op", alloc.bytes_per_op},
+			{"peak_live_bytes", static_cast<double>(alloc.peak_live_bytes)}};
+}
+
+void write_json_stats(std::ostream& out, const char* name, const BenchmarkStats& stats) {
+	out << "\"" << name << "\": {\"median_ns\": " << stats.median_ns
+		<< ", \"p90_ns\": " << stats.p90_ns << ", \"p99_ns\": " << stats.p99_ns
+		<< ", \"p999_ns\": " << stats.p999_ns << ", \"mean_ns\": " << stats.mean_ns
+		<< ", \"min_ns\": " << stats.min_ns << ", \"max_ns\": " << stats.max_ns
+		<< ", \"samples\": " << stats.samples << ", \"outliers\": " << stats.outliers << "}";
+}
+
+// Values that were not collected are written as null
+void write_json_fields(std::ostream& out, const char* name,
+					   const std::vector<std::pair<const char*, double>>& fields) {
+	out << "\"" << name << "\": {";
+	const char* separator = "";
+	for (const auto& [key, value] : fields) {
+		out << separator << "\"" << key << "\": ";
+		if (value < 0.0) {
+			out << "null";
+		} else {
+			out << value;
+		}
+		separator = ", ";
+	}
+	out << "}";
+}
+
+bool write_json(const std::string& path) {
+	std::ofstream out(path);
+	if (!out) {
+		return false;
+	}
+	out << std::fixed << std::setprecision(3);
+	out << "{\n  \"environment\": {";
+	const char* separator = "\n";
+	for (const auto& [key, value] : environment_metadata()) {
+		out << separator << "    \"" << key << "\": \"" << json_escape(value) << "\"";
+		separator = ",\n";
+	}
+	out << "\n  },\n  \"results\": [";
+	separator = "\n";
+	for (const ReportRow& row : report_state().rows) {
+		out << separator << "    {\"suite\": \"" << json_escape(row.suite) << "\", \"scenario\": \""
+			<< json_escape(row.scenario) << "\", \"std_label\": \"" << json_escape(row.std_label)
+			<< "\", \"raw_label\": \"" << json_escape(row.raw_label) << "\",\n     ";
+		write_json_stats(out, "std", row.results.std_stats);
+		out << ",\n     ";
+		write_json_stats(out, "raw", row.results.raw_stats);
+		out << ",\n     ";
+		write_json_fields(out, "std_alloc", alloc_fields(row.results.std_alloc));
+		out << ",\n     ";
+		write_json_fields(out, "raw_alloc", alloc_fields(row.results.raw_alloc));
+		out << ",\n     ";
+		write_json_fields(out, "std_perf", perf_fields(row.results.std_perf));
+		out << ",\n     ";
+		write_json_fields(out, "raw_perf", perf_fields(row.results.raw_perf));
+		out << ",\n     \"raw_vs_std_median_percent\": " << row.results.raw_vs_std_median_percent
+			<< ", \"active_objects_pre\": " << row.initial_active_objects
+			<< ", \"active_objects_post\": " << row.final_active_objects << "}";
+		separator = ",\n";
+	}
+	out << "\n  ]\n}\n";
+	return static_cast<bool>(out);
+}
+
+void write_csv_stats(std::ostream& out, const BenchmarkStats& stats) {
+	out << stats.median_ns << "," << stats.p90_ns << "," << stats.p99_ns << "," << stats.p999_ns
+		<< "," << stats.mean_ns << "," << stats.min_ns << "," << stats.max_ns << ","
+		<< stats.samples << "," << stats.outliers;
+}
+
+bool write_csv(const std::string& path) {
+	std::ofstream out(path);
+	if (!out) {
+		return false;
+	}
+	// Metadata goes into comment lines so every data row keeps the same columns
+	for (const auto& [key, value] : environment_metadata()) {
+		out << "# " << key << ": " << value << "\n";
+	}
+	out << "suite,scenario,std_label,raw_label";
+	for (const char* side : {"std", "raw"}) {
+		for (const char* column : {"median_ns", "p90_ns", "p99_ns", "p999_ns", "mean_ns", "min_ns",
+								   "max_ns", "samples", "outliers"}) {
+			out << "," << side << "_" << column;
+		}
+	}
+	out << ",raw_vs_std_median_percent,active_objects_pre,active_objects_post";
+	for (const char* side : {"std", "raw"}) {
+		for (const auto& [column, value] : alloc_fields(AllocStats {})) {
+			out << "," << side << "_" << column;
+		}
+	}
+	for (const char* side : {"std", "raw"}) {
+		for (const auto& [column, value] : perf_fields(PerfCounterStats {})) {
+			out << "," << side << "_" << column;
+		}
+	}
+	out << "\n";
+
+	out << std::fixed << std::setprecision(3);
+	for (const ReportRow& row : report_state().rows) {
+		out << csv_escape(row.suite) << "," << csv_escape(row.scenario) << ","
+			<< csv_escape(row.std_label) << "," << csv_escape(row.raw_label) << ",";
+		write_csv_stats(out, row.results.std_stats);
+		out << ",";
+		write_csv_stats(out, row.results.raw_stats);
+		out << "," << row.results.raw_vs_std_median_percent << "," << row.initial_active_objects
+			<< "," << row.final_active_objects;
+		for (const auto& fields :
+			 {alloc_fields(row.results.std_alloc), alloc_fields(row.results.raw_alloc),
+			  perf_fields(row.results.std_perf), perf_fields(row.results.raw_perf)}) {
+			for (const auto& [column, value] : fields) {
+				out << ",";
+				if (value >= 0.0) {
+					out << value;
+				}
+			}
+		}
+		out << "\n";
+	}
+	return static_cast<bool>(out);
+}
+
+using baseline_key = std::pair<std::string, std::string>;
+
+// RAW medians keyed by (suite, scenario), empty if the file is missing or has no such columns
+std::map<baseline_key, double> load_baseline(const std::string& path) {
+	std::map<baseline_key, double> medians;
+	std::ifstream				   in(path);
+	std::string					   line;
+	int							   suite_col	= -1;
+	int							   scenario_col	= -1;
+	int							   median_col	= -1;
+	while (std::getline(in, line)) {
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		std::vector<std::string> fields = split_csv_line(line);
+		if (suite_col < 0) {
+			for (int i = 0; i < static_cast<int>(fields.size()); ++i) {
+				if (fields[i] == "suite") {
+					suite_col = i;
+				} else if (fields[i] == "scenario") {
+					scenario_col = i;
+				} else if (fields[i] == "raw_median_ns") {
+					median_col = i;
+				}
+			}
+			if (suite_col < 0 || scenario_col < 0 || median_col < 0) {
+				return {};
+			}
+			continue;
+		}
+		if (static_cast<int>(fields.size()) <= median_col) {
+			continue;
+		}
+		medians[{fields[suite_col], fields[scenario_col]}] = std::atof(fields[median_col].c_str());
+	}
+	return medians;
+}
+
+// Prints one line per scenario, returns how many regressed beyond the threshold, or -1 if the
+// baseline could not be read or has no usable rows
+int compare_with_baseline(const std::string& path, double threshold_percent) {
+	std::map<baseline_key, double> baseline = load_baseline(path);
+	std::cout << "\n--- Baseline Comparison: " << path << " (threshold +" << threshold_percent
+			  << "%) ---\n";
+	if (baseline.empty()) {
+		// A missing or mistyped baseline must not let the regression check pass
+		std::cerr << "Could not read any rows from baseline " << path << "\n";
+		return -1;
+	}
+
+	std::cout << std::left << std::setw(50) << "Suite / Scenario"
+			  << "| " << std::right << std::setw(16) << "Baseline (ns/op)"
+			  << " | " << std::setw(16) << "Current (ns/op)"
+			  << " | " << std::setw(12) << "Change (%)"
+			  << " | " << std::setw(10) << "Status" << "\n";
+
+	int regressions = 0;
+	std::cout << std::fixed << std::setprecision(2);
+	for (const ReportRow& row : report_state().rows) {
+		std::cout << std::left << std::setw(50) << row.suite + " / " + row.scenario << "| "
+				  << std::right;
+		auto found = baseline.find({row.suite, row.scenario});
+		if (found == baseline.end()) {
+			std::cout << std::setw(16) << "-"
+					  << " | " << std::setw(16) << row.results.raw_stats.median_ns << " | "
+					  << std::setw(12) << "-"
+					  << " | " << std::setw(10) << "new" << "\n";
+			continue;
+		}
+		double before	 = found->second;
+		double after	 = row.results.raw_stats.median_ns;
+		double change	 = before != 0.0 ? (after - before) / before * 100.0 : 0.0;
+		bool   regressed = change > threshold_percent;
+		regressions += regressed;
+		std::cout << std::setw(16) << before << " | " << std::setw(16) << after << " | "
+				  << std::showpos << std::setw(12) << change << std::noshowpos << " | "
+				  << std::setw(10) << (regressed ? "REGRESSED" : "ok") << "\n";
+	}
+	std::cout << regressions << " scenario(s) regressed.\n";
+	return regressions;
+}
+} // namespace
+
+ReportOptions& report_options() {
+	static ReportOptions options;
+	return options;
+}
+
+bool parse_report_args(int argc, char* argv[]) {
+	ReportOptions& options = report_options();
+	for (int i = 1; i < argc; ++i) {
+		std::string	arg	  = argv[i];
+		size_t		eq	  = arg.find('=');
+		std::string	key	  = arg.substr(0, eq);
+		std::string	value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+		if (eq == std::string::npos || value.empty()) {
+			print_usage(argv[0]);
+			return false;
+		}
+		if (key == "--json") {
+			options.json_path = value;
+		} else if (key == "--csv") {
+			options.csv_path = value;
+		} else if (key == "--baseline") {
+			options.baseline_path = value;
+		} else if (key == "--threshold") {
+			char*  end		 = nullptr;
+			double threshold = std::strtod(value.c_str(), &end);
+			if (*end != '\0' || threshold < 0.0) {
+				print_usage(argv[0]);
+				return false;
+			}
+			options.regression_threshold_percent = threshold;
+		} else {
+			print_usage(argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+void begin_report_suite(const std::string& suite) {
+	ReportState& state = report_state();
+	state.suite		   = suite;
+	state.std_label	   = "STD";
+	state.raw_label	   = "RAW";
+}
+
+void set_report_labels(const std::string& std_label, const std::string& raw_label) {
+	report_state().std_label = std_label;
+	report_state().raw_label = raw_label;
+}
+
+void record_report_row(const std::string& scenario_name, const TestResults& results,
+					   int initial_active_objects, int final_active_objects) {
+	ReportState& state = report_state();
+	state.rows.push_back({state.suite, scenario_name, state.std_label, state.raw_label, results,
+						  initial_active_objects, final_active_objects});
+}
+
+bool finish_report() {
+	const ReportOptions& options = report_options();
+	bool				 passed	 = true;
+	if (!options.json_path.empty()) {
+		if (write_json(options.json_path)) {
+			std::cout << "Benchmark results written to " << options.json_path << "\n";
+		} else {
+			std::cerr << "Could not write " << options.json_path << "\n";
+			passed = false;
+		}
+	}
+	if (!options.csv_path.empty()) {
+		if (write_csv(options.csv_path)) {
+			std::cout << "Benchmark results written to " << options.csv_path << "\n";
+		} else {
+			std::cerr << "Could not write " << options.csv_path << "\n";
+			passed = false;
+		}
+	}
+	if (!options.baseline_path.empty() &&
+		compare_with_baseline(options.baseline_path, options.regression_threshold_percent) != 0) {
+		passed = false;
+	}
+	return passed;
+}
@@ -6,14 +6,8 @@
 
 #include <iostream>
 
-long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_pointers_in_pool) {
-	std::random_device				rd;
-	std::mt19937					gen(rd());
-	std::uniform_int_distribution<> dist_op(0, 16);
-	std::uniform_int_distribution<> dist_idx(0, max_pointers_in_pool - 1);
-	std::uniform_int_distribution<> dist_val(0, 9999);
-	std::uniform_int_distribution<> dist_array_size_gen(1, 10);
-	std::uniform_int_distribution<> dist_extra_op_chance(0, 9);
+long long run_combined_stress_impl_shared(bool use_raw, const OpTrace& trace) {
+	const size_t max_pointers_in_pool = trace.pool_size;
 
 	std::vector<std::shared_ptr<TestObject>>   std_single_ptrs;
 	std::vector<std::shared_ptr<TestObject[]>> std_array_ptrs;
@@ -30,35 +24,32 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 		std_array_ptrs.resize(max_pointers_in_pool);
 	}
 
-	auto start_time = std::chrono::high_resolution_clock::now();
+	auto start_time = trial_begin();
 
-	for (int i = 0; i < iterations; ++i) {
-		int op	 = dist_op(gen);
-		int idx1 = dist_idx(gen);
-		int idx2 = dist_idx(gen);
+	for (const TraceOp& step : trace.ops) {
+		int		 op	  = step.op;
+		uint32_t idx1 = step.idx1;
+		uint32_t idx2 = step.idx2;
 
 		if (use_raw) {
 			switch (op) {
 			case 0:
-				raw_single_ptrs[idx1] = raw::make_shared<TestObject>(dist_val(gen));
-				if (raw_single_ptrs[idx1] && dist_extra_op_chance(gen) < 1) {
-					volatile size_t count = raw_single_ptrs[idx1].use_count();
-					(void)count;
+				raw_single_ptrs[idx1] = raw::make_shared<TestObject>(step.value);
+				if (raw_single_ptrs[idx1] && step.chance < 10) {
+					do_not_optimize(raw_single_ptrs[idx1].use_count());
 				}
 				break;
 			case 1:
 				raw_single_ptrs[idx1].reset();
-				if (dist_extra_op_chance(gen) < 1) {
-					volatile bool is_null = (raw_single_ptrs[idx1].get() == nullptr);
-					(void)is_null;
+				if (step.chance < 10) {
+					do_not_optimize((raw_single_ptrs[idx1].get() == nullptr));
 				}
 				break;
 			case 2:
 				if (raw_single_ptrs[idx2]) {
 					raw_single_ptrs[idx1] = raw_single_ptrs[idx2];
-					if (dist_extra_op_chance(gen) < 1) {
-						volatile size_t count = raw_single_ptrs[idx1].use_count();
-						(void)count;
+					if (step.chance < 10) {
+						do_not_optimize(raw_single_ptrs[idx1].use_count());
 					}
 				} else {
 					raw_single_ptrs[idx1].reset();
@@ -67,9 +58,8 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 			case 3:
 				if (raw_single_ptrs[idx2]) {
 					raw_single_ptrs[idx1] = std::move(raw_single_ptrs[idx2]);
-					if (dist_extra_op_chance(gen) < 1) {
-						volatile bool was_moved_from = (raw_single_ptrs[idx2].get() == nullptr);
-						(void)was_moved_from;
+					if (step.chance < 10) {
+						do_not_optimize((raw_single_ptrs[idx2].get() == nullptr));
 					}
 				} else {
 					raw_single_ptrs[idx1].reset();
@@ -82,45 +72,39 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 				raw_single_ptrs[idx1].swap(raw_single_ptrs[idx2]);
 				break;
 			case 6:
-				raw_single_ptrs[idx1].reset(new TestObject(dist_val(gen)));
+				raw_single_ptrs[idx1].reset(new TestObject(step.value));
 				break;
 			case 7:
 				if (raw_single_ptrs[idx1]) {
-					volatile int id = raw_single_ptrs[idx1]->id;
-					(void)id;
+					do_not_optimize(raw_single_ptrs[idx1]->id);
 				}
 				break;
 			case 8:
 				if (raw_single_ptrs[idx1]) {
-					volatile TestObject* p = raw_single_ptrs[idx1].get();
-					(void)p;
+					do_not_optimize(raw_single_ptrs[idx1].get());
 				}
 				break;
 			case 9: {
-				size_t current_array_size = dist_array_size_gen(gen);
+				size_t current_array_size = step.array_size;
 				raw_array_ptrs[idx1]	  = raw::make_shared<TestObject[]>(current_array_size);
 				array_actual_sizes[idx1]  = current_array_size;
-				if (raw_array_ptrs[idx1] && current_array_size > 0 &&
-					dist_extra_op_chance(gen) < 1) {
-					volatile int dummy_val = raw_array_ptrs[idx1][0].id;
-					(void)dummy_val;
+				if (raw_array_ptrs[idx1] && current_array_size > 0 && step.chance < 10) {
+					do_not_optimize(raw_array_ptrs[idx1][0].id);
 				}
 			} break;
 			case 10:
 				raw_array_ptrs[idx1].reset();
 				array_actual_sizes[idx1] = 0;
-				if (dist_extra_op_chance(gen) < 1) {
-					volatile bool is_null = (raw_array_ptrs[idx1].get() == nullptr);
-					(void)is_null;
+				if (step.chance < 10) {
+					do_not_optimize((raw_array_ptrs[idx1].get() == nullptr));
 				}
 				break;
 			case 11:
 				if (raw_array_ptrs[idx2]) {
 					raw_array_ptrs[idx1]	 = raw_array_ptrs[idx2];
 					array_actual_sizes[idx1] = array_actual_sizes[idx2];
-					if (dist_extra_op_chance(gen) < 1) {
-						volatile size_t count = raw_array_ptrs[idx1].use_count();
-						(void)count;
+					if (step.chance < 10) {
+						do_not_optimize(raw_array_ptrs[idx1].use_count());
 					}
 				} else {
 					raw_array_ptrs[idx1].reset();
@@ -131,9 +115,8 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 				raw_array_ptrs[idx1]	 = std::move(raw_array_ptrs[idx2]);
 				array_actual_sizes[idx1] = array_actual_sizes[idx2];
 				array_actual_sizes[idx2] = 0;
-				if (dist_extra_op_chance(gen) < 1) {
-					volatile bool was_moved_from = (raw_array_ptrs[idx2].get() == nullptr);
-					(void)was_moved_from;
+				if (step.chance < 10) {
+					do_not_optimize((raw_array_ptrs[idx2].get() == nullptr));
 				}
 				break;
 			case 13:
@@ -142,24 +125,19 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 				break;
 			case 14:
 				if (raw_single_ptrs[idx1]) {
-					volatile size_t count = raw_single_ptrs[idx1].use_count();
-					(void)count;
+					do_not_optimize(raw_single_ptrs[idx1].use_count());
 				}
 				break;
 			case 15:
 				if (raw_single_ptrs[idx1]) {
-					volatile bool is_unique = raw_single_ptrs[idx1].unique();
-					(void)is_unique;
+					do_not_optimize(raw_single_ptrs[idx1].unique());
 				}
 				break;
 			case 16: {
-				int access_idx = dist_idx(gen);
-				if (raw_array_ptrs[access_idx] && array_actual_sizes[access_idx] > 0) {
-					size_t elem_idx = std::uniform_int_distribution<size_t>(
-						0, array_actual_sizes[access_idx] - 1)(gen);
-					raw_array_ptrs[access_idx][elem_idx].id = dist_val(gen);
-					volatile int read_val = raw_array_ptrs[access_idx][elem_idx].id;
-					(void)read_val;
+				if (raw_array_ptrs[idx2] && array_actual_sizes[idx2] > 0) {
+					size_t elem_idx					  = step.element % array_actual_sizes[idx2];
+					raw_array_ptrs[idx2][elem_idx].id = step.value;
+					do_not_optimize(raw_array_ptrs[idx2][elem_idx].id);
 				}
 			} break;
 			default:
@@ -168,25 +146,22 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 		} else {
 			switch (op) {
 			case 0:
-				std_single_ptrs[idx1] = std::make_shared<TestObject>(dist_val(gen));
-				if (std_single_ptrs[idx1] && dist_extra_op_chance(gen) < 1) {
-					volatile size_t count = std_single_ptrs[idx1].use_count();
-					(void)count;
+				std_single_ptrs[idx1] = std::make_shared<TestObject>(step.value);
+				if (std_single_ptrs[idx1] && step.chance < 10) {
+					do_not_optimize(std_single_ptrs[idx1].use_count());
 				}
 				break;
 			case 1:
 				std_single_ptrs[idx1].reset();
-				if (dist_extra_op_chance(gen) < 1) {
-					volatile bool is_null = (std_single_ptrs[idx1].get() == nullptr);
-					(void)is_null;
+				if (step.chance < 10) {
+					do_not_optimize((std_single_ptrs[idx1].get() == nullptr));
 				}
 				break;
 			case 2:
 				if (std_single_ptrs[idx2]) {
 					std_single_ptrs[idx1] = std_single_ptrs[idx2];
-					if (dist_extra_op_chance(gen) < 1) {
-						volatile size_t count = std_single_ptrs[idx1].use_count();
-						(void)count;
+					if (step.chance < 10) {
+						do_not_optimize(std_single_ptrs[idx1].use_count());
 					}
 				} else {
 					std_single_ptrs[idx1].reset();
@@ -195,9 +170,8 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 			case 3:
 				if (std_single_ptrs[idx2]) {
 					std_single_ptrs[idx1] = std::move(std_single_ptrs[idx2]);
-					if (dist_extra_op_chance(gen) < 1) {
-						volatile bool was_moved_from = (std_single_ptrs[idx2].get() == nullptr);
-						(void)was_moved_from;
+					if (step.chance < 10) {
+						do_not_optimize((std_single_ptrs[idx2].get() == nullptr));
 					}
 				} else {
 					std_single_ptrs[idx1].reset();
@@ -210,45 +184,39 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 				std_single_ptrs[idx1].swap(std_single_ptrs[idx2]);
 				break;
 			case 6:
-				std_single_ptrs[idx1].reset(new TestObject(dist_val(gen)));
+				std_single_ptrs[idx1].reset(new TestObject(step.value));
 				break;
 			case 7:
 				if (std_single_ptrs[idx1]) {
-					volatile int id = std_single_ptrs[idx1]->id;
-					(void)id;
+					do_not_optimize(std_single_ptrs[idx1]->id);
 				}
 				break;
 			case 8:
 				if (std_single_ptrs[idx1]) {
-					volatile TestObject* p = std_single_ptrs[idx1].get();
-					(void)p;
+					do_not_optimize(std_single_ptrs[idx1].get());
 				}
 				break;
 			case 9: {
-				size_t current_array_size = dist_array_size_gen(gen);
+				size_t current_array_size = step.array_size;
 				std_array_ptrs[idx1]	  = std::make_shared<TestObject[]>(current_array_size);
 				array_actual_sizes[idx1]  = current_array_size;
-				if (std_array_ptrs[idx1] && current_array_size > 0 &&
-					dist_extra_op_chance(gen) < 1) {
-					volatile int dummy_val = std_array_ptrs[idx1][0].id;
-					(void)dummy_val;
+				if (std_array_ptrs[idx1] && current_array_size > 0 && step.chance < 10) {
+					do_not_optimize(std_array_ptrs[idx1][0].id);
 				}
 			} break;
 			case 10:
 				std_array_ptrs[idx1].reset();
 				array_actual_sizes[idx1] = 0;
-				if (dist_extra_op_chance(gen) < 1) {
-					volatile bool is_null = (std_array_ptrs[idx1].get() == nullptr);
-					(void)is_null;
+				if (step.chance < 10) {
+					do_not_optimize((std_array_ptrs[idx1].get() == nullptr));
 				}
 				break;
 			case 11:
 				if (std_array_ptrs[idx2]) {
 					std_array_ptrs[idx1]	 = std_array_ptrs[idx2];
 					array_actual_sizes[idx1] = array_actual_sizes[idx2];
-					if (dist_extra_op_chance(gen) < 1) {
-						volatile size_t count = std_array_ptrs[idx1].use_count();
-						(void)count;
+					if (step.chance < 10) {
+						do_not_optimize(std_array_ptrs[idx1].use_count());
 					}
 				} else {
 					std_array_ptrs[idx1].reset();
@@ -259,9 +227,8 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 				std_array_ptrs[idx1]	 = std::move(std_array_ptrs[idx2]);
 				array_actual_sizes[idx1] = array_actual_sizes[idx2];
 				array_actual_sizes[idx2] = 0;
-				if (dist_extra_op_chance(gen) < 1) {
-					volatile bool was_moved_from = (std_array_ptrs[idx2].get() == nullptr);
-					(void)was_moved_from;
+				if (step.chance < 10) {
+					do_not_optimize((std_array_ptrs[idx2].get() == nullptr));
 				}
 				break;
 			case 13:
@@ -270,24 +237,19 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 				break;
 			case 14:
 				if (std_single_ptrs[idx1]) {
-					volatile size_t count = std_single_ptrs[idx1].use_count();
-					(void)count;
+					do_not_optimize(std_single_ptrs[idx1].use_count());
 				}
 				break;
 			case 15:
 				if (std_single_ptrs[idx1]) {
-					volatile bool is_unique = std_single_ptrs[idx1].unique();
-					(void)is_unique;
+					do_not_optimize(std_single_ptrs[idx1].unique());
 				}
 				break;
 			case 16: {
-				int access_idx = dist_idx(gen);
-				if (std_array_ptrs[access_idx] && array_actual_sizes[access_idx] > 0) {
-					size_t elem_idx = std::uniform_int_distribution<size_t>(
-						0, array_actual_sizes[access_idx] - 1)(gen);
-					std_array_ptrs[access_idx][elem_idx].id = dist_val(gen);
-					volatile int read_val = std_array_ptrs[access_idx][elem_idx].id;
-					(void)read_val;
+				if (std_array_ptrs[idx2] && array_actual_sizes[idx2] > 0) {
+					size_t elem_idx					  = step.element % array_actual_sizes[idx2];
+					std_array_ptrs[idx2][elem_idx].id = step.value;
+					do_not_optimize(std_array_ptrs[idx2][elem_idx].id);
 				}
 			} break;
 			default:
@@ -296,17 +258,20 @@ long long run_combined_stress_impl_shared(bool use_raw, int iterations, int max_
 		}
 	}
 
-	auto end_time = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+	auto end_time = trial_end();
+	return elapsed_ns(start_time, end_time);
 }
 
 void performance_comparison_shared_test() {
 	std::cout << "\n--- Performance Comparison Test: raw::shared_ptr vs std::shared_ptr ---\n";
+	begin_report_suite("shared");
+	ScopedCpuPin pin(harness_config().pin_cpu);
 
-	const int NUM_TRIALS		= 20;
-	const int OPS_PER_TRIAL		= 1000000;
-	const int STRESS_ITERATIONS = 1000000;
+	const int NUM_TRIALS		= 100;
+	const int OPS_PER_TRIAL		= 100000;
+	const int STRESS_ITERATIONS = 10000;
 	const int POOL_SIZE			= 100;
+	const int STRESS_OP_KINDS	= 17;
 
 	print_table_header();
 
@@ -519,13 +484,17 @@ void performance_comparison_shared_test() {
 					s_active_test_objects);
 	verify_active_objects("Unique Check", initial_active_objects_before_test);
 
+	// Replayed step for step by both sides, see stress_trace()
+	const OpTrace& stress_ops =
+		stress_trace("shared_stress", STRESS_OP_KINDS, POOL_SIZE, STRESS_ITERATIONS);
+
 	TestResults combined_stress_results = run_benchmark_scenario(
-		"Combined Stress Test (Shared)", NUM_TRIALS, STRESS_ITERATIONS,
-		[&](int ops) {
-			return run_combined_stress_impl_shared(false, ops, POOL_SIZE);
+		"Combined Stress Test (Shared)", NUM_TRIALS, static_cast<int>(stress_ops.ops.size()),
+		[&](int) {
+			return run_combined_stress_impl_shared(false, stress_ops);
 		},
-		[&](int ops) {
-			return run_combined_stress_impl_shared(true, ops, POOL_SIZE);
+		[&](int) {
+			return run_combined_stress_impl_shared(true, stress_ops);
 		});
 	print_table_row("Combined Stress Test (Shared)", combined_stress_results,
 					initial_active_objects_before_test, s_active_test_objects);
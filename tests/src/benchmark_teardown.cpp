@@ -0,0 +1,56 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_teardown.h"
+
+#include <iostream>
+
+void performance_comparison_teardown_test() {
+	std::cout << "\n--- Performance Comparison Test: dropping long chains and trees ---\n";
+#ifdef RAW_ITERATIVE_TEARDOWN
+	std::cout << "raw:: side tears down iteratively (RAW_ITERATIVE_TEARDOWN)\n";
+#else
+	std::cout << "raw:: side tears down recursively, configure with RAW_ITERATIVE_TEARDOWN=ON to "
+				 "compare the worklist\n";
+#endif
+	begin_report_suite("teardown");
+
+	const int NUM_TRIALS = 20;
+	// Short enough for the recursive std:: teardown to stay well inside a default 8 MB stack
+	const int CHAIN_NODES = 20000;
+	const int TREE_NODES  = (1 << 16) - 1;
+
+	int initial_active_objects_before_test = s_active_test_objects;
+
+	ScopedCpuPin pin(harness_config().pin_cpu);
+	print_table_header();
+
+	TestResults shared_results = run_benchmark_scenario(
+		"shared_ptr Chain Drop", NUM_TRIALS, CHAIN_NODES,
+		[&](int nodes) { return run_chain_drop_test<StdPointerFamily, SharedChainNode>(nodes); },
+		[&](int nodes) { return run_chain_drop_test<RawPointerFamily, SharedChainNode>(nodes); });
+	print_table_row("shared_ptr Chain Drop", shared_results, initial_active_objects_before_test,
+					s_active_test_objects);
+	verify_active_objects("shared_ptr Chain Drop", initial_active_objects_before_test);
+
+	TestResults unique_results = run_benchmark_scenario(
+		"unique_ptr Chain Drop", NUM_TRIALS, CHAIN_NODES,
+		[&](int nodes) { return run_chain_drop_test<StdPointerFamily, UniqueChainNode>(nodes); },
+		[&](int nodes) { return run_chain_drop_test<RawPointerFamily, UniqueChainNode>(nodes); });
+	print_table_row("unique_ptr Chain Drop", unique_results, initial_active_objects_before_test,
+					s_active_test_objects);
+	verify_active_objects("unique_ptr Chain Drop", initial_active_objects_before_test);
+
+	TestResults tree_results = run_benchmark_scenario(
+		"Binary Tree Drop", NUM_TRIALS, TREE_NODES,
+		[&](int nodes) { return run_tree_drop_test<StdPointerFamily>(nodes); },
+		[&](int nodes) { return run_tree_drop_test<RawPointerFamily>(nodes); });
+	print_table_row("Binary Tree Drop", tree_results, initial_active_objects_before_test,
+					s_active_test_objects);
+	verify_active_objects("Binary Tree Drop", initial_active_objects_before_test);
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
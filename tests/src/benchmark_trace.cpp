@@ -0,0 +1,206 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+#include "../../include/raw/op_recorder.h"
+#include "../include/benchmark_harness.h"
+
+namespace {
+constexpr char	   trace_magic[8] = {'R', 'A', 'W', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t trace_version  = 1;
+
+struct TraceFileHeader {
+	char	 magic[8];
+	uint32_t version;
+	uint32_t record_size;
+	uint32_t pool_size;
+	uint32_t op_kinds;
+	uint64_t op_count;
+};
+
+static_assert(sizeof(TraceFileHeader) == 32, "trace header layout changed");
+
+// FNV-1a, gives every scenario its own stream from the one configured seed
+uint64_t hash_name(const std::string& name) {
+	uint64_t hash = 14695981039346656037ull;
+	for (unsigned char c : name) {
+		hash = (hash ^ c) * 1099511628211ull;
+	}
+	return hash;
+}
+
+bool trace_is_valid(const OpTrace& trace) {
+	if (trace.pool_size == 0 || trace.op_kinds == 0) {
+		return false;
+	}
+	for (const TraceOp& step : trace.ops) {
+		if (step.op >= trace.op_kinds || step.idx1 >= trace.pool_size ||
+			step.idx2 >= trace.pool_size || step.array_size == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+} // namespace
+
+OpTrace generate_op_trace(uint32_t op_kinds, uint32_t pool_size, int length, uint64_t seed) {
+	std::mt19937_64							gen(seed);
+	std::uniform_int_distribution<uint32_t> dist_op(0, op_kinds - 1);
+	std::uniform_int_distribution<uint32_t> dist_idx(0, pool_size - 1);
+	std::uniform_int_distribution<uint32_t> dist_val(0, 9999);
+	std::uniform_int_distribution<uint32_t> dist_array_size(1, 10);
+	std::uniform_int_distribution<uint32_t> dist_chance(0, 99);
+	std::uniform_int_distribution<uint32_t> dist_element(0, 255);
+
+	OpTrace trace;
+	trace.pool_size = pool_size;
+	trace.op_kinds	= op_kinds;
+	trace.ops.resize(length);
+	for (TraceOp& step : trace.ops) {
+		step.op			= static_cast<uint8_t>(dist_op(gen));
+		step.array_size = static_cast<uint8_t>(dist_array_size(gen));
+		step.chance		= static_cast<uint8_t>(dist_chance(gen));
+		step.element	= static_cast<uint8_t>(dist_element(gen));
+		step.idx1		= dist_idx(gen);
+		step.idx2		= dist_idx(gen);
+		step.value		= dist_val(gen);
+	}
+	return trace;
+}
+
+bool save_op_trace(const OpTrace& trace, const std::string& path) {
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		return false;
+	}
+	TraceFileHeader header {};
+	std::memcpy(header.magic, trace_magic, sizeof(trace_magic));
+	header.version	   = trace_version;
+	header.record_size = sizeof(TraceOp);
+	header.pool_size   = trace.pool_size;
+	header.op_kinds	   = trace.op_kinds;
+	header.op_count	   = trace.ops.size();
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(trace.ops.data()),
+			  static_cast<std::streamsize>(trace.ops.size() * sizeof(TraceOp)));
+	return static_cast<bool>(out);
+}
+
+bool load_op_trace(const std::string& path, OpTrace& trace) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		return false;
+	}
+	TraceFileHeader header {};
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		std::memcmp(header.magic, trace_magic, sizeof(trace_magic)) != 0 ||
+		header.version != trace_version || header.record_size != sizeof(TraceOp) ||
+		header.op_count == 0) {
+		return false;
+	}
+	OpTrace loaded;
+	loaded.pool_size = header.pool_size;
+	loaded.op_kinds	 = header.op_kinds;
+	loaded.ops.resize(header.op_count);
+	if (!in.read(reinterpret_cast<char*>(loaded.ops.data()),
+				 static_cast<std::streamsize>(loaded.ops.size() * sizeof(TraceOp))) ||
+		!trace_is_valid(loaded)) {
+		return false;
+	}
+	trace = std::move(loaded);
+	return true;
+}
+
+bool load_recording(const std::string& path, OpTrace& trace) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		return false;
+	}
+	raw::recording_header header {};
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		std::memcmp(header.magic, raw::recording_magic, sizeof(raw::recording_magic)) != 0 ||
+		header.version != raw::recording_version ||
+		header.event_size != sizeof(raw::recorded_event)) {
+		return false;
+	}
+	std::vector<raw::recorded_event> events;
+	raw::recorded_event				 event {};
+	while (in.read(reinterpret_cast<char*>(&event), sizeof(event))) {
+		if (event.op >= raw::recorded_op::count) {
+			return false;
+		}
+		events.push_back(event);
+	}
+	if (events.empty()) {
+		return false;
+	}
+	// The rings are drained thread by thread, the replay wants one global order
+	std::stable_sort(events.begin(), events.end(), [](const auto& lhs, const auto& rhs) {
+		return lhs.timestamp_ns < rhs.timestamp_ns;
+	});
+
+	// Addresses are reused once an object is gone, a make always starts a new slot
+	std::unordered_map<uint64_t, uint32_t> slot_of;
+	OpTrace								   loaded;
+	loaded.op_kinds = static_cast<uint32_t>(raw::recorded_op::count);
+	loaded.ops.reserve(events.size());
+	for (const raw::recorded_event& recorded : events) {
+		auto it = slot_of.find(recorded.id);
+		if (it == slot_of.end() || recorded.op == raw::recorded_op::shared_make ||
+			recorded.op == raw::recorded_op::unique_make) {
+			it = slot_of.insert_or_assign(recorded.id, loaded.pool_size++).first;
+		}
+		TraceOp step {};
+		step.op			= static_cast<uint8_t>(recorded.op);
+		step.array_size = 1;
+		step.idx1		= it->second;
+		step.idx2		= it->second;
+		step.value		= recorded.thread_id;
+		loaded.ops.push_back(step);
+	}
+	trace = std::move(loaded);
+	return true;
+}
+
+const OpTrace& stress_trace(const std::string& name, uint32_t op_kinds, uint32_t pool_size,
+							int length) {
+	static std::map<std::string, OpTrace> traces;
+	auto								  it = traces.find(name);
+	if (it != traces.end()) {
+		return it->second;
+	}
+
+	const HarnessConfig& config = harness_config();
+	OpTrace				 trace;
+	std::string			 path;
+	if (!config.trace_dir.empty()) {
+		path = config.trace_dir + "/" + name + ".trace";
+	}
+	if (!path.empty() && load_op_trace(path, trace)) {
+		if (trace.op_kinds == op_kinds) {
+			std::cout << "Replaying " << trace.ops.size() << " operations from " << path << "\n";
+			return traces.emplace(name, std::move(trace)).first->second;
+		}
+		std::cerr << path << " has " << trace.op_kinds << " op kinds, " << name << " expects "
+				  << op_kinds << ", replaying a generated trace instead\n";
+	} else if (!path.empty() && std::ifstream(path)) {
+		std::cerr << path << " is not a valid trace, replaying a generated one instead\n";
+	}
+
+	trace = generate_op_trace(op_kinds, pool_size, length, config.trace_seed ^ hash_name(name));
+	// Never overwrites a file that is there, it may be a recording someone wants to keep
+	if (!path.empty() && !std::ifstream(path) && !save_op_trace(trace, path)) {
+		std::cerr << "Could not write trace " << path << "\n";
+	}
+	return traces.emplace(name, std::move(trace)).first->second;
+}
@@ -4,101 +4,8 @@
 
 #include "../include/benchmark_unique.h"
 
-void calculate_stats(const std::vector<long long>& durations, long long& min_val,
-					 long long& max_val, long long& avg_val) {
-	if (durations.empty()) {
-		min_val = max_val = avg_val = 0;
-		return;
-	}
-	min_val		  = durations[0];
-	max_val		  = durations[0];
-	long long sum = 0;
-	for (long long d : durations) {
-		if (d < min_val)
-			min_val = d;
-		if (d > max_val)
-			max_val = d;
-		sum += d;
-	}
-	avg_val = sum / durations.size();
-}
-
-void print_table_header() {
-	std::cout
-		<< "\n----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
-	std::cout << std::left << std::setw(30) << "Scenario";
-	std::cout << "| " << std::right << std::setw(28) << "STD (us)";
-	std::cout << " | " << std::right << std::setw(28) << "RAW (us)";
-	std::cout << " | " << std::right << std::setw(34) << "Comparison";
-	std::cout << " | " << std::right << std::setw(24) << "Active Objects Start/End";
-	std::cout << "\n";
-	std::cout << std::left << std::setw(30) << "";
-	std::cout << "| " << std::right << std::setw(7) << "Min" << std::setw(9) << "Max"
-			  << std::setw(12) << "Avg";
-	std::cout << " | " << std::right << std::setw(7) << "Min" << std::setw(9) << "Max"
-			  << std::setw(12) << "Avg";
-	std::cout << " | " << std::right << std::setw(34) << "RAW vs STD Avg (%)";
-	std::cout << " | " << std::right << std::setw(12) << "Pre-test" << std::setw(12) << "Post-test";
-	std::cout << "\n";
-	std::cout
-		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
-}
-
-void print_table_row(const std::string& scenario_name, const TestResults& results,
-					 int initial_active_objects, int final_active_objects) {
-	std::cout << std::fixed << std::setprecision(2);
-	std::cout << std::left << std::setw(30) << scenario_name;
-
-	std::cout << "| " << std::right << std::setw(7) << results.std_min_us << std::setw(9)
-			  << results.std_max_us << std::setw(12) << results.std_avg_us;
-
-	std::cout << " | " << std::right << std::setw(7) << results.raw_min_us << std::setw(9)
-			  << results.raw_max_us << std::setw(12) << results.raw_avg_us;
-
-	std::cout << " | " << std::right;
-	std::cout << std::showpos << std::setw(30) << results.raw_vs_std_avg_percent;
-	std::cout << std::noshowpos;
-
-	std::cout << " | " << std::right << std::setw(12) << initial_active_objects << std::setw(12)
-			  << final_active_objects << "\n";
-}
-
-TestResults run_benchmark_scenario(const std::string& scenario_name, int num_trials,
-								   int operations_per_trial, std::function<long long(int)> std_func,
-								   std::function<long long(int)> raw_func) {
-	std::vector<long long> std_durations_us;
-	std_durations_us.reserve(num_trials);
-	for (int i = 0; i < num_trials; ++i) {
-		std_durations_us.push_back(std_func(operations_per_trial));
-	}
-
-	std::vector<long long> raw_durations_us;
-	raw_durations_us.reserve(num_trials);
-	for (int i = 0; i < num_trials; ++i) {
-		raw_durations_us.push_back(raw_func(operations_per_trial));
-	}
-
-	TestResults results;
-	calculate_stats(std_durations_us, results.std_min_us, results.std_max_us, results.std_avg_us);
-	calculate_stats(raw_durations_us, results.raw_min_us, results.raw_max_us, results.raw_avg_us);
-
-	if (results.std_avg_us != 0) {
-		results.raw_vs_std_avg_percent =
-			((double)results.raw_avg_us - results.std_avg_us) / results.std_avg_us * 100.0;
-	} else {
-		results.raw_vs_std_avg_percent = 0.0;
-	}
-	(void)scenario_name;
-	return results;
-}
-
-long long run_combined_stress_impl(bool use_raw, int iterations, int max_pointers_in_pool) {
-	std::random_device				rd;
-	std::mt19937					gen(rd());
-	std::uniform_int_distribution<> dist_op(0, 13);
-	std::uniform_int_distribution<> dist_idx(0, max_pointers_in_pool - 1);
-	std::uniform_int_distribution<> dist_val(0, 9999);
-	std::uniform_int_distribution<> dist_array_size_gen(1, 10);
+long long run_combined_stress_impl(bool use_raw, const OpTrace& trace) {
+	const size_t max_pointers_in_pool = trace.pool_size;
 
 	std::vector<std::unique_ptr<TestObject>>   std_single_ptrs;
 	std::vector<std::unique_ptr<TestObject[]>> std_array_ptrs;
@@ -115,17 +22,17 @@ long long run_combined_stress_impl(bool use_raw, int iterations, int max_pointer
 		std_array_ptrs.resize(max_pointers_in_pool);
 	}
 
-	auto start_time = std::chrono::high_resolution_clock::now();
+	auto start_time = trial_begin();
 
-	for (int i = 0; i < iterations; ++i) {
-		int op	 = dist_op(gen);
-		int idx1 = dist_idx(gen);
-		int idx2 = dist_idx(gen);
+	for (const TraceOp& step : trace.ops) {
+		int		 op	  = step.op;
+		uint32_t idx1 = step.idx1;
+		uint32_t idx2 = step.idx2;
 
 		if (use_raw) {
 			switch (op) {
 			case 0:
-				raw_single_ptrs[idx1] = raw::make_unique<TestObject>(dist_val(gen));
+				raw_single_ptrs[idx1] = raw::make_unique<TestObject>(step.value);
 				break;
 			case 1:
 				raw_single_ptrs[idx1].reset();
@@ -154,16 +61,15 @@ long long run_combined_stress_impl(bool use_raw, int iterations, int max_pointer
 				raw_single_ptrs[idx1].swap(raw_single_ptrs[idx2]);
 				break;
 			case 7:
-				raw_single_ptrs[idx1].reset(new TestObject(dist_val(gen)));
+				raw_single_ptrs[idx1].reset(new TestObject(step.value));
 				break;
 			case 8:
 				if (raw_single_ptrs[idx1]) {
-					volatile int id = raw_single_ptrs[idx1]->id;
-					(void)id;
+					do_not_optimize(raw_single_ptrs[idx1]->id);
 				}
 				break;
 			case 9: {
-				size_t current_array_size = dist_array_size_gen(gen);
+				size_t current_array_size = step.array_size;
 				raw_array_ptrs[idx1]	  = raw::make_unique<TestObject[]>(current_array_size);
 				array_actual_sizes[idx1]  = current_array_size;
 			} break;
@@ -192,16 +98,14 @@ long long run_combined_stress_impl(bool use_raw, int iterations, int max_pointer
 			}
 
 			if (raw_array_ptrs[idx1] && array_actual_sizes[idx1] > 0) {
-				size_t elem_idx =
-					std::uniform_int_distribution<size_t>(0, array_actual_sizes[idx1] - 1)(gen);
-				raw_array_ptrs[idx1][elem_idx].id = dist_val(gen);
-				volatile int read_val			  = raw_array_ptrs[idx1][elem_idx].id;
-				(void)read_val;
+				size_t elem_idx					  = step.element % array_actual_sizes[idx1];
+				raw_array_ptrs[idx1][elem_idx].id = step.value;
+				do_not_optimize(raw_array_ptrs[idx1][elem_idx].id);
 			}
 		} else {
 			switch (op) {
 			case 0:
-				std_single_ptrs[idx1] = std::make_unique<TestObject>(dist_val(gen));
+				std_single_ptrs[idx1] = std::make_unique<TestObject>(step.value);
 				break;
 			case 1:
 				std_single_ptrs[idx1].reset();
@@ -230,16 +134,15 @@ long long run_combined_stress_impl(bool use_raw, int iterations, int max_pointer
 				std_single_ptrs[idx1].swap(std_single_ptrs[idx2]);
 				break;
 			case 7:
-				std_single_ptrs[idx1].reset(new TestObject(dist_val(gen)));
+				std_single_ptrs[idx1].reset(new TestObject(step.value));
 				break;
 			case 8:
 				if (std_single_ptrs[idx1]) {
-					volatile int id = std_single_ptrs[idx1]->id;
-					(void)id;
+					do_not_optimize(std_single_ptrs[idx1]->id);
 				}
 				break;
 			case 9: {
-				size_t current_array_size = dist_array_size_gen(gen);
+				size_t current_array_size = step.array_size;
 				std_array_ptrs[idx1]	  = std::make_unique<TestObject[]>(current_array_size);
 				array_actual_sizes[idx1]  = current_array_size;
 			} break;
@@ -268,24 +171,24 @@ long long run_combined_stress_impl(bool use_raw, int iterations, int max_pointer
 			}
 
 			if (std_array_ptrs[idx1] && array_actual_sizes[idx1] > 0) {
-				size_t elem_idx =
-					std::uniform_int_distribution<size_t>(0, array_actual_sizes[idx1] - 1)(gen);
-				std_array_ptrs[idx1][elem_idx].id = dist_val(gen);
-				volatile int read_val			  = std_array_ptrs[idx1][elem_idx].id;
-				(void)read_val;
+				size_t elem_idx					  = step.element % array_actual_sizes[idx1];
+				std_array_ptrs[idx1][elem_idx].id = step.value;
+				do_not_optimize(std_array_ptrs[idx1][elem_idx].id);
 			}
 		}
 	}
 
-	auto end_time = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+	auto end_time = trial_end();
+	return elapsed_ns(start_time, end_time);
 }
 
 void performance_comparison_unique_test() {
 	std::cout << "\n--- Performance Comparison Test: raw::unique_ptr vs std::unique_ptr ---\n";
+	begin_report_suite("unique");
+	ScopedCpuPin pin(harness_config().pin_cpu);
 
-	const int NUM_TRIALS	= 20;
-	const int OPS_PER_TRIAL = 1000000;
+	const int NUM_TRIALS	= 100;
+	const int OPS_PER_TRIAL = 100000;
 
 	print_table_header();
 
@@ -435,16 +338,21 @@ void performance_comparison_unique_test() {
 					initial_active_objects_before_test, s_active_test_objects);
 	verify_active_objects("Access Array Element", initial_active_objects_before_test);
 
-	const int STRESS_ITERATIONS = 100000;
+	const int STRESS_ITERATIONS = 10000;
 	const int POOL_SIZE			= 100;
+	const int STRESS_OP_KINDS	= 14;
+
+	// Replayed step for step by both sides, see stress_trace()
+	const OpTrace& stress_ops =
+		stress_trace("unique_stress", STRESS_OP_KINDS, POOL_SIZE, STRESS_ITERATIONS);
 
 	TestResults combined_stress_results = run_benchmark_scenario(
-		"Combined Stress Test", NUM_TRIALS, STRESS_ITERATIONS,
-		[&](int ops) {
-			return run_combined_stress_impl(false, ops, POOL_SIZE);
+		"Combined Stress Test", NUM_TRIALS, static_cast<int>(stress_ops.ops.size()),
+		[&](int) {
+			return run_combined_stress_impl(false, stress_ops);
 		},
-		[&](int ops) {
-			return run_combined_stress_impl(true, ops, POOL_SIZE);
+		[&](int) {
+			return run_combined_stress_impl(true, stress_ops);
 		});
 	print_table_row("Combined Stress Test", combined_stress_results,
 					initial_active_objects_before_test, s_active_test_objects);
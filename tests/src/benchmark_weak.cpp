@@ -6,14 +6,8 @@
 
 #include <iostream>
 
-long long run_combined_stress_impl_weak(bool use_raw, int iterations, int max_pointers_in_pool) {
-	std::random_device				rd;
-	std::mt19937					gen(rd());
-	std::uniform_int_distribution<> dist_op(0, 12);
-	std::uniform_int_distribution<> dist_idx(0, max_pointers_in_pool - 1);
-	std::uniform_int_distribution<> dist_val(0, 9999);
-	std::uniform_int_distribution<> dist_array_size_gen(1, 10);
-	std::uniform_int_distribution<> dist_reset_chance(0, 4);
+long long run_combined_stress_impl_weak(bool use_raw, const OpTrace& trace) {
+	const size_t max_pointers_in_pool = trace.pool_size;
 
 	std::vector<std::shared_ptr<TestObject>>   std_shared_single_ptrs;
 	std::vector<std::weak_ptr<TestObject>>	   std_weak_single_ptrs;
@@ -39,18 +33,19 @@ long long run_combined_stress_impl_weak(bool use_raw, int iterations, int max_po
 		std_weak_array_ptrs.resize(max_pointers_in_pool);
 	}
 
-	for (int i = 0; i < max_pointers_in_pool; ++i) {
+	// Same starting pool for every trial and both sides
+	for (size_t i = 0; i < max_pointers_in_pool; ++i) {
 		if (use_raw) {
-			raw_shared_single_ptrs[i] = raw::make_shared<TestObject>(dist_val(gen));
-			size_t current_array_size = dist_array_size_gen(gen);
+			raw_shared_single_ptrs[i] = raw::make_shared<TestObject>(static_cast<int>(i));
+			size_t current_array_size = i % 10 + 1;
 			raw_shared_array_ptrs[i]  = raw::make_shared<TestObject[]>(current_array_size);
 			array_actual_sizes[i]	  = current_array_size;
 
 			raw_weak_single_ptrs[i] = raw_shared_single_ptrs[i];
 			raw_weak_array_ptrs[i]	= raw_shared_array_ptrs[i];
 		} else {
-			std_shared_single_ptrs[i] = std::make_shared<TestObject>(dist_val(gen));
-			size_t current_array_size = dist_array_size_gen(gen);
+			std_shared_single_ptrs[i] = std::make_shared<TestObject>(static_cast<int>(i));
+			size_t current_array_size = i % 10 + 1;
 			std_shared_array_ptrs[i]  = std::make_shared<TestObject[]>(current_array_size);
 			array_actual_sizes[i]	  = current_array_size;
 
@@ -59,17 +54,17 @@ long long run_combined_stress_impl_weak(bool use_raw, int iterations, int max_po
 		}
 	}
 
-	auto start_time = std::chrono::high_resolution_clock::now();
+	auto start_time = trial_begin();
 
-	for (int i = 0; i < iterations; ++i) {
-		int op	 = dist_op(gen);
-		int idx1 = dist_idx(gen);
-		int idx2 = dist_idx(gen);
+	for (const TraceOp& step : trace.ops) {
+		int		 op	  = step.op;
+		uint32_t idx1 = step.idx1;
+		uint32_t idx2 = step.idx2;
 
 		if (use_raw) {
 			switch (op) {
 			case 0:
-				raw_shared_single_ptrs[idx1] = raw::make_shared<TestObject>(dist_val(gen));
+				raw_shared_single_ptrs[idx1] = raw::make_shared<TestObject>(step.value);
 				raw_weak_single_ptrs[idx1]	 = raw_shared_single_ptrs[idx1];
 				break;
 			case 1:
@@ -85,57 +80,50 @@ long long run_combined_stress_impl_weak(bool use_raw, int iterations, int max_po
 				raw_weak_single_ptrs[idx1].swap(raw_weak_single_ptrs[idx2]);
 				break;
 			case 5: {
-				volatile size_t count = raw_weak_single_ptrs[idx1].use_count();
-				(void)count;
+				do_not_optimize(raw_weak_single_ptrs[idx1].use_count());
 			} break;
 			case 6: {
-				volatile bool exp = raw_weak_single_ptrs[idx1].expired();
-				(void)exp;
+				do_not_optimize(raw_weak_single_ptrs[idx1].expired());
 			} break;
 			case 7: {
 				raw::shared_ptr<TestObject> locked_ptr = raw_weak_single_ptrs[idx1].lock();
 				if (locked_ptr) {
-					volatile int id = locked_ptr->id;
-					(void)id;
+					do_not_optimize(locked_ptr->id);
 				}
 			} break;
 			case 8: {
-				int							  array_idx	 = dist_idx(gen);
-				raw::shared_ptr<TestObject[]> locked_ptr = raw_weak_array_ptrs[array_idx].lock();
-				if (locked_ptr && array_actual_sizes[array_idx] > 0) {
-					volatile int id = locked_ptr[0].id;
-					(void)id;
+				raw::shared_ptr<TestObject[]> locked_ptr = raw_weak_array_ptrs[idx2].lock();
+				if (locked_ptr && array_actual_sizes[idx2] > 0) {
+					do_not_optimize(locked_ptr[0].id);
 				}
 			} break;
 			case 9:
-				if (raw_shared_single_ptrs[idx1] && dist_reset_chance(gen) < 2) {
+				if (raw_shared_single_ptrs[idx1] && step.chance < 40) {
 					raw_shared_single_ptrs[idx1].reset();
 				}
 				break;
 			case 10:
-				if (raw_shared_array_ptrs[idx1] && dist_reset_chance(gen) < 2) {
+				if (raw_shared_array_ptrs[idx1] && step.chance < 40) {
 					raw_shared_array_ptrs[idx1].reset();
 					array_actual_sizes[idx1] = 0;
 				}
 				break;
 			case 11: {
-				raw::shared_ptr<TestObject> temp_sp = raw::make_shared<TestObject>(dist_val(gen));
+				raw::shared_ptr<TestObject> temp_sp = raw::make_shared<TestObject>(step.value);
 				raw_weak_single_ptrs[idx1]			= temp_sp;
-				if (dist_reset_chance(gen) < 1) {
+				if (step.chance < 20) {
 					temp_sp.reset();
 				}
-				volatile bool exp_after_reset = raw_weak_single_ptrs[idx1].expired();
-				(void)exp_after_reset;
+				do_not_optimize(raw_weak_single_ptrs[idx1].expired());
 			} break;
 			case 12: {
 				raw_weak_single_ptrs[idx1] = raw_shared_single_ptrs[idx2];
-				if (dist_reset_chance(gen) < 2) {
+				if (step.chance < 40) {
 					raw_shared_single_ptrs[idx2].reset();
 				}
 				raw::shared_ptr<TestObject> locked_after_reset = raw_weak_single_ptrs[idx1].lock();
 				if (locked_after_reset) {
-					volatile int id = locked_after_reset->id;
-					(void)id;
+					do_not_optimize(locked_after_reset->id);
 				}
 			} break;
 			default:
@@ -144,7 +132,7 @@ long long run_combined_stress_impl_weak(bool use_raw, int iterations, int max_po
 		} else {
 			switch (op) {
 			case 0:
-				std_shared_single_ptrs[idx1] = std::make_shared<TestObject>(dist_val(gen));
+				std_shared_single_ptrs[idx1] = std::make_shared<TestObject>(step.value);
 				std_weak_single_ptrs[idx1]	 = std_shared_single_ptrs[idx1];
 				break;
 			case 1:
@@ -160,57 +148,50 @@ long long run_combined_stress_impl_weak(bool use_raw, int iterations, int max_po
 				std_weak_single_ptrs[idx1].swap(std_weak_single_ptrs[idx2]);
 				break;
 			case 5: {
-				volatile size_t count = std_weak_single_ptrs[idx1].use_count();
-				(void)count;
+				do_not_optimize(std_weak_single_ptrs[idx1].use_count());
 			} break;
 			case 6: {
-				volatile bool exp = std_weak_single_ptrs[idx1].expired();
-				(void)exp;
+				do_not_optimize(std_weak_single_ptrs[idx1].expired());
 			} break;
 			case 7: {
 				std::shared_ptr<TestObject> locked_ptr = std_weak_single_ptrs[idx1].lock();
 				if (locked_ptr) {
-					volatile int id = locked_ptr->id;
-					(void)id;
+					do_not_optimize(locked_ptr->id);
 				}
 			} break;
 			case 8: {
-				int							  array_idx	 = dist_idx(gen);
-				std::shared_ptr<TestObject[]> locked_ptr = std_weak_array_ptrs[array_idx].lock();
-				if (locked_ptr && array_actual_sizes[array_idx] > 0) {
-					volatile int id = locked_ptr[0].id;
-					(void)id;
+				std::shared_ptr<TestObject[]> locked_ptr = std_weak_array_ptrs[idx2].lock();
+				if (locked_ptr && array_actual_sizes[idx2] > 0) {
+					do_not_optimize(locked_ptr[0].id);
 				}
 			} break;
 			case 9:
-				if (std_shared_single_ptrs[idx1] && dist_reset_chance(gen) < 2) {
+				if (std_shared_single_ptrs[idx1] && step.chance < 40) {
 					std_shared_single_ptrs[idx1].reset();
 				}
 				break;
 			case 10:
-				if (std_shared_array_ptrs[idx1] && dist_reset_chance(gen) < 2) {
+				if (std_shared_array_ptrs[idx1] && step.chance < 40) {
 					std_shared_array_ptrs[idx1].reset();
 					array_actual_sizes[idx1] = 0;
 				}
 				break;
 			case 11: {
-				std::shared_ptr<TestObject> temp_sp = std::make_shared<TestObject>(dist_val(gen));
+				std::shared_ptr<TestObject> temp_sp = std::make_shared<TestObject>(step.value);
 				std_weak_single_ptrs[idx1]			= temp_sp;
-				if (dist_reset_chance(gen) < 1) {
+				if (step.chance < 20) {
 					temp_sp.reset();
 				}
-				volatile bool exp_after_reset = std_weak_single_ptrs[idx1].expired();
-				(void)exp_after_reset;
+				do_not_optimize(std_weak_single_ptrs[idx1].expired());
 			} break;
 			case 12: {
 				std_weak_single_ptrs[idx1] = std_shared_single_ptrs[idx2];
-				if (dist_reset_chance(gen) < 2) {
+				if (step.chance < 40) {
 					std_shared_single_ptrs[idx2].reset();
 				}
 				std::shared_ptr<TestObject> locked_after_reset = std_weak_single_ptrs[idx1].lock();
 				if (locked_after_reset) {
-					volatile int id = locked_after_reset->id;
-					(void)id;
+					do_not_optimize(locked_after_reset->id);
 				}
 			} break;
 			default:
@@ -219,17 +200,20 @@ long long run_combined_stress_impl_weak(bool use_raw, int iterations, int max_po
 		}
 	}
 
-	auto end_time = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+	auto end_time = trial_end();
+	return elapsed_ns(start_time, end_time);
 }
 
 void performance_comparison_weak_test() {
 	std::cout << "\n--- Performance Comparison Test: raw::weak_ptr vs std::weak_ptr ---\n";
+	begin_report_suite("weak");
+	ScopedCpuPin pin(harness_config().pin_cpu);
 
-	const int NUM_TRIALS		= 20;
-	const int OPS_PER_TRIAL		= 1000000;
-	const int STRESS_ITERATIONS = 1000000;
+	const int NUM_TRIALS		= 100;
+	const int OPS_PER_TRIAL		= 100000;
+	const int STRESS_ITERATIONS = 10000;
 	const int POOL_SIZE			= 100;
+	const int STRESS_OP_KINDS	= 13;
 
 	print_table_header();
 
@@ -462,13 +446,17 @@ void performance_comparison_weak_test() {
 					s_active_test_objects);
 	verify_active_objects("Weak Lock (Array)", initial_active_objects_before_test);
 
+	// Replayed step for step by both sides, see stress_trace()
+	const OpTrace& stress_ops =
+		stress_trace("weak_stress", STRESS_OP_KINDS, POOL_SIZE, STRESS_ITERATIONS);
+
 	TestResults combined_stress_results = run_benchmark_scenario(
-		"Combined Stress Test (Weak)", NUM_TRIALS, STRESS_ITERATIONS,
-		[&](int ops) {
-			return run_combined_stress_impl_weak(false, ops, POOL_SIZE);
+		"Combined Stress Test (Weak)", NUM_TRIALS, static_cast<int>(stress_ops.ops.size()),
+		[&](int) {
+			return run_combined_stress_impl_weak(false, stress_ops);
 		},
-		[&](int ops) {
-			return run_combined_stress_impl_weak(true, ops, POOL_SIZE);
+		[&](int) {
+			return run_combined_stress_impl_weak(true, stress_ops);
 		});
 	print_table_row("Combined Stress Test (Weak)", combined_stress_results,
 					initial_active_objects_before_test, s_active_test_objects);
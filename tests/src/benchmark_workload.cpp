@@ -0,0 +1,92 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/benchmark_workload.h"
+
+#include <iostream>
+
+void performance_comparison_workload_test() {
+	std::cout << "\n--- Performance Comparison Test: application-shaped workloads ---\n";
+	begin_report_suite("workload");
+
+	const int	 NUM_TRIALS		   = 20;
+	const int	 TREE_NODES		   = (1 << 16) - 1;
+	const int	 DAG_NODES		   = 1 << 16;
+	const int	 DAG_LAYERS		   = 64;
+	const int	 LRU_LOOKUPS	   = 200000;
+	const int	 LRU_CAPACITY	   = 4096;
+	const int	 OBSERVER_NOTIFIES = 200000;
+	const int	 OBSERVERS		   = 1000;
+	const int	 OBSERVER_CHURN	   = 10;
+	const int	 SWEEP_INTERVAL	   = 8;
+	const int	 PIPELINE_MESSAGES = 100000;
+	const size_t PIPELINE_QUEUE	   = 256;
+
+	int initial_active_objects_before_test = s_active_test_objects;
+	{
+		ScopedCpuPin pin(harness_config().pin_cpu);
+		print_table_header();
+
+		TestResults tree_results = run_benchmark_scenario(
+			"Binary Tree Build/Walk/Drop", NUM_TRIALS, TREE_NODES,
+			[&](int nodes) { return run_tree_workload_test<StdPointerFamily>(nodes); },
+			[&](int nodes) { return run_tree_workload_test<RawPointerFamily>(nodes); });
+		print_table_row("Binary Tree Build/Walk/Drop", tree_results,
+						initial_active_objects_before_test, s_active_test_objects);
+		verify_active_objects("Binary Tree Build/Walk/Drop", initial_active_objects_before_test);
+
+		TestResults dag_results = run_benchmark_scenario(
+			"DAG Build/Walk/Drop", NUM_TRIALS, DAG_NODES,
+			[&](int nodes) { return run_dag_workload_test<StdPointerFamily>(nodes, DAG_LAYERS); },
+			[&](int nodes) { return run_dag_workload_test<RawPointerFamily>(nodes, DAG_LAYERS); });
+		print_table_row("DAG Build/Walk/Drop", dag_results, initial_active_objects_before_test,
+						s_active_test_objects);
+		verify_active_objects("DAG Build/Walk/Drop", initial_active_objects_before_test);
+
+		TestResults lru_results = run_benchmark_scenario(
+			"LRU Cache Lookups", NUM_TRIALS, LRU_LOOKUPS,
+			[&](int lookups) {
+				return run_lru_workload_test<StdPointerFamily>(lookups, LRU_CAPACITY);
+			},
+			[&](int lookups) {
+				return run_lru_workload_test<RawPointerFamily>(lookups, LRU_CAPACITY);
+			});
+		print_table_row("LRU Cache Lookups", lru_results, initial_active_objects_before_test,
+						s_active_test_objects);
+		verify_active_objects("LRU Cache Lookups", initial_active_objects_before_test);
+
+		TestResults observer_results = run_benchmark_scenario(
+			"Observer Notify/Sweep", NUM_TRIALS, OBSERVER_NOTIFIES,
+			[&](int notifies) {
+				return run_observer_workload_test<StdPointerFamily>(notifies, OBSERVERS,
+																	OBSERVER_CHURN, SWEEP_INTERVAL);
+			},
+			[&](int notifies) {
+				return run_observer_workload_test<RawPointerFamily>(notifies, OBSERVERS,
+																	OBSERVER_CHURN, SWEEP_INTERVAL);
+			});
+		print_table_row("Observer Notify/Sweep", observer_results,
+						initial_active_objects_before_test, s_active_test_objects);
+		verify_active_objects("Observer Notify/Sweep", initial_active_objects_before_test);
+	}
+
+	// The pipeline runs on three threads of its own, pinning would put them on one CPU
+	int initial_active_concurrent_objects = s_active_concurrent_test_objects;
+
+	TestResults pipeline_results = run_benchmark_scenario(
+		"unique_ptr Pipeline x3", NUM_TRIALS, PIPELINE_MESSAGES,
+		[&](int messages) {
+			return run_pipeline_workload_test<StdPointerFamily>(messages, PIPELINE_QUEUE);
+		},
+		[&](int messages) {
+			return run_pipeline_workload_test<RawPointerFamily>(messages, PIPELINE_QUEUE);
+		});
+	print_table_row("unique_ptr Pipeline x3", pipeline_results, initial_active_concurrent_objects,
+					s_active_concurrent_test_objects);
+	verify_active_concurrent_objects("unique_ptr Pipeline x3", initial_active_concurrent_objects);
+
+	std::cout
+		<< "----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+	std::cout << "Performance comparison finished.\n";
+}
@@ -0,0 +1,9 @@
+#include "../include/run_benchmarks.h"
+
+int main(int argc, char* argv[]) {
+	if (!parse_report_args(argc, argv)) {
+		return 2;
+	}
+	run_all_benchmarks();
+	return finish_report() ? 0 : 1;
+}
@@ -4,7 +4,8 @@
 
 #include "../include/common_test_utils.h"
 
-int s_active_test_objects = 0;
+int				 s_active_test_objects			  = 0;
+std::atomic<int> s_active_concurrent_test_objects = 0;
 
 void verify_active_objects(const std::string& test_name, int expected_count) {
 	if (s_active_test_objects != expected_count) {
@@ -14,4 +15,14 @@ void verify_active_objects(const std::string& test_name, int expected_count) {
 		assert(s_active_test_objects == expected_count);
 		exit(1);
 	}
-}
\ No newline at end of file
+}
+
+void verify_active_concurrent_objects(const std::string& test_name, int expected_count) {
+	int active = s_active_concurrent_test_objects.load();
+	if (active != expected_count) {
+		std::cerr << "VERIFY FAILED: " << test_name << " - Active concurrent objects: " << active
+				  << " (Expected: " << expected_count << ")\n";
+		assert(active == expected_count);
+		exit(1);
+	}
+}
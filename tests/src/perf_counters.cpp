@@ -0,0 +1,136 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/perf_counters.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#define RAW_HAS_PERF_EVENT 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+std::string& last_open_error() {
+	static std::string error;
+	return error;
+}
+
+#ifdef RAW_HAS_PERF_EVENT
+// PERF_TYPE_HW_CACHE config: cache, operation and result id packed one byte each
+constexpr uint64_t l1d_read_misses = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+									 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+int open_event(uint32_t type, uint64_t config) {
+	perf_event_attr attr {};
+	attr.size			= sizeof(attr);
+	attr.type			= type;
+	attr.config			= config;
+	attr.disabled		= 1;
+	attr.inherit		= 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv		= 1;
+	attr.read_format	= PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+	if (fd < 0) {
+		last_open_error() = std::strerror(errno);
+	}
+	return fd;
+}
+
+// Count scaled up for the time the event was multiplexed out, negative if it never ran
+double read_scaled(int fd) {
+	uint64_t values[3] = {};
+	if (fd < 0 || read(fd, values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+		return -1.0;
+	}
+	return static_cast<double>(values[0]) * static_cast<double>(values[1]) /
+		   static_cast<double>(values[2]);
+}
+#endif
+} // namespace
+
+PerfCounters::PerfCounters(uint64_t raw_config) {
+	for (int& fd : fds) {
+		fd = -1;
+	}
+#ifdef RAW_HAS_PERF_EVENT
+	fds[cycles]		   = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	fds[instructions]  = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	fds[l1d_misses]	   = open_event(PERF_TYPE_HW_CACHE, l1d_read_misses);
+	fds[llc_misses]	   = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	fds[branch_misses] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+	if (raw_config != 0) {
+		fds[raw_event] = open_event(PERF_TYPE_RAW, raw_config);
+	}
+#else
+	(void)raw_config;
+	last_open_error() = "perf_event_open is only available on Linux";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef RAW_HAS_PERF_EVENT
+	for (int fd : fds) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+#endif
+}
+
+void PerfCounters::enable() {
+#ifdef RAW_HAS_PERF_EVENT
+	for (int fd : fds) {
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+void PerfCounters::disable() {
+#ifdef RAW_HAS_PERF_EVENT
+	for (int fd : fds) {
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+#endif
+}
+
+bool PerfCounters::any_available() const {
+	for (int fd : fds) {
+		if (fd >= 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+PerfCounterStats PerfCounters::per_op(double operations) const {
+	PerfCounterStats stats;
+#ifdef RAW_HAS_PERF_EVENT
+	double* fields[event_count] = {&stats.cycles,	  &stats.instructions,	&stats.l1d_misses,
+								   &stats.llc_misses, &stats.branch_misses, &stats.raw_event};
+	for (int i = 0; i < event_count; ++i) {
+		double total = read_scaled(fds[i]);
+		if (total >= 0.0 && operations > 0.0) {
+			*fields[i] = total / operations;
+		}
+	}
+#else
+	(void)operations;
+#endif
+	return stats;
+}
+
+std::string PerfCounters::last_error() {
+	return last_open_error();
+}
@@ -0,0 +1,166 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_atomic.h"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+
+#ifdef RAW_MULTI_THREADED
+
+void test_atomic_shared_load_store() {
+	std::cout << "\n--- Test: Atomic Shared Load/Store ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::atomic_shared_ptr<TestObject> empty;
+		assert(!empty.load() && empty.is_lock_free());
+
+		raw::atomic_shared_ptr<TestObject> slot(raw::make_shared<TestObject>(1));
+		raw::shared_ptr<TestObject>		   first = slot.load();
+		assert(first && first->id == 1 && first.use_count() == 2);
+		verify_active_objects("slot constructed", initial_active_objects + 1);
+
+		slot.store(raw::make_shared<TestObject>(2));
+		assert(first.use_count() == 1 && slot.load()->id == 2);
+		verify_active_objects("slot stored #2", initial_active_objects + 2);
+
+		first.reset();
+		verify_active_objects("old snapshot released", initial_active_objects + 1);
+
+		slot.store(raw::shared_ptr<TestObject>());
+		assert(!slot.load());
+		verify_active_objects("slot cleared", initial_active_objects);
+
+		slot = raw::shared_ptr<TestObject>(new TestObject(3));
+		raw::shared_ptr<TestObject> converted = slot;
+		assert(converted->id == 3 && converted.use_count() == 2);
+	}
+	verify_active_objects("atomic_shared_ptr destruction", initial_active_objects);
+}
+
+void test_atomic_shared_exchange() {
+	std::cout << "\n--- Test: Atomic Shared Exchange ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::atomic_shared_ptr<TestObject> slot(raw::make_shared<TestObject>(10));
+
+		raw::shared_ptr<TestObject> old = slot.exchange(raw::make_shared<TestObject>(11));
+		assert(old->id == 10 && old.use_count() == 1 && slot.load()->id == 11);
+
+		raw::shared_ptr<TestObject> expected = old;
+		bool swapped = slot.compare_exchange_strong(expected, raw::make_shared<TestObject>(12));
+		assert(!swapped && expected->id == 11);
+		verify_active_objects("failed compare_exchange", initial_active_objects + 2);
+
+		swapped = slot.compare_exchange_strong(expected, raw::make_shared<TestObject>(13));
+		assert(swapped && slot.load()->id == 13 && expected.use_count() == 1);
+		expected.reset();
+		old.reset();
+		verify_active_objects("successful compare_exchange", initial_active_objects + 1);
+	}
+	verify_active_objects("exchange cleanup", initial_active_objects);
+}
+
+void test_atomic_weak_operations() {
+	std::cout << "\n--- Test: Atomic Weak Operations ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::shared_ptr<TestObject>		 owner = raw::make_shared<TestObject>(20);
+		raw::atomic_weak_ptr<TestObject> slot(owner);
+		assert(slot.load().lock().get() == owner.get());
+		assert(owner.use_count() == 1);
+
+		raw::shared_ptr<TestObject> other = raw::make_shared<TestObject>(21);
+		raw::weak_ptr<TestObject>	old	  = slot.exchange(other);
+		assert(old.lock().get() == owner.get() && slot.load().lock()->id == 21);
+
+		raw::weak_ptr<TestObject> expected = old;
+		assert(!slot.compare_exchange_strong(expected, owner));
+		assert(expected.lock().get() == other.get());
+		assert(slot.compare_exchange_strong(expected, owner));
+
+		owner.reset();
+		assert(slot.load().expired() && !slot.load().lock());
+		verify_active_objects("observed object released", initial_active_objects + 1);
+	}
+	verify_active_objects("atomic_weak_ptr destruction", initial_active_objects);
+}
+
+void stress_test_atomic_shared_ptr(int writes, int reader_threads) {
+	std::cout << "\n--- Stress Test: Atomic Shared Ptr (" << writes << " writes, "
+			  << reader_threads << " readers) ---\n";
+	int initial_active_objects = s_active_concurrent_test_objects;
+
+	using Snapshot = raw::shared_ptr<ConcurrentTestObject>;
+
+	{
+		raw::atomic_shared_ptr<ConcurrentTestObject> slot(
+			raw::make_shared<ConcurrentTestObject>(0));
+		raw::atomic_weak_ptr<ConcurrentTestObject> observer(slot.load());
+		std::atomic<bool>						   done {false};
+		std::atomic<long long>					   reads {0};
+
+		std::vector<std::thread> readers;
+		for (int t = 0; t < reader_threads; ++t) {
+			readers.emplace_back([&] {
+				int last_seen = 0;
+				while (!done.load(std::memory_order_acquire)) {
+					Snapshot snapshot = slot.load();
+					assert(snapshot && snapshot->id >= last_seen);
+					last_seen = snapshot->id;
+					if (Snapshot locked = observer.load().lock()) {
+						assert(locked->id >= 0);
+					}
+					reads.fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+		}
+
+		for (int i = 1; i <= writes; ++i) {
+			Snapshot next = raw::make_shared<ConcurrentTestObject>(i);
+			observer.store(next);
+			Snapshot expected = slot.load();
+			while (!slot.compare_exchange_weak(expected, next)) {
+			}
+		}
+		done.store(true, std::memory_order_release);
+		for (std::thread& reader : readers) {
+			reader.join();
+		}
+		assert(slot.load()->id == writes && reads.load() > 0);
+	}
+	verify_active_concurrent_objects("Stress test cleanup", initial_active_objects);
+}
+
+void run_all_atomic_tests() {
+	std::cout << "\nStarting atomic_shared_ptr tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_atomic_shared_load_store();
+	verify_active_objects("After test_atomic_shared_load_store", initial_active_objects);
+
+	test_atomic_shared_exchange();
+	verify_active_objects("After test_atomic_shared_exchange", initial_active_objects);
+
+	test_atomic_weak_operations();
+	verify_active_objects("After test_atomic_weak_operations", initial_active_objects);
+
+	stress_test_atomic_shared_ptr(100000, 4);
+	verify_active_objects("After stress_test_atomic_shared_ptr", initial_active_objects);
+
+	std::cout << "\nAll atomic_shared_ptr tests PASSED!.\n";
+	verify_active_objects("Final check after all atomic_shared_ptr unit tests", 0);
+}
+
+#else
+
+void run_all_atomic_tests() {
+	std::cout << "\natomic_shared_ptr tests skipped, they need RAW_MULTI_THREADED.\n";
+}
+
+#endif
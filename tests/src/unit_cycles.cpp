@@ -0,0 +1,312 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_cycles.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+
+#ifdef RAW_CYCLE_COLLECTOR
+
+namespace {
+// Destroyed while next still pointed at another object
+std::atomic<int> s_linked_destructions {0};
+
+template<typename Payload>
+struct CycleNode {
+	Payload					   payload;
+	raw::shared_ptr<CycleNode> next;
+	raw::shared_ptr<CycleNode> tail;
+	raw::shared_ptr<Payload>   untraced;
+
+	explicit CycleNode(int id) : payload(id) {}
+	~CycleNode() {
+		if (next) {
+			++s_linked_destructions;
+		}
+	}
+
+	void trace(raw::cycle_tracer& tracer) noexcept {
+		tracer(next);
+		tracer(tail);
+	}
+};
+
+using Node			 = CycleNode<TestObject>;
+using ConcurrentNode = CycleNode<ConcurrentTestObject>;
+
+// Links length nodes into a ring, every other one from operator new, and returns its first node
+template<typename N>
+raw::shared_ptr<N> make_ring(int length) {
+	raw::shared_ptr<N> first = raw::make_shared<N>(0);
+	raw::shared_ptr<N> last	 = first;
+	for (int i = 1; i < length; ++i) {
+		raw::shared_ptr<N> node = i % 2 ? raw::shared_ptr<N>(new N(i)) : raw::make_shared<N>(i);
+		last->next				= node;
+		last					= node;
+	}
+	last->next = first;
+	return first;
+}
+} // namespace
+
+void test_cycle_rings(int length) {
+	std::cout << "\n--- Test: Cycle Collection of Rings (" << length << " nodes) ---\n";
+	int initial_active_objects = s_active_test_objects;
+	raw::collect_cycles();
+	s_linked_destructions = 0;
+
+	// A ring with a chain and an untraced object hanging off it, and a node pointing at itself
+	raw::shared_ptr<Node> ring = make_ring<Node>(length);
+	ring->tail				   = raw::make_shared<Node>(-1);
+	ring->tail->tail		   = raw::make_shared<Node>(-2);
+	ring->tail->untraced	   = raw::make_shared<TestObject>(-3);
+	raw::shared_ptr<Node> self = raw::make_shared<Node>(-4);
+	self->next				   = self;
+	ring.reset();
+	self.reset();
+	verify_active_objects("garbage cycles before the pass", initial_active_objects + length + 4);
+
+	raw::cycle_report report = raw::collect_cycles();
+	assert(!report.aborted && report.pending == 0);
+	assert(report.collected == size_t(length) + 3);
+	assert(report.traced >= report.collected);
+	verify_active_objects("garbage cycles collected", initial_active_objects);
+	// The edges into the garbage were reset before any destructor ran
+	assert(s_linked_destructions == 0);
+
+	// Nothing was buffered again
+	report = raw::collect_cycles();
+	assert(report.roots == 0 && report.collected == 0);
+}
+
+void test_cycle_from_unique_ptr(int length) {
+	std::cout << "\n--- Test: Cycle Collection of Nodes Adopted from unique_ptr (" << length
+			  << " nodes) ---\n";
+	int initial_active_objects = s_active_test_objects;
+	raw::collect_cycles();
+
+	raw::unique_ptr<Node> unique(new Node(0));
+	raw::shared_ptr<Node> first(std::move(unique));
+	raw::shared_ptr<Node> last = first;
+	for (int i = 1; i < length; ++i) {
+		raw::shared_ptr<Node> node(raw::make_unique<Node>(i));
+		last->next = node;
+		last	   = node;
+	}
+	last->next = first;
+	last.reset();
+	first.reset();
+	verify_active_objects("adopted cycle before the pass", initial_active_objects + length);
+
+	raw::cycle_report report = raw::collect_cycles();
+	assert(!report.aborted && report.collected == size_t(length));
+	verify_active_objects("adopted cycle collected", initial_active_objects);
+
+	// An empty unique_ptr gives a hub without an object, which is never traced
+	raw::shared_ptr<Node> empty(raw::unique_ptr<Node>(nullptr));
+	empty.reset();
+	report = raw::collect_cycles();
+	assert(report.collected == 0);
+}
+
+void test_cycle_live_owner() {
+	std::cout << "\n--- Test: Cycle Collection Keeps Cycles Owned from Outside ---\n";
+	int initial_active_objects = s_active_test_objects;
+	raw::collect_cycles();
+
+	raw::shared_ptr<Node> ring	 = make_ring<Node>(10);
+	raw::shared_ptr<Node> owner	 = ring->next->next;
+	raw::shared_ptr<Node> holder = raw::make_shared<Node>(-1);
+	holder->tail				 = make_ring<Node>(10);
+	ring.reset();
+
+	raw::cycle_report report = raw::collect_cycles();
+	assert(report.roots > 0 && report.collected == 0);
+	verify_active_objects("owned cycles kept", initial_active_objects + 21);
+	assert(owner->next->next->next->next->next->next->next->next->next->next == owner);
+
+	// The decrements that cut them loose buffer them again
+	owner.reset();
+	holder.reset();
+	report = raw::collect_cycles();
+	assert(report.collected == 20);
+	verify_active_objects("released cycles collected", initial_active_objects);
+}
+
+void test_cycle_weak_observed() {
+	std::cout << "\n--- Test: Cycle Collection of Cycles Observed by weak_ptr ---\n";
+	int initial_active_objects = s_active_test_objects;
+	raw::collect_cycles();
+
+	raw::shared_ptr<Node> ring	   = make_ring<Node>(10);
+	raw::weak_ptr<Node>	  observer = ring->next;
+	ring.reset();
+
+	raw::cycle_report report = raw::collect_cycles();
+	if (raw::hub::thread_policy::is_thread_safe) {
+		// A lock() could race the pass, so the cycle waits until nothing observes it
+		assert(report.collected == 0 && !observer.expired());
+		verify_active_objects("observed cycle kept", initial_active_objects + 10);
+		observer.reset();
+		report = raw::collect_cycles();
+	} else {
+		assert(observer.expired());
+	}
+	assert(report.collected == 10);
+	verify_active_objects("observed cycle collected", initial_active_objects);
+}
+
+void test_cycle_object_budget(int length) {
+	std::cout << "\n--- Test: Cycle Collection Gives Up Past max_objects ---\n";
+	int initial_active_objects = s_active_test_objects;
+	raw::collect_cycles();
+
+	make_ring<Node>(length).reset();
+	raw::cycle_report report = raw::collect_cycles({.max_objects = size_t(length) / 2});
+	assert(report.aborted && report.collected == 0);
+	verify_active_objects("aborted pass kept everything", initial_active_objects + length);
+
+	// The roots were buffered again for a pass with a larger budget
+	report = raw::collect_cycles({.max_objects = size_t(length)});
+	assert(!report.aborted && report.collected == size_t(length));
+	verify_active_objects("second pass collected the ring", initial_active_objects);
+
+	raw::cycle_totals totals = raw::cycle_collector::totals();
+	assert(totals.aborted_passes > 0 && totals.passes > totals.aborted_passes);
+	assert(totals.max_pause_ns <= totals.total_pause_ns);
+}
+
+void test_cycle_root_budget(int rings) {
+	std::cout << "\n--- Test: Cycle Collection Leaves Roots Past max_roots Pending ---\n";
+	int initial_active_objects = s_active_test_objects;
+	raw::collect_cycles();
+
+	for (int i = 0; i < rings; ++i) {
+		raw::shared_ptr<Node> self = raw::make_shared<Node>(i);
+		self->next				   = self;
+	}
+	raw::cycle_report report = raw::collect_cycles({.max_roots = 2});
+	assert(report.roots == 2 && report.collected == 2);
+	assert(report.pending == size_t(rings) - 2);
+	verify_active_objects("first two roots collected", initial_active_objects + rings - 2);
+
+	report = raw::collect_cycles();
+	assert(report.pending == 0 && report.collected == size_t(rings) - 2);
+	verify_active_objects("pending roots collected", initial_active_objects);
+}
+
+void test_cycle_root_budget_ring(int length, size_t max_roots) {
+	std::cout << "\n--- Test: Cycle Collection of a Ring with More Roots than max_roots ("
+			  << length << " nodes, " << max_roots << " roots per pass) ---\n";
+	int initial_active_objects = s_active_test_objects;
+	raw::collect_cycles();
+
+	// Dropping an extra owner of every node makes each of them a candidate root
+	{
+		std::vector<raw::shared_ptr<Node>> owners;
+		owners.push_back(make_ring<Node>(length));
+		for (int i = 1; i < length; ++i) {
+			owners.push_back(owners.back()->next);
+		}
+	}
+	verify_active_objects("ring before the pass", initial_active_objects + length);
+
+	// The candidates left buffered hold weak references, which must not keep the ring alive
+	raw::cycle_report report = raw::collect_cycles({.max_roots = max_roots});
+	assert(!report.aborted && report.roots == max_roots);
+	assert(report.collected == size_t(length) && report.pending > 0);
+	verify_active_objects("ring collected by one bounded pass", initial_active_objects);
+
+	// What is left pending is dead already
+	report = raw::collect_cycles();
+	assert(report.collected == 0 && report.pending == 0);
+}
+
+void test_cycle_background_thread(int rings_per_thread, int threads) {
+	std::cout << "\n--- Test: Cycle Collection on the Background Thread (" << threads
+			  << " threads, " << rings_per_thread << " rings each) ---\n";
+	std::mutex graph_mutex;
+	if (!raw::hub::thread_policy::is_thread_safe) {
+		assert(!raw::cycle_collector::start(graph_mutex));
+		std::cout << "Skipped, the collector thread needs RAW_MULTI_THREADED.\n";
+		return;
+	}
+	int initial_active_objects = s_active_concurrent_test_objects;
+
+	assert(raw::cycle_collector::start(graph_mutex, std::chrono::microseconds(200),
+									   {.max_roots = 256}));
+	assert(raw::cycle_collector::running() && !raw::cycle_collector::start(graph_mutex));
+
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([rings_per_thread, &graph_mutex] {
+			for (int i = 0; i < rings_per_thread; ++i) {
+				raw::shared_ptr<ConcurrentNode> ring;
+				{
+					std::lock_guard lock(graph_mutex);
+					ring = make_ring<ConcurrentNode>(i % 7 + 1);
+					// Live objects are examined as well, and must survive
+					assert(ring->payload.id == 0 && ring->next);
+				}
+				std::lock_guard lock(graph_mutex);
+				ring.reset();
+			}
+		});
+	}
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (s_active_concurrent_test_objects != initial_active_objects &&
+		   std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	raw::cycle_collector::stop();
+	assert(!raw::cycle_collector::running());
+	verify_active_concurrent_objects("collector thread", initial_active_objects);
+}
+
+void run_all_cycles_tests() {
+	std::cout << "\nStarting cycle collector tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_cycle_rings();
+	verify_active_objects("After test_cycle_rings", initial_active_objects);
+
+	test_cycle_from_unique_ptr();
+	verify_active_objects("After test_cycle_from_unique_ptr", initial_active_objects);
+
+	test_cycle_live_owner();
+	verify_active_objects("After test_cycle_live_owner", initial_active_objects);
+
+	test_cycle_weak_observed();
+	verify_active_objects("After test_cycle_weak_observed", initial_active_objects);
+
+	test_cycle_object_budget();
+	verify_active_objects("After test_cycle_object_budget", initial_active_objects);
+
+	test_cycle_root_budget();
+	verify_active_objects("After test_cycle_root_budget", initial_active_objects);
+
+	test_cycle_root_budget_ring();
+	verify_active_objects("After test_cycle_root_budget_ring", initial_active_objects);
+
+	test_cycle_background_thread();
+	verify_active_objects("After test_cycle_background_thread", initial_active_objects);
+
+	std::cout << "\nAll cycle collector tests PASSED!.\n";
+	verify_active_objects("Final check after all cycle collector unit tests", 0);
+}
+
+#else
+
+void run_all_cycles_tests() {
+	std::cout << "\ncycle collector tests skipped, they need RAW_CYCLE_COLLECTOR.\n";
+}
+
+#endif
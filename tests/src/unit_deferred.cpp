@@ -0,0 +1,186 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_deferred.h"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+
+#ifdef RAW_DEFERRED_RECLAIM
+
+namespace {
+struct DeferredNode {
+	TestObject					  payload;
+	raw::shared_ptr<DeferredNode> next;
+
+	explicit DeferredNode(int id) : payload(id) {}
+};
+} // namespace
+
+void test_deferred_drain() {
+	std::cout << "\n--- Test: Deferred Reclamation by drain_reclamation() ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	raw::shared_ptr<TestObject> deferred = raw::make_shared<TestObject>(1);
+	raw::shared_ptr<TestObject> inline_released(new TestObject(2));
+	deferred.defer_reclamation();
+	raw::weak_ptr<TestObject> observer = deferred;
+
+	// Releasing the last owner only queues the hub, the object is expired but still alive
+	raw::shared_ptr<TestObject> copy = deferred;
+	deferred.reset();
+	assert(!observer.expired());
+	copy.reset();
+	assert(observer.expired() && !observer.lock());
+	assert(!raw::deferred_deleter::idle());
+	verify_active_objects("deferred object queued", initial_active_objects + 2);
+
+	// Pointers that did not opt in release right away
+	inline_released.reset();
+	verify_active_objects("inline object released", initial_active_objects + 1);
+
+	assert(raw::drain_reclamation() == 1);
+	assert(raw::deferred_deleter::idle() && raw::drain_reclamation() == 0);
+	verify_active_objects("deferred object drained", initial_active_objects);
+}
+
+void test_deferred_nested() {
+	std::cout << "\n--- Test: Deferred Reclamation of Nested Deferred Owners ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::shared_ptr<DeferredNode> head = raw::make_shared<DeferredNode>(0);
+		raw::shared_ptr<DeferredNode> tail = raw::make_shared<DeferredNode>(1);
+		head->next						   = tail;
+		head.defer_reclamation();
+		tail.defer_reclamation();
+	}
+	verify_active_objects("nested deferred queued", initial_active_objects + 2);
+
+	// Destroying head drops the last owner of tail, which is queued and released by the same drain
+	assert(raw::drain_reclamation() == 2);
+	verify_active_objects("nested deferred drained", initial_active_objects);
+}
+
+void test_deferred_array_slices(size_t size, size_t slice) {
+	std::cout << "\n--- Test: Deferred Array Teardown in Slices (" << size << " elements, " << slice
+			  << " per step) ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	raw::shared_ptr<TestObject[]> array = raw::make_shared<TestObject[]>(size);
+	raw::shared_ptr<TestObject>	  after = raw::make_shared<TestObject>(1);
+	array.defer_reclamation();
+	after.defer_reclamation();
+	raw::weak_ptr<TestObject[]> observer = array;
+	array.reset();
+	after.reset();
+	assert(observer.expired());
+	verify_active_objects("array queued", initial_active_objects + static_cast<int>(size) + 1);
+
+	// Each step resumes the array where the last one stopped, the next hub waits for it
+	size_t destroyed = 0;
+	while (destroyed + slice < size) {
+		assert(raw::reclaim_step(slice) == slice);
+		destroyed += slice;
+		verify_active_objects("array slice",
+							  initial_active_objects + static_cast<int>(size - destroyed) + 1);
+		assert(!raw::deferred_deleter::idle());
+	}
+	// The last slice frees the block, the rest of the budget goes to the next hub
+	assert(raw::reclaim_step(slice) == size - destroyed + 1);
+	assert(raw::deferred_deleter::idle() && raw::reclaim_step(slice) == 0);
+	verify_active_objects("array reclaimed", initial_active_objects);
+
+	// A time budget steps through the queue a slice at a time
+	{
+		raw::shared_ptr<TestObject[]> timed = raw::make_shared<TestObject[]>(size);
+		timed.defer_reclamation();
+	}
+	assert(raw::reclaim_step(std::chrono::seconds(10), slice) == size);
+	verify_active_objects("array reclaimed on a time budget", initial_active_objects);
+
+	// drain finishes an array that a step has only started
+	{
+		raw::shared_ptr<TestObject[]> partial = raw::make_shared<TestObject[]>(size);
+		partial.defer_reclamation();
+	}
+	assert(raw::reclaim_step(slice) == slice);
+	assert(raw::drain_reclamation() == 1);
+	verify_active_objects("partly reclaimed array drained", initial_active_objects);
+}
+
+void test_deferred_reclaimer_thread(int objects_per_thread, int threads) {
+	std::cout << "\n--- Test: Deferred Reclamation on the Reclaimer Thread (" << threads
+			  << " threads, " << objects_per_thread << " objects each) ---\n";
+	if (!raw::hub::thread_policy::is_thread_safe) {
+		assert(!raw::deferred_deleter::start());
+		std::cout << "Skipped, the reclaimer thread needs RAW_MULTI_THREADED.\n";
+		return;
+	}
+	int initial_active_objects = s_active_concurrent_test_objects;
+
+	assert(raw::deferred_deleter::start(std::chrono::microseconds(100)));
+	assert(raw::deferred_deleter::running() && !raw::deferred_deleter::start());
+
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([objects_per_thread] {
+			for (int i = 0; i < objects_per_thread; ++i) {
+				raw::shared_ptr<ConcurrentTestObject> object =
+					raw::make_shared<ConcurrentTestObject>(i);
+				object.defer_reclamation();
+				// Arrays larger than a slice make the reclaimer come back to them
+				if (i % 1000 == 0) {
+					raw::shared_ptr<ConcurrentTestObject[]> array =
+						raw::make_shared<ConcurrentTestObject[]>(3000);
+					array.defer_reclamation();
+				}
+			}
+		});
+	}
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	// The reclaimer gets to everything without being asked
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (s_active_concurrent_test_objects != initial_active_objects &&
+		   std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	raw::deferred_deleter::stop();
+	assert(!raw::deferred_deleter::running() && raw::deferred_deleter::idle());
+	verify_active_concurrent_objects("reclaimer thread", initial_active_objects);
+}
+
+void run_all_deferred_tests() {
+	std::cout << "\nStarting deferred reclamation tests...\n";
+	int initial_active_objects = s_active_test_objects;
+	// The tests check what is still queued, a reclaimer from RAW_RECLAIMER_INTERVAL_US would race
+	raw::deferred_deleter::stop();
+
+	test_deferred_drain();
+	verify_active_objects("After test_deferred_drain", initial_active_objects);
+
+	test_deferred_nested();
+	verify_active_objects("After test_deferred_nested", initial_active_objects);
+
+	test_deferred_array_slices();
+	verify_active_objects("After test_deferred_array_slices", initial_active_objects);
+
+	test_deferred_reclaimer_thread();
+	verify_active_objects("After test_deferred_reclaimer_thread", initial_active_objects);
+
+	std::cout << "\nAll deferred reclamation tests PASSED!.\n";
+	verify_active_objects("Final check after all deferred reclamation unit tests", 0);
+}
+
+#else
+
+void run_all_deferred_tests() {
+	std::cout << "\ndeferred reclamation tests skipped, they need RAW_DEFERRED_RECLAIM.\n";
+}
+
+#endif
@@ -0,0 +1,231 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_diagnostics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <source_location>
+
+#ifdef RAW_LEAK_TRACKER
+
+namespace {
+struct CycleNode {
+	TestObject				   payload;
+	raw::shared_ptr<CycleNode> next;
+};
+
+// Pointers other tests left to deferred reclamation may still be listed, only look at ours
+const raw::diagnostics::site_report* find_site(const raw::diagnostics::live_report& report,
+											   uint_least32_t line, const char* type) {
+	for (const raw::diagnostics::site_report& site : report.top_sites) {
+		if (site.site.line() == line && site.type_name.find(type) != std::string::npos) {
+			return &site;
+		}
+	}
+	return nullptr;
+}
+
+size_t sampled_at(uint_least32_t line, const char* type) {
+	const raw::diagnostics::live_report	 report	= raw::diagnostics::collect_live(SIZE_MAX);
+	const raw::diagnostics::site_report* site	= find_site(report, line, type);
+	return site ? site->sampled : 0;
+}
+} // namespace
+
+void test_live_registry_finds_cycle() {
+	std::cout << "\n--- Test: Live Registry Finds a Reference Cycle ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	raw::diagnostics::live_registry::set_sample_every(1);
+	raw::weak_ptr<CycleNode> observer;
+	uint_least32_t			 cycle_line = 0;
+	uint_least32_t			 make_line	= 0;
+	{
+		raw::shared_ptr<CycleNode> first(new CycleNode());
+		cycle_line = __LINE__ - 1;
+
+		first->next		  = raw::make_shared_at<CycleNode>(std::source_location::current());
+		make_line		  = __LINE__ - 1;
+		first->next->next = first;
+		observer		  = first;
+
+		raw::diagnostics::live_report		 report	= raw::diagnostics::collect_live(SIZE_MAX);
+		const raw::diagnostics::site_report* site	= find_site(report, cycle_line, "CycleNode");
+		assert(site && site->sampled == 1 && site->estimated_count == 1);
+		assert(site->estimated_bytes == sizeof(CycleNode) + sizeof(raw::hub));
+		assert(sampled_at(make_line, "CycleNode") == 1);
+
+		// make_shared cannot see its caller
+		raw::shared_ptr<CycleNode> unsited = raw::make_shared<CycleNode>();
+		assert(sampled_at(0, "CycleNode") == 1);
+	}
+
+	// Both nodes outlive their last owner, the registry still lists them
+	assert(!observer.expired());
+	raw::diagnostics::dump_live(stdout);
+	assert(sampled_at(cycle_line, "CycleNode") == 1 && sampled_at(make_line, "CycleNode") == 1);
+	assert(sampled_at(0, "CycleNode") == 0);
+
+	observer.lock()->next.reset();
+	assert(observer.expired());
+	assert(sampled_at(cycle_line, "CycleNode") == 0 && sampled_at(make_line, "CycleNode") == 0);
+	raw::diagnostics::live_registry::set_sample_every(0);
+	verify_active_objects("live registry cycle", initial_active_objects);
+}
+
+void test_live_registry_sampling(int hubs, uint32_t sample_every) {
+	std::cout << "\n--- Test: Live Registry Sampling (every " << sample_every << " of " << hubs
+			  << " hubs) ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	raw::diagnostics::live_registry::set_sample_every(sample_every);
+	uint_least32_t array_line = 0;
+	{
+		std::vector<raw::shared_ptr<TestObject[]>> arrays;
+		for (int i = 0; i < hubs; ++i) {
+			arrays.push_back(raw::make_shared<TestObject[]>(4));
+			array_line = __LINE__ - 1;
+		}
+		raw::diagnostics::live_report		 report	= raw::diagnostics::collect_live(SIZE_MAX);
+		const raw::diagnostics::site_report* site	= find_site(report, array_line, "TestObject");
+		size_t								 most	= (hubs + sample_every - 1) / sample_every;
+		// A countdown left over from earlier sampling can shift the first sample
+		assert(site && site->sampled <= most && site->sampled + 1 >= most);
+		assert(site->estimated_count == site->sampled * sample_every);
+	}
+	assert(sampled_at(array_line, "TestObject") == 0);
+
+	// With sampling off nothing is recorded
+	raw::diagnostics::live_registry::set_sample_every(0);
+	{
+		raw::shared_ptr<TestObject> untracked(new TestObject(1));
+		assert(sampled_at(__LINE__ - 1, "TestObject") == 0);
+	}
+	verify_active_objects("live registry sampling", initial_active_objects);
+}
+
+#ifdef RAW_PROFILE_CONTENTION
+void test_contention_profiler(int copies_per_thread, int threads) {
+	std::cout << "\n--- Test: Contention Profiler (" << threads << " threads, " << copies_per_thread
+			  << " copies each) ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	raw::diagnostics::live_registry::set_sample_every(1);
+	uint_least32_t shared_line = 0;
+	{
+		raw::shared_ptr<TestObject> shared(new TestObject(1));
+		shared_line = __LINE__ - 1;
+
+		raw::weak_ptr<TestObject> observer = shared;
+		std::vector<std::thread>  workers;
+		for (int t = 0; t < threads; ++t) {
+			workers.emplace_back([&shared, &observer, copies_per_thread] {
+				for (int i = 0; i < copies_per_thread; ++i) {
+					raw::shared_ptr<TestObject> copy   = shared;
+					raw::shared_ptr<TestObject> locked = observer.lock();
+					assert(copy && locked);
+				}
+			});
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+	raw::diagnostics::live_registry::set_sample_every(0);
+
+	// The hub is gone, its numbers are kept for its site
+	std::vector<raw::diagnostics::site_contention> report =
+		raw::diagnostics::live_registry::collect_contention(SIZE_MAX);
+	auto site = std::find_if(report.begin(), report.end(), [&](const auto& candidate) {
+		return candidate.site.line() == shared_line;
+	});
+	assert(site != report.end() && site->hubs == 1);
+	// Every copy and lock adds a reference and drops it, the owner's release comes last
+	uint64_t operations = 4 * static_cast<uint64_t>(threads) * copies_per_thread + 1;
+	assert(site->operations == operations);
+	assert(site->max_threads == static_cast<uint32_t>(threads) + 1);
+	assert(site->handoffs >= static_cast<uint64_t>(threads));
+	std::cout << "Handoffs: " << site->handoffs << ", CAS retries: " << site->cas_retries << "\n";
+	raw::diagnostics::dump_contention(stdout, 3);
+	verify_active_objects("contention profiler", initial_active_objects);
+}
+#endif
+
+void run_all_diagnostics_tests() {
+	std::cout << "\nStarting live registry tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_live_registry_finds_cycle();
+	verify_active_objects("After test_live_registry_finds_cycle", initial_active_objects);
+
+	test_live_registry_sampling();
+	verify_active_objects("After test_live_registry_sampling", initial_active_objects);
+
+#ifdef RAW_PROFILE_CONTENTION
+	test_contention_profiler();
+	verify_active_objects("After test_contention_profiler", initial_active_objects);
+#endif
+
+	std::cout << "\nAll live registry tests PASSED!.\n";
+	verify_active_objects("Final check after all live registry unit tests", 0);
+}
+
+#else
+
+#ifdef RAW_PROFILE_CONTENTION
+void test_contention_profiler(int copies_per_thread, int threads) {
+	std::cout << "\n--- Test: Contention Profiler (" << threads << " threads, " << copies_per_thread
+			  << " copies each) ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	raw::diagnostics::live_registry::set_sample_every(1);
+	uint_least32_t shared_line = 0;
+	{
+		raw::shared_ptr<TestObject> shared(new TestObject(1));
+		shared_line = __LINE__ - 1;
+
+		raw::weak_ptr<TestObject> observer = shared;
+		std::vector<std::thread>  workers;
+		for (int t = 0; t < threads; ++t) {
+			workers.emplace_back([&shared, &observer, copies_per_thread] {
+				for (int i = 0; i < copies_per_thread; ++i) {
+					raw::shared_ptr<TestObject> copy   = shared;
+					raw::shared_ptr<TestObject> locked = observer.lock();
+					assert(copy && locked);
+				}
+			});
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+	raw::diagnostics::live_registry::set_sample_every(0);
+
+	// The hub is gone, its numbers are kept for its site
+	std::vector<raw::diagnostics::site_contention> report =
+		raw::diagnostics::live_registry::collect_contention(SIZE_MAX);
+	auto site = std::find_if(report.begin(), report.end(), [&](const auto& candidate) {
+		return candidate.site.line() == shared_line;
+	});
+	assert(site != report.end() && site->hubs == 1);
+	// Every copy and lock adds a reference and drops it, the owner's release comes last
+	uint64_t operations = 4 * static_cast<uint64_t>(threads) * copies_per_thread + 1;
+	assert(site->operations == operations);
+	assert(site->max_threads == static_cast<uint32_t>(threads) + 1);
+	assert(site->handoffs >= static_cast<uint64_t>(threads));
+	std::cout << "Handoffs: " << site->handoffs << ", CAS retries: " << site->cas_retries << "\n";
+	raw::diagnostics::dump_contention(stdout, 3);
+	verify_active_objects("contention profiler", initial_active_objects);
+}
+#endif
+
+void run_all_diagnostics_tests() {
+	std::cout << "\nlive registry tests skipped, they need RAW_LEAK_TRACKER.\n";
+}
+
+#endif
@@ -0,0 +1,215 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_hazard.h"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+
+void test_hazard_protect() {
+	std::cout << "\n--- Test: Hazard Protect ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::weak_ptr<TestObject> empty;
+		assert(!empty.protect());
+
+		raw::shared_ptr<TestObject> owner = raw::make_shared<TestObject>(1);
+		raw::weak_ptr<TestObject>	weak  = owner;
+
+		raw::hazard_guard<TestObject> guard = weak.protect();
+		assert(guard && guard.get() == owner.get() && guard->id == 1 && (*guard).id == 1);
+		// Protecting does not take ownership
+		assert(owner.use_count() == 1);
+
+		guard.reset();
+		assert(!guard);
+
+		owner.reset();
+		assert(!weak.protect());
+		verify_active_objects("protect after expiry", initial_active_objects);
+
+		raw::shared_ptr<TestObject[]> array_owner = raw::make_shared<TestObject[]>(3);
+		raw::weak_ptr<TestObject[]>	  array_weak  = array_owner;
+		raw::hazard_guard<TestObject[]> array_guard = array_weak.protect();
+		array_guard[2].id							= 7;
+		assert(array_owner[2].id == 7);
+	}
+	verify_active_objects("protect cleanup", initial_active_objects);
+}
+
+void test_hazard_deferred_destruction() {
+	std::cout << "\n--- Test: Hazard Deferred Destruction ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::shared_ptr<TestObject>	  owner = raw::make_shared<TestObject>(2);
+		raw::weak_ptr<TestObject>	  weak	= owner;
+		raw::hazard_guard<TestObject> guard = weak.protect();
+
+		// The last owner leaves while the guard still reads the object
+		owner.reset();
+		assert(weak.expired() && !weak.lock() && !weak.protect());
+		assert(guard->id == 2 && raw::hazard_domain::retired_size() == 1);
+		verify_active_objects("object kept by guard", initial_active_objects + 1);
+
+		guard.reset();
+		assert(raw::hazard_domain::retired_size() == 0);
+		verify_active_objects("guard released", initial_active_objects);
+	}
+
+	{
+		// Two guards on the same object, the second one to leave frees it
+		raw::shared_ptr<TestObject>	  owner = raw::make_shared<TestObject>(3);
+		raw::weak_ptr<TestObject>	  weak	= owner;
+		raw::hazard_guard<TestObject> first = weak.protect();
+		raw::hazard_guard<TestObject> second = weak.protect();
+		owner.reset();
+
+		first.reset();
+		assert(second->id == 3);
+		verify_active_objects("one of two guards released", initial_active_objects + 1);
+		second.reset();
+		verify_active_objects("both guards released", initial_active_objects);
+	}
+
+	{
+		// The weak_ptr may go away first, the hub has to stay until the guard is done
+		raw::shared_ptr<TestObject>	  owner = raw::make_shared<TestObject>(4);
+		raw::hazard_guard<TestObject> guard;
+		{
+			raw::weak_ptr<TestObject> weak = owner;
+			guard						   = weak.protect();
+		}
+		owner.reset();
+		assert(guard->id == 4);
+	}
+	verify_active_objects("deferred destruction cleanup", initial_active_objects);
+}
+
+void test_hazard_guard_semantics() {
+	std::cout << "\n--- Test: Hazard Guard Semantics ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::shared_ptr<TestObject> owner = raw::make_shared<TestObject>(5);
+		raw::weak_ptr<TestObject>	weak  = owner;
+
+		raw::hazard_guard<TestObject> first = weak.protect();
+		raw::hazard_guard<TestObject> moved(std::move(first));
+		assert(!first && moved->id == 5);
+
+		raw::hazard_guard<TestObject> assigned;
+		assigned = std::move(moved);
+		assert(!moved && assigned->id == 5);
+
+		owner.reset();
+		verify_active_objects("moved guard keeps object", initial_active_objects + 1);
+	}
+	verify_active_objects("guard semantics cleanup", initial_active_objects);
+}
+
+void test_hazard_slot_exhaustion() {
+	std::cout << "\n--- Test: Hazard Slot Exhaustion ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::shared_ptr<TestObject> owner = raw::make_shared<TestObject>(6);
+		raw::weak_ptr<TestObject>	weak  = owner;
+
+		std::vector<raw::hazard_guard<TestObject>> guards;
+		for (size_t i = 0; i < raw::hazard_domain::slots_per_thread; ++i) {
+			guards.push_back(weak.protect());
+		}
+		assert(owner.use_count() == 1);
+
+		// Out of slots, the guard falls back to a strong reference
+		raw::hazard_guard<TestObject> fallback = weak.protect();
+		assert(fallback->id == 6 && owner.use_count() == 2);
+		fallback.reset();
+		assert(owner.use_count() == 1);
+
+		owner.reset();
+		verify_active_objects("all slots protecting", initial_active_objects + 1);
+		guards.clear();
+		verify_active_objects("all slots released", initial_active_objects);
+
+		// Slots are handed out again after release
+		owner						  = raw::make_shared<TestObject>(7);
+		weak						  = owner;
+		raw::hazard_guard<TestObject> reused = weak.protect();
+		assert(reused->id == 7 && owner.use_count() == 1);
+	}
+	verify_active_objects("slot exhaustion cleanup", initial_active_objects);
+}
+
+#ifdef RAW_MULTI_THREADED
+
+void stress_test_hazard_guard(int rounds, int reader_threads) {
+	std::cout << "\n--- Stress Test: Hazard Guard (" << rounds << " rounds, " << reader_threads
+			  << " readers) ---\n";
+	int initial_active_objects = s_active_concurrent_test_objects;
+
+	for (int round = 0; round < rounds; ++round) {
+		raw::shared_ptr<ConcurrentTestObject> owner =
+			raw::make_shared<ConcurrentTestObject>(round);
+		std::vector<raw::weak_ptr<ConcurrentTestObject>> observers(reader_threads, owner);
+		std::atomic<int>								 started {0};
+
+		std::vector<std::thread> readers;
+		for (int t = 0; t < reader_threads; ++t) {
+			readers.emplace_back([&, t] {
+				started.fetch_add(1, std::memory_order_relaxed);
+				// Keep reading until the owner is gone, the object must never be torn down early
+				while (raw::hazard_guard<ConcurrentTestObject> guard = observers[t].protect()) {
+					assert(guard->id == round);
+				}
+			});
+		}
+		while (started.load(std::memory_order_relaxed) < reader_threads) {
+			std::this_thread::yield();
+		}
+		owner.reset();
+		for (std::thread& reader : readers) {
+			reader.join();
+		}
+		// A guard released while the owner was retiring may leave the hub for the next sweep
+		raw::hazard_domain::reclaim();
+		verify_active_concurrent_objects("Stress round", initial_active_objects);
+	}
+	assert(raw::hazard_domain::retired_size() == 0);
+}
+
+#else
+
+void stress_test_hazard_guard(int rounds, int reader_threads) {
+	std::cout << "\n--- Stress Test: Hazard Guard skipped (" << rounds << " rounds, "
+			  << reader_threads << " readers need RAW_MULTI_THREADED) ---\n";
+}
+
+#endif
+
+void run_all_hazard_tests() {
+	std::cout << "\nStarting hazard_guard tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_hazard_protect();
+	verify_active_objects("After test_hazard_protect", initial_active_objects);
+
+	test_hazard_deferred_destruction();
+	verify_active_objects("After test_hazard_deferred_destruction", initial_active_objects);
+
+	test_hazard_guard_semantics();
+	verify_active_objects("After test_hazard_guard_semantics", initial_active_objects);
+
+	test_hazard_slot_exhaustion();
+	verify_active_objects("After test_hazard_slot_exhaustion", initial_active_objects);
+
+	stress_test_hazard_guard(500, 4);
+	verify_active_objects("After stress_test_hazard_guard", initial_active_objects);
+
+	std::cout << "\nAll hazard_guard tests PASSED!.\n";
+	verify_active_objects("Final check after all hazard_guard unit tests", 0);
+}
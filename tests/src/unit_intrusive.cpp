@@ -0,0 +1,214 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_intrusive.h"
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+template<typename T>
+void print_intrusive_ptr_state(const std::string& name, const raw::intrusive_ptr<T>& ptr) {
+	std::cout << name << ": ";
+	if (ptr) {
+		std::cout << "Address=" << (void*)ptr.get() << ", Value=" << ptr->id
+				  << ", UseCount=" << ptr.use_count() << ", bool=true\n";
+	} else {
+		std::cout << "Null pointer, UseCount=" << ptr.use_count() << ", bool=false\n";
+	}
+}
+
+void test_intrusive_construction() {
+	std::cout << "\n--- Test: Intrusive Construction ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	static_assert(sizeof(raw::intrusive_ptr<IntrusiveTestObject>) == sizeof(void*));
+
+	{
+		raw::intrusive_ptr<IntrusiveTestObject> iptr1;
+		print_intrusive_ptr_state("iptr1 (default)", iptr1);
+		assert(!iptr1 && iptr1.use_count() == 0);
+
+		raw::intrusive_ptr<IntrusiveTestObject> iptr2(nullptr);
+		assert(!iptr2 && iptr2.use_count() == 0);
+		verify_active_objects("iptr1, iptr2 empty construction", initial_active_objects);
+	}
+
+	{
+		raw::intrusive_ptr<IntrusiveTestObject> iptr3 =
+			raw::make_intrusive<IntrusiveTestObject>(100);
+		print_intrusive_ptr_state("iptr3 (make_intrusive)", iptr3);
+		assert(iptr3 && iptr3->id == 100 && iptr3.use_count() == 1);
+		verify_active_objects("iptr3 make_intrusive", initial_active_objects + 1);
+
+		raw::intrusive_ptr<IntrusiveTestObject> iptr4(new IntrusiveTestObject(200));
+		print_intrusive_ptr_state("iptr4 (from raw ptr)", iptr4);
+		assert(iptr4 && iptr4->id == 200 && iptr4.use_count() == 1);
+		verify_active_objects("iptr4 from raw ptr", initial_active_objects + 2);
+	}
+	verify_active_objects("iptr3, iptr4 destruction", initial_active_objects);
+
+	{
+		// The count lives in the object, so two unrelated pointers share it
+		IntrusiveTestObject*					raw_ptr = new IntrusiveTestObject(300);
+		raw::intrusive_ptr<IntrusiveTestObject> first(raw_ptr);
+		raw::intrusive_ptr<IntrusiveTestObject> second(raw_ptr);
+		assert(first.use_count() == 2 && second.use_count() == 2);
+		verify_active_objects("two owners from one raw ptr", initial_active_objects + 1);
+	}
+	verify_active_objects("two owners destruction", initial_active_objects);
+}
+
+void test_intrusive_copy_move_semantics() {
+	std::cout << "\n--- Test: Intrusive Copy/Move Semantics ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	raw::intrusive_ptr<IntrusiveTestObject> original =
+		raw::make_intrusive<IntrusiveTestObject>(10);
+	raw::intrusive_ptr<IntrusiveTestObject> copy1 = original;
+	print_intrusive_ptr_state("copy1 (after copy-construct)", copy1);
+	assert(original.use_count() == 2 && copy1.get() == original.get());
+
+	raw::intrusive_ptr<IntrusiveTestObject> moved1 = std::move(copy1);
+	assert(!copy1 && moved1.use_count() == 2);
+
+	raw::intrusive_ptr<IntrusiveTestObject> target_copy_assign;
+	target_copy_assign = original;
+	assert(original.use_count() == 3 && target_copy_assign->id == 10);
+
+	target_copy_assign = target_copy_assign;
+	assert(target_copy_assign.use_count() == 3);
+
+	raw::intrusive_ptr<IntrusiveTestObject> target_move_assign =
+		raw::make_intrusive<IntrusiveTestObject>(20);
+	verify_active_objects("target_move_assign created", initial_active_objects + 2);
+	target_move_assign = std::move(moved1);
+	assert(!moved1 && target_move_assign->id == 10 && original.use_count() == 3);
+	verify_active_objects("target_move_assign move-assign (old #20 deleted)",
+						  initial_active_objects + 1);
+
+	target_move_assign = std::move(target_move_assign);
+	assert(target_move_assign && target_move_assign.use_count() == 3);
+
+	target_copy_assign = nullptr;
+	target_move_assign = nullptr;
+	assert(original.use_count() == 1);
+	original = nullptr;
+	verify_active_objects("all owners released", initial_active_objects);
+}
+
+void test_intrusive_manipulation() {
+	std::cout << "\n--- Test: Intrusive Manipulation ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	raw::intrusive_ptr<IntrusiveTestObject> iptr = raw::make_intrusive<IntrusiveTestObject>(10);
+	assert((*iptr).id == 10 && iptr->id == 10);
+
+	iptr.reset(new IntrusiveTestObject(11));
+	print_intrusive_ptr_state("iptr after reset(new_ptr)", iptr);
+	assert(iptr->id == 11 && iptr.use_count() == 1);
+	verify_active_objects("iptr reset(new_ptr) (old #10 deleted)", initial_active_objects + 1);
+
+	IntrusiveTestObject* detached = iptr.detach();
+	assert(!iptr && detached->use_count() == 1);
+	raw::intrusive_ptr<IntrusiveTestObject> adopted(detached, false);
+	assert(adopted.use_count() == 1);
+	verify_active_objects("detach and adopt", initial_active_objects + 1);
+
+	raw::intrusive_ptr<IntrusiveTestObject> other = raw::make_intrusive<IntrusiveTestObject>(12);
+	adopted.swap(other);
+	assert(adopted->id == 12 && other->id == 11);
+
+	// Copying the object must not copy its owners
+	IntrusiveTestObject copy_of_object(*other);
+	assert(copy_of_object.use_count() == 0 && other.use_count() == 1);
+
+	adopted.reset();
+	other.reset();
+	verify_active_objects("manipulation cleanup", initial_active_objects + 1);
+}
+
+void test_intrusive_thread_policy() {
+	std::cout << "\n--- Test: Intrusive Thread Policy ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	static_assert(!raw::single_threaded_policy::is_thread_safe);
+	static_assert(raw::multi_threaded_policy::is_thread_safe);
+	static_assert(std::is_same_v<raw::hub::thread_policy, raw::default_thread_policy>);
+
+	{
+		raw::intrusive_ptr<LocalIntrusiveTestObject> local =
+			raw::make_intrusive<LocalIntrusiveTestObject>(1);
+		raw::intrusive_ptr<LocalIntrusiveTestObject> local_copy = local;
+		assert(local.use_count() == 2);
+		verify_active_objects("single threaded policy", initial_active_objects + 1);
+	}
+	verify_active_objects("single threaded policy destruction", initial_active_objects);
+}
+
+void stress_test_intrusive_ptr(int iterations, int max_pointers_in_pool) {
+	std::cout << "\n--- Stress Test: Intrusive Ptr (" << iterations << " iterations) ---\n";
+	std::random_device				rd;
+	std::mt19937					gen(rd());
+	std::uniform_int_distribution<> dist_op(0, 5);
+	std::uniform_int_distribution<> dist_idx(0, max_pointers_in_pool - 1);
+	std::uniform_int_distribution<> dist_val(0, 9999);
+
+	int initial_active_objects = s_active_test_objects;
+	{
+		std::vector<raw::intrusive_ptr<IntrusiveTestObject>> pool(max_pointers_in_pool);
+		for (int i = 0; i < iterations; ++i) {
+			int idx1 = dist_idx(gen);
+			int idx2 = dist_idx(gen);
+			switch (dist_op(gen)) {
+			case 0:
+				pool[idx1] = raw::make_intrusive<IntrusiveTestObject>(dist_val(gen));
+				break;
+			case 1:
+				pool[idx1].reset();
+				break;
+			case 2:
+				pool[idx1] = pool[idx2];
+				break;
+			case 3:
+				pool[idx1] = std::move(pool[idx2]);
+				break;
+			case 4:
+				pool[idx1].swap(pool[idx2]);
+				break;
+			case 5:
+				if (pool[idx1]) {
+					assert(pool[idx1].use_count() >= 1);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	verify_active_objects("Stress test cleanup", initial_active_objects);
+}
+
+void run_all_intrusive_tests() {
+	std::cout << "\nStarting intrusive_ptr tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_intrusive_construction();
+	verify_active_objects("After test_intrusive_construction", initial_active_objects);
+
+	test_intrusive_copy_move_semantics();
+	verify_active_objects("After test_intrusive_copy_move_semantics", initial_active_objects);
+
+	test_intrusive_manipulation();
+	verify_active_objects("After test_intrusive_manipulation", initial_active_objects);
+
+	test_intrusive_thread_policy();
+	verify_active_objects("After test_intrusive_thread_policy", initial_active_objects);
+
+	stress_test_intrusive_ptr(100000, 100);
+	verify_active_objects("After stress_test_intrusive_ptr", initial_active_objects);
+
+	std::cout << "\nAll intrusive_ptr tests PASSED!.\n";
+	verify_active_objects("Final check after all intrusive_ptr unit tests", 0);
+}
@@ -0,0 +1,175 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_parallel.h"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+std::atomic<size_t> s_constructions {0};
+std::atomic<int>	s_alive_elements {0};
+size_t				s_throw_at = 0;
+
+// Throws from the s_throw_at-th constructor call, whichever thread makes it
+struct ThrowingElement {
+	ThrowingElement() {
+		if (s_constructions.fetch_add(1, std::memory_order_relaxed) == s_throw_at) {
+			throw std::runtime_error("element constructor failed");
+		}
+		s_alive_elements.fetch_add(1, std::memory_order_relaxed);
+	}
+	~ThrowingElement() {
+		s_alive_elements.fetch_sub(1, std::memory_order_relaxed);
+	}
+};
+
+std::mutex				  s_destroying_mutex;
+std::set<std::thread::id> s_destroying_threads;
+// Bumped for every array, a thread records itself once per array
+std::atomic<int> s_destroy_round {0};
+thread_local int s_recorded_round = -1;
+
+// Records every thread that destroys one of the elements
+struct ThreadRecordingElement {
+	~ThreadRecordingElement() {
+		int round = s_destroy_round.load(std::memory_order_relaxed);
+		if (s_recorded_round != round) {
+			s_recorded_round = round;
+			std::lock_guard lock(s_destroying_mutex);
+			s_destroying_threads.insert(std::this_thread::get_id());
+		}
+	}
+};
+} // namespace
+
+void test_parallel_thread_count() {
+	std::cout << "\n--- Test: Parallel Thread Count ---\n";
+	constexpr size_t chunk = raw::parallel::min_chunk;
+
+	assert(raw::parallel(4).threads_for(0) == 1);
+	assert(raw::parallel(4).threads_for(chunk - 1) == 1);
+	assert(raw::parallel(4).threads_for(chunk * 2 + 1) == 2);
+	assert(raw::parallel(4).threads_for(chunk * 100) == 4);
+	assert(raw::parallel(1).threads_for(chunk * 100) == 1);
+	assert(raw::parallel().threads_for(chunk * 1000) >= 1);
+}
+
+void test_parallel_make_shared(size_t size) {
+	std::cout << "\n--- Test: Parallel make_shared<T[]> (" << size << " elements) ---\n";
+	int initial_active_objects = s_active_concurrent_test_objects;
+
+	{
+		raw::shared_ptr<ConcurrentTestObject[]> array =
+			raw::make_shared<ConcurrentTestObject[]>(raw::parallel(4), size);
+		verify_active_concurrent_objects("parallel array built",
+										 initial_active_objects + static_cast<int>(size));
+		for (size_t i = 0; i < size; ++i) {
+			assert(array[i].id == 0);
+		}
+
+		raw::shared_ptr<ConcurrentTestObject[]> copy = array;
+		array.reset();
+		verify_active_concurrent_objects("parallel array still owned",
+										 initial_active_objects + static_cast<int>(size));
+	}
+	verify_active_concurrent_objects("parallel array destroyed", initial_active_objects);
+
+	raw::shared_ptr<long[]> numbers = raw::make_shared<long[]>(raw::parallel(4), size);
+	for (size_t i = 0; i < size; ++i) {
+		assert(numbers[i] == 0);
+	}
+
+	// Too small to split, built on the calling thread
+	raw::shared_ptr<ConcurrentTestObject[]> small =
+		raw::make_shared<ConcurrentTestObject[]>(raw::parallel(4), 3);
+	assert(small.use_count() == 1);
+	small.reset();
+	verify_active_concurrent_objects("small parallel array", initial_active_objects);
+}
+
+void test_parallel_rollback(size_t size) {
+	std::cout << "\n--- Test: Parallel Construction Rollback (" << size << " elements) ---\n";
+
+	for (size_t throw_at : {size_t(0), size / 2, size - 1}) {
+		s_constructions = 0;
+		s_throw_at		= throw_at;
+		bool thrown		= false;
+		try {
+			raw::shared_ptr<ThrowingElement[]> array =
+				raw::make_shared<ThrowingElement[]>(raw::parallel(4), size);
+		} catch (const std::runtime_error&) {
+			thrown = true;
+		}
+		// Every element that was built is destroyed again before the exception arrives
+		assert(thrown && s_alive_elements == 0);
+	}
+
+	// The serial overload rolls back the same way
+	s_constructions = 0;
+	s_throw_at		= 2;
+	bool thrown		= false;
+	try {
+		raw::shared_ptr<ThrowingElement[]> array = raw::make_shared<ThrowingElement[]>(3);
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+	assert(thrown && s_alive_elements == 0);
+}
+
+void test_parallel_destroy_threads(size_t size) {
+	std::cout << "\n--- Test: Parallel Destruction Keeps the Hint (" << size << " elements) ---\n";
+
+	for (size_t threads : {size_t(1), size_t(2), size_t(3)}) {
+		raw::shared_ptr<ThreadRecordingElement[]> array =
+			raw::make_shared<ThreadRecordingElement[]>(raw::parallel(threads), size);
+		s_destroying_threads.clear();
+		++s_destroy_round;
+		array.reset();
+		// Starting a thread may fail, its chunk then runs on the caller
+		assert(!s_destroying_threads.empty() && s_destroying_threads.size() <= threads);
+	}
+}
+
+void test_parallel_make_unique(size_t size) {
+	std::cout << "\n--- Test: Parallel make_unique<T[]> (" << size << " elements) ---\n";
+	int initial_active_objects = s_active_concurrent_test_objects;
+
+	raw::unique_ptr<int[]> numbers = raw::make_unique<int[]>(raw::parallel(4), size);
+	for (size_t i = 0; i < size; ++i) {
+		assert(numbers[i] == 0);
+	}
+
+	// Other element types are built by new[], delete[] could not destroy them otherwise
+	{
+		raw::unique_ptr<ConcurrentTestObject[]> objects =
+			raw::make_unique<ConcurrentTestObject[]>(raw::parallel(4), 10);
+		verify_active_concurrent_objects("non-trivial make_unique", initial_active_objects + 10);
+	}
+	verify_active_concurrent_objects("non-trivial make_unique destroyed", initial_active_objects);
+}
+
+void run_all_parallel_tests() {
+	std::cout << "\nStarting parallel array tests...\n";
+	int initial_active_objects = s_active_concurrent_test_objects;
+
+	test_parallel_thread_count();
+
+	test_parallel_make_shared();
+	verify_active_concurrent_objects("After test_parallel_make_shared", initial_active_objects);
+
+	test_parallel_rollback();
+
+	test_parallel_destroy_threads();
+
+	test_parallel_make_unique();
+	verify_active_concurrent_objects("After test_parallel_make_unique", initial_active_objects);
+
+	std::cout << "\nAll parallel array tests PASSED!.\n";
+}
@@ -0,0 +1,156 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_rcu.h"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+
+void test_rcu_read_publish() {
+	std::cout << "\n--- Test: RCU Read/Publish ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::rcu_ptr<TestObject> empty;
+		assert(!empty.read());
+
+		raw::rcu_ptr<TestObject> table(raw::make_unique<TestObject>(1));
+		{
+			auto reader = table.read();
+			assert(reader && reader->id == 1 && (*reader).id == 1);
+		}
+		verify_active_objects("rcu_ptr constructed", initial_active_objects + 1);
+
+		// Nobody reads, so the old version goes away right in publish()
+		table.publish(raw::make_unique<TestObject>(2));
+		assert(table.read()->id == 2 && table.retired_size() == 0);
+		verify_active_objects("publish without readers", initial_active_objects + 1);
+
+		table.publish(raw::unique_ptr<TestObject>());
+		assert(!table.read());
+		verify_active_objects("publish empty", initial_active_objects);
+
+		table.publish(raw::make_unique<TestObject>(3));
+	}
+	verify_active_objects("rcu_ptr destruction", initial_active_objects);
+}
+
+void test_rcu_deferred_reclaim() {
+	std::cout << "\n--- Test: RCU Deferred Reclaim ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::rcu_ptr<TestObject> table(raw::make_unique<TestObject>(10));
+		{
+			auto reader = table.read();
+			table.publish(raw::make_unique<TestObject>(11));
+
+			// The reader started before the publish and still sees the old version
+			assert(reader->id == 10 && table.retired_size() == 1);
+			verify_active_objects("old version kept for reader", initial_active_objects + 2);
+
+			table.publish(raw::make_unique<TestObject>(12));
+			assert(table.retired_size() == 2 && reader->id == 10);
+		}
+		assert(table.read()->id == 12);
+
+		assert(table.reclaim() == 2 && table.retired_size() == 0);
+		verify_active_objects("reader left, versions reclaimed", initial_active_objects + 1);
+
+		{
+			auto reader = table.read();
+			table.publish(raw::make_unique<TestObject>(13));
+			assert(reader->id == 12);
+		}
+		table.synchronize();
+		assert(table.retired_size() == 0);
+		verify_active_objects("synchronize", initial_active_objects + 1);
+
+		// Versions still retired when the pointer dies are freed with it
+		auto reader = table.read();
+		table.publish(raw::make_unique<TestObject>(14));
+		assert(table.retired_size() == 1);
+	}
+	verify_active_objects("deferred reclaim cleanup", initial_active_objects);
+}
+
+void test_rcu_nested_read_sections() {
+	std::cout << "\n--- Test: RCU Nested Read Sections ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::rcu_ptr<TestObject> first(raw::make_unique<TestObject>(20));
+		raw::rcu_ptr<TestObject> second(raw::make_unique<TestObject>(30));
+		{
+			auto outer = first.read();
+			{
+				auto inner = second.read();
+				assert(outer->id == 20 && inner->id == 30);
+			}
+			// Leaving the inner section must not end the outer one
+			first.publish(raw::make_unique<TestObject>(21));
+			assert(first.reclaim() == 0 && outer->id == 20);
+		}
+		assert(first.reclaim() == 1);
+	}
+	verify_active_objects("nested read sections cleanup", initial_active_objects);
+}
+
+void stress_test_rcu_ptr(int publishes, int reader_threads) {
+	std::cout << "\n--- Stress Test: RCU Ptr (" << publishes << " publishes, " << reader_threads
+			  << " readers) ---\n";
+	int initial_active_objects = s_active_concurrent_test_objects;
+
+	{
+		raw::rcu_ptr<ConcurrentTestObject> table(raw::make_unique<ConcurrentTestObject>(0));
+		std::atomic<bool>				   done {false};
+		std::atomic<long long>			   reads {0};
+
+		std::vector<std::thread> readers;
+		for (int t = 0; t < reader_threads; ++t) {
+			readers.emplace_back([&] {
+				int last_seen = 0;
+				while (!done.load(std::memory_order_acquire)) {
+					auto reader = table.read();
+					assert(reader && reader->id >= last_seen);
+					last_seen = reader->id;
+					reads.fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+		}
+
+		for (int i = 1; i <= publishes; ++i) {
+			table.publish(raw::make_unique<ConcurrentTestObject>(i));
+		}
+		done.store(true, std::memory_order_release);
+		for (std::thread& reader : readers) {
+			reader.join();
+		}
+		table.synchronize();
+		assert(table.retired_size() == 0 && table.read()->id == publishes);
+		verify_active_concurrent_objects("Stress test live versions", initial_active_objects + 1);
+	}
+	verify_active_concurrent_objects("Stress test cleanup", initial_active_objects);
+}
+
+void run_all_rcu_tests() {
+	std::cout << "\nStarting rcu_ptr tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_rcu_read_publish();
+	verify_active_objects("After test_rcu_read_publish", initial_active_objects);
+
+	test_rcu_deferred_reclaim();
+	verify_active_objects("After test_rcu_deferred_reclaim", initial_active_objects);
+
+	test_rcu_nested_read_sections();
+	verify_active_objects("After test_rcu_nested_read_sections", initial_active_objects);
+
+	stress_test_rcu_ptr(100000, 4);
+	verify_active_objects("After stress_test_rcu_ptr", initial_active_objects);
+
+	std::cout << "\nAll rcu_ptr tests PASSED!.\n";
+	verify_active_objects("Final check after all rcu_ptr unit tests", 0);
+}
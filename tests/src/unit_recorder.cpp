@@ -0,0 +1,157 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_recorder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#ifdef RAW_RECORD_OPS
+
+namespace {
+// Unique per call, so test binaries of several build configurations can run at once
+std::string recording_path() {
+	std::random_device random;
+	std::string		   name = "raw_unit_recorder_" + std::to_string(random()) + "_" +
+							  std::to_string(random()) + ".bin";
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<raw::recorded_event> read_recording(const std::string& path) {
+	std::ifstream		  in(path, std::ios::binary);
+	raw::recording_header header {};
+	in.read(reinterpret_cast<char*>(&header), sizeof(header));
+	assert(in && std::equal(std::begin(header.magic), std::end(header.magic),
+							std::begin(raw::recording_magic)));
+	assert(header.event_size == sizeof(raw::recorded_event));
+
+	std::vector<raw::recorded_event> events;
+	raw::recorded_event				 event {};
+	while (in.read(reinterpret_cast<char*>(&event), sizeof(event))) {
+		events.push_back(event);
+	}
+	return events;
+}
+
+size_t count_op(const std::vector<raw::recorded_event>& events, raw::recorded_op op) {
+	return std::count_if(events.begin(), events.end(), [op](const raw::recorded_event& event) {
+		return event.op == op;
+	});
+}
+} // namespace
+
+void test_recorder_captures_operations() {
+	std::cout << "\n--- Test: Recorder Captures Operations ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	const std::string path	  = recording_path();
+	bool			  started = raw::op_recorder::start(path.c_str());
+	assert(started && raw::op_recorder::active());
+	assert(!raw::op_recorder::start(path.c_str()));
+	{
+		raw::shared_ptr<TestObject>	owner	 = raw::make_shared<TestObject>(1);
+		raw::shared_ptr<TestObject>	copy	 = owner;
+		raw::weak_ptr<TestObject>	observer = owner;
+		{
+			raw::shared_ptr<TestObject> locked = observer.lock();
+			assert(locked);
+		}
+		copy.reset();
+		owner.reset();
+		assert(!observer.lock());
+		observer.reset();
+
+		raw::unique_ptr<TestObject> unique = raw::make_unique<TestObject>(2);
+		raw::unique_ptr<TestObject> moved  = std::move(unique);
+		moved.reset();
+	}
+	raw::op_recorder::stop();
+	assert(!raw::op_recorder::active());
+
+	std::vector<raw::recorded_event> events = read_recording(path);
+	std::remove(path.c_str());
+	assert(count_op(events, raw::recorded_op::shared_make) == 1);
+	assert(count_op(events, raw::recorded_op::shared_copy) == 1);
+	// The locked owner, copy.reset() and owner.reset()
+	assert(count_op(events, raw::recorded_op::shared_destroy) == 3);
+	assert(count_op(events, raw::recorded_op::weak_copy) == 1);
+	assert(count_op(events, raw::recorded_op::weak_lock) == 1);
+	assert(count_op(events, raw::recorded_op::weak_lock_failed) == 1);
+	assert(count_op(events, raw::recorded_op::weak_destroy) == 1);
+	assert(count_op(events, raw::recorded_op::unique_make) == 1);
+	assert(count_op(events, raw::recorded_op::unique_move) == 1);
+	assert(count_op(events, raw::recorded_op::unique_destroy) == 1);
+	assert(events.size() == 12 && raw::op_recorder::dropped_events() == 0);
+
+	// Every shared_ and weak_ event names the one hub
+	for (const raw::recorded_event& event : events) {
+		if (event.op < raw::recorded_op::unique_make) {
+			assert(event.id == events.front().id);
+		}
+	}
+	verify_active_objects("recorder operations", initial_active_objects);
+}
+
+void stress_test_recorder(int copies_per_thread, int threads) {
+	std::cout << "\n--- Stress Test: Recorder (" << threads << " threads, " << copies_per_thread
+			  << " copies each) ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	const std::string path = recording_path();
+	raw::op_recorder::start(path.c_str());
+	{
+		raw::shared_ptr<TestObject> shared = raw::make_shared<TestObject>(1);
+		std::vector<std::thread>	workers;
+		for (int t = 0; t < threads; ++t) {
+			workers.emplace_back([&shared, copies_per_thread] {
+				for (int i = 0; i < copies_per_thread; ++i) {
+					raw::shared_ptr<TestObject> copy = shared;
+					assert(copy->id == 1);
+				}
+			});
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+	raw::op_recorder::stop();
+
+	// Full rings drop events rather than block, but every event is either written or counted
+	std::vector<raw::recorded_event> events = read_recording(path);
+	std::remove(path.c_str());
+	size_t expected = 2 + 2 * static_cast<size_t>(threads) * copies_per_thread;
+	assert(events.size() + raw::op_recorder::dropped_events() == expected);
+	std::cout << "Written: " << events.size()
+			  << ", dropped: " << raw::op_recorder::dropped_events() << "\n";
+	verify_active_objects("recorder stress", initial_active_objects);
+}
+
+void run_all_recorder_tests() {
+	std::cout << "\nStarting op_recorder tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_recorder_captures_operations();
+	verify_active_objects("After test_recorder_captures_operations", initial_active_objects);
+
+	stress_test_recorder(100000, 4);
+	verify_active_objects("After stress_test_recorder", initial_active_objects);
+
+	std::cout << "\nAll op_recorder tests PASSED!.\n";
+	verify_active_objects("Final check after all op_recorder unit tests", 0);
+}
+
+#else
+
+void run_all_recorder_tests() {
+	std::cout << "\nop_recorder tests skipped, they need RAW_RECORD_OPS.\n";
+}
+
+#endif
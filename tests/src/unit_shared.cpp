@@ -429,6 +429,58 @@ void test_shared_from_unique() {
 	verify_active_objects("Shared from unique cleanup", initial_active_objects);
 }
 
+class SelfAwareObject : public TestObject, public raw::enable_shared_from_this<SelfAwareObject> {
+public:
+	using TestObject::TestObject;
+};
+
+void test_shared_from_this() {
+	std::cout << "\n--- Test: Shared from This ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		raw::shared_ptr<SelfAwareObject> owner = raw::make_shared<SelfAwareObject>(3000);
+		raw::shared_ptr<SelfAwareObject> self  = owner->shared_from_this();
+		assert(self.get() == owner.get() && owner.use_count() == 2);
+
+		raw::weak_ptr<SelfAwareObject> weak_self = owner->weak_from_this();
+		assert(!weak_self.expired() && weak_self.use_count() == 2);
+
+		self.reset();
+		owner.reset();
+		assert(weak_self.expired());
+		verify_active_objects("make_shared owner released", initial_active_objects);
+	}
+
+	{
+		raw::shared_ptr<SelfAwareObject> owner(new SelfAwareObject(3001));
+		assert(owner->shared_from_this()->id == 3001);
+		assert(owner.use_count() == 1);
+
+		raw::shared_ptr<SelfAwareObject> from_unique(raw::make_unique<SelfAwareObject>(3002));
+		assert(from_unique->shared_from_this().get() == from_unique.get());
+		verify_active_objects("shared_ptr(T*) and unique owners", initial_active_objects + 2);
+	}
+	verify_active_objects("shared_ptr(T*) owners released", initial_active_objects);
+
+	{
+		SelfAwareObject unowned(3003);
+		assert(unowned.weak_from_this().expired());
+		bool threw = false;
+		try {
+			(void)unowned.shared_from_this();
+		} catch (const std::bad_weak_ptr&) {
+			threw = true;
+		}
+		assert(threw);
+
+		raw::shared_ptr<SelfAwareObject> owner = raw::make_shared<SelfAwareObject>(unowned);
+		assert(owner->shared_from_this().get() == owner.get());
+		assert(unowned.weak_from_this().expired());
+	}
+	verify_active_objects("Shared from this cleanup", initial_active_objects);
+}
+
 void stress_test_shared_ptr(int iterations, int max_pointers_in_pool) {
 	std::cout << "\n--- Stress Test: Shared Ptr (" << iterations << " iterations) ---\n";
 	std::random_device				rd;
@@ -569,6 +621,9 @@ void run_all_shared_tests() {
 	test_shared_from_unique();
 	verify_active_objects("After test_shared_from_unique", initial_active_objects);
 
+	test_shared_from_this();
+	verify_active_objects("After test_shared_from_this", initial_active_objects);
+
 	stress_test_shared_ptr(100000, 100);
 	verify_active_objects("After stress_test_shared_ptr", initial_active_objects);
 
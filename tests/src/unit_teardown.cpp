@@ -0,0 +1,186 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_teardown.h"
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#ifdef RAW_ITERATIVE_TEARDOWN
+
+namespace {
+// Nodes are created and destroyed on one thread only
+int live_nodes = 0;
+
+struct UniqueNode {
+	raw::unique_ptr<UniqueNode> next;
+
+	UniqueNode() {
+		++live_nodes;
+	}
+	~UniqueNode() {
+		--live_nodes;
+	}
+};
+
+struct SharedNode {
+	raw::shared_ptr<SharedNode> next;
+
+	SharedNode() {
+		++live_nodes;
+	}
+	~SharedNode() {
+		--live_nodes;
+	}
+};
+
+struct IntrusiveNode : public raw::intrusive_ref_counter<IntrusiveNode> {
+	raw::intrusive_ptr<IntrusiveNode> next;
+
+	IntrusiveNode() {
+		++live_nodes;
+	}
+	~IntrusiveNode() {
+		--live_nodes;
+	}
+};
+
+struct TreeNode {
+	TestObject					payload;
+	raw::shared_ptr<TreeNode>	left;
+	raw::unique_ptr<TreeNode[]> children;
+
+	explicit TreeNode(int id) : payload(id) {}
+	TreeNode() = default;
+};
+
+template<typename Body>
+void* run_body(void* body) {
+	(*static_cast<Body*>(body))();
+	return nullptr;
+}
+
+// Runs body on a thread whose stack is stack_bytes large, where the platform lets us choose
+template<typename Body>
+void run_with_stack(size_t stack_bytes, Body body) {
+#if defined(__unix__) || defined(__APPLE__)
+	pthread_attr_t attributes;
+	pthread_attr_init(&attributes);
+	int set = pthread_attr_setstacksize(&attributes, stack_bytes);
+	assert(set == 0);
+	pthread_t thread;
+	int		  created = pthread_create(&thread, &attributes, &run_body<Body>, &body);
+	assert(created == 0);
+	pthread_join(thread, nullptr);
+	pthread_attr_destroy(&attributes);
+#else
+	(void)stack_bytes;
+	std::thread(body).join();
+#endif
+}
+
+// Each new node takes ownership of the chain built so far, the head is the last one created
+template<typename Ptr, typename MakeFunc>
+Ptr build_chain(int nodes, MakeFunc make) {
+	Ptr head;
+	for (int i = 0; i < nodes; ++i) {
+		Ptr node   = make();
+		node->next = std::move(head);
+		head	   = std::move(node);
+	}
+	return head;
+}
+} // namespace
+
+void test_teardown_unique_chain(int nodes, size_t stack_bytes) {
+	std::cout << "\n--- Test: Teardown of a " << nodes << " node unique_ptr Chain on a "
+			  << stack_bytes / 1024 << " KB Stack ---\n";
+
+	run_with_stack(stack_bytes, [nodes] {
+		auto head = build_chain<raw::unique_ptr<UniqueNode>>(
+			nodes, [] { return raw::make_unique<UniqueNode>(); });
+		assert(live_nodes == nodes);
+		head.reset();
+		assert(live_nodes == 0 && raw::teardown::pending_count() == 0);
+	});
+	assert(live_nodes == 0);
+}
+
+void test_teardown_shared_chain(int nodes, size_t stack_bytes) {
+	std::cout << "\n--- Test: Teardown of a " << nodes << " node shared_ptr Chain on a "
+			  << stack_bytes / 1024 << " KB Stack ---\n";
+
+	run_with_stack(stack_bytes, [nodes] {
+		auto head = build_chain<raw::shared_ptr<SharedNode>>(
+			nodes, [] { return raw::make_shared<SharedNode>(); });
+		raw::weak_ptr<SharedNode> observer = head;
+		assert(live_nodes == nodes);
+		head.reset();
+		assert(live_nodes == 0 && observer.expired());
+	});
+	assert(live_nodes == 0);
+}
+
+void test_teardown_intrusive_chain(int nodes, size_t stack_bytes) {
+	std::cout << "\n--- Test: Teardown of a " << nodes << " node intrusive_ptr Chain on a "
+			  << stack_bytes / 1024 << " KB Stack ---\n";
+
+	run_with_stack(stack_bytes, [nodes] {
+		auto head = build_chain<raw::intrusive_ptr<IntrusiveNode>>(
+			nodes, [] { return raw::make_intrusive<IntrusiveNode>(); });
+		assert(live_nodes == nodes);
+		head.reset();
+		assert(live_nodes == 0);
+	});
+	assert(live_nodes == 0);
+}
+
+void test_teardown_tree(int depth) {
+	std::cout << "\n--- Test: Teardown of Mixed Shared and Array Children (depth " << depth
+			  << ") ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	{
+		// Every level owns the next through both a shared_ptr and a unique_ptr array
+		raw::shared_ptr<TreeNode> root = raw::make_shared<TreeNode>(0);
+		TreeNode*				  tip  = root.get();
+		for (int level = 1; level < depth; ++level) {
+			tip->left	  = raw::make_shared<TreeNode>(level);
+			tip->children = raw::make_unique<TreeNode[]>(2);
+			tip			  = tip->left.get();
+		}
+		assert(s_active_test_objects == initial_active_objects + 3 * depth - 2);
+	}
+	assert(raw::teardown::pending_count() == 0);
+	verify_active_objects("teardown tree", initial_active_objects);
+}
+
+void run_all_teardown_tests() {
+	std::cout << "\nStarting iterative teardown tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_teardown_unique_chain();
+	test_teardown_shared_chain();
+	test_teardown_intrusive_chain();
+
+	test_teardown_tree();
+	verify_active_objects("After test_teardown_tree", initial_active_objects);
+
+	std::cout << "\nAll iterative teardown tests PASSED!.\n";
+	verify_active_objects("Final check after all iterative teardown unit tests", 0);
+}
+
+#else
+
+void run_all_teardown_tests() {
+	std::cout << "\niterative teardown tests skipped, they need RAW_ITERATIVE_TEARDOWN.\n";
+}
+
+#endif
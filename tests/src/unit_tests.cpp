@@ -0,0 +1,6 @@
+#include "../include/run_unit_tests.h"
+
+int main() {
+	run_all_unit_tests();
+	return 0;
+}
@@ -0,0 +1,117 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_tracer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#ifdef RAW_SMART_PTR_DEBUG
+
+namespace {
+// Keeps what it is handed, read it only once the session is stopped
+class capture_sink final : public raw::trace_sink {
+public:
+	std::vector<raw::trace_record> records;
+
+	void consume(const raw::trace_record* batch, size_t count) noexcept override {
+		records.insert(records.end(), batch, batch + count);
+	}
+
+	[[nodiscard]] size_t count(raw::trace_event event) const {
+		return std::count_if(records.begin(), records.end(),
+							 [event](const raw::trace_record& record) {
+								 return record.event == event;
+							 });
+	}
+};
+} // namespace
+
+void test_tracer_captures_lifecycle() {
+	std::cout << "\n--- Test: Tracer Captures Lifecycle Events ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	capture_sink sink;
+	bool		 started = raw::tracer::start(sink);
+	assert(started && raw::tracer::active());
+	assert(!raw::tracer::start(sink));
+	const void* object = nullptr;
+	{
+		raw::shared_ptr<TestObject> owner	 = raw::make_shared<TestObject>(1);
+		raw::shared_ptr<TestObject> copy	 = owner;
+		raw::weak_ptr<TestObject>	observer = owner;
+
+		object = owner.get();
+		copy.reset();
+		observer.reset();
+		owner.reset();
+
+		raw::unique_ptr<TestObject>	  unique = raw::make_unique<TestObject>(2);
+		raw::unique_ptr<TestObject[]> array	 = raw::make_unique<TestObject[]>(3);
+	}
+	raw::tracer::stop();
+	assert(!raw::tracer::active());
+
+	assert(sink.count(raw::trace_event::shared_release) == 2);
+	assert(sink.count(raw::trace_event::weak_release) == 1);
+	assert(sink.count(raw::trace_event::unique_delete) == 1);
+	assert(sink.count(raw::trace_event::unique_array_delete) == 1);
+	assert(sink.records.size() == 5 && raw::tracer::dropped_events() == 0);
+
+	// One thread, so the records come in the order they happened, counted before the release
+	const raw::trace_record& first = sink.records[0];
+	assert(first.event == raw::trace_event::shared_release && first.use_count == 2);
+	assert(first.object == reinterpret_cast<uintptr_t>(object));
+	assert(sink.records[1].event == raw::trace_event::weak_release &&
+		   sink.records[1].use_count == 1);
+	assert(sink.records[2].use_count == 1);
+	assert(std::is_sorted(sink.records.begin(), sink.records.end(),
+						  [](const raw::trace_record& a, const raw::trace_record& b) {
+							  return a.timestamp_ns < b.timestamp_ns;
+						  }));
+	verify_active_objects("tracer lifecycle", initial_active_objects);
+}
+
+void test_tracer_sampling(int events, uint32_t sample_every) {
+	std::cout << "\n--- Test: Tracer Sampling (every " << sample_every << " of " << events
+			  << " events) ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	capture_sink sink;
+	raw::tracer::start(sink, sample_every);
+	for (int i = 0; i < events; ++i) {
+		raw::unique_ptr<TestObject> unique = raw::make_unique<TestObject>(i);
+	}
+	raw::tracer::stop();
+
+	size_t expected = (events + sample_every - 1) / sample_every;
+	assert(sink.records.size() == expected && raw::tracer::dropped_events() == 0);
+	verify_active_objects("tracer sampling", initial_active_objects);
+}
+
+void run_all_tracer_tests() {
+	std::cout << "\nStarting tracer tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	// The default session would keep the tests from starting theirs
+	raw::tracer::stop();
+
+	test_tracer_captures_lifecycle();
+	verify_active_objects("After test_tracer_captures_lifecycle", initial_active_objects);
+
+	test_tracer_sampling();
+	verify_active_objects("After test_tracer_sampling", initial_active_objects);
+
+	std::cout << "\nAll tracer tests PASSED!.\n";
+	verify_active_objects("Final check after all tracer unit tests", 0);
+}
+
+#else
+
+void run_all_tracer_tests() {
+	std::cout << "\ntracer tests skipped, they need RAW_SMART_PTR_DEBUG.\n";
+}
+
+#endif
@@ -0,0 +1,127 @@
+//
+// Created by progamers on 10/19/26.
+//
+
+#include "../include/unit_type_stats.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+#ifdef RAW_TYPE_STATS
+
+namespace {
+struct StatsProbe {
+	TestObject payload;
+};
+
+// Touched by the threads test only, so its counts start at zero
+struct ThreadStatsProbe {
+	int value = 0;
+};
+
+uint64_t delta(const raw::type_stats_snapshot& after, const raw::type_stats_snapshot& before,
+			   raw::type_event event) {
+	return after[event] - before[event];
+}
+} // namespace
+
+void test_type_stats_counts() {
+	std::cout << "\n--- Test: Type Stats Counts Every Operation ---\n";
+	int initial_active_objects = s_active_test_objects;
+
+	const raw::type_stats_snapshot before		= raw::type_stats<StatsProbe>::snapshot();
+	const raw::type_stats_snapshot array_before = raw::type_stats<StatsProbe[]>::snapshot();
+	{
+		raw::shared_ptr<StatsProbe> first = raw::make_shared<StatsProbe>();
+		raw::shared_ptr<StatsProbe> copy  = first;
+		raw::shared_ptr<StatsProbe> moved = std::move(copy);
+		raw::shared_ptr<StatsProbe> owned(new StatsProbe());
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		first.reset();
+		// Still owned by moved
+		raw::type_stats_snapshot midway = raw::type_stats<StatsProbe>::snapshot();
+		assert(delta(midway, before, raw::type_event::destroyed) == 0);
+
+		raw::unique_ptr<StatsProbe> unique = raw::make_unique<StatsProbe>();
+		raw::unique_ptr<StatsProbe> taken  = std::move(unique);
+		taken.reset(new StatsProbe());
+
+		raw::shared_ptr<StatsProbe[]> array = raw::make_shared<StatsProbe[]>(3);
+	}
+
+	const raw::type_stats_snapshot after = raw::type_stats<StatsProbe>::snapshot();
+	assert(delta(after, before, raw::type_event::shared_created) == 2);
+	assert(delta(after, before, raw::type_event::unique_created) == 2);
+	assert(delta(after, before, raw::type_event::copied) == 1);
+	assert(delta(after, before, raw::type_event::moved) == 2);
+	assert(delta(after, before, raw::type_event::destroyed) == 4);
+	// Only the two shared objects had a hub to time them, both lived at least a millisecond
+	assert(after.timed_destroys - before.timed_destroys == 2);
+	assert(after.total_lifetime_ns - before.total_lifetime_ns >= 2'000'000);
+	assert(after.type_name.find("StatsProbe") != std::string::npos);
+
+	// Arrays are counted as their own type
+	const raw::type_stats_snapshot array_after = raw::type_stats<StatsProbe[]>::snapshot();
+	assert(delta(array_after, array_before, raw::type_event::shared_created) == 1);
+	assert(delta(array_after, array_before, raw::type_event::destroyed) == 1);
+
+	bool listed = false;
+	for (const raw::type_stats_snapshot& stats : raw::collect_type_stats()) {
+		listed |= stats.type_name == after.type_name;
+	}
+	assert(listed);
+	raw::dump_type_stats(stdout);
+	verify_active_objects("type stats counts", initial_active_objects);
+}
+
+void test_type_stats_threads(int objects_per_thread, int threads) {
+	std::cout << "\n--- Test: Type Stats Across Threads (" << threads << " threads, "
+			  << objects_per_thread << " objects each) ---\n";
+
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([objects_per_thread] {
+			for (int i = 0; i < objects_per_thread; ++i) {
+				raw::shared_ptr<ThreadStatsProbe> object = raw::make_shared<ThreadStatsProbe>();
+				raw::shared_ptr<ThreadStatsProbe> copy	 = object;
+				assert(copy->value == 0);
+			}
+		});
+	}
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	// The threads exited, their records still count
+	const raw::type_stats_snapshot stats = raw::type_stats<ThreadStatsProbe>::snapshot();
+	uint64_t					   total = static_cast<uint64_t>(threads) * objects_per_thread;
+	assert(stats[raw::type_event::shared_created] == total);
+	assert(stats[raw::type_event::copied] == total);
+	assert(stats[raw::type_event::destroyed] == total);
+	assert(stats.timed_destroys == total);
+}
+
+void run_all_type_stats_tests() {
+	std::cout << "\nStarting type stats tests...\n";
+	int initial_active_objects = s_active_test_objects;
+
+	test_type_stats_counts();
+	verify_active_objects("After test_type_stats_counts", initial_active_objects);
+
+	test_type_stats_threads();
+	verify_active_objects("After test_type_stats_threads", initial_active_objects);
+
+	std::cout << "\nAll type stats tests PASSED!.\n";
+	verify_active_objects("Final check after all type stats unit tests", 0);
+}
+
+#else
+
+void run_all_type_stats_tests() {
+	std::cout << "\ntype stats tests skipped, they need RAW_TYPE_STATS.\n";
+}
+
+#endif